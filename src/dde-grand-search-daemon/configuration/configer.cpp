@@ -86,7 +86,10 @@ UserPreferencePointer ConfigerPrivate::webSearchEngine()
 
 UserPreferencePointer ConfigerPrivate::semanticEngine()
 {
-    QVariantHash data { { GRANDSEARCH_SEMANTIC_ENABLED, true } };
+    QVariantHash data {
+        { GRANDSEARCH_SEMANTIC_ENABLED, true },
+        { GRANDSEARCH_SEMANTIC_TIMEBUDGET, GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT }
+    };
 
     return UserPreferencePointer(new UserPreference(data));
 }
@@ -175,7 +178,10 @@ bool ConfigerPrivate::updateConfig1(QSettings *set)
     if (UserPreferencePointer conf = m_root->group(GRANDSEARCH_SEMANTIC_GROUP)) {
         bool ret = set->value(GRANDSEARCH_SEMANTIC_ENABLED, true).toBool();
         conf->setValue(GRANDSEARCH_SEMANTIC_ENABLED, ret);
-        qCDebug(logDaemon) << "Semantic search configuration updated - Enabled:" << ret;
+
+        int budget = set->value(GRANDSEARCH_SEMANTIC_TIMEBUDGET, GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT).toInt();
+        conf->setValue(GRANDSEARCH_SEMANTIC_TIMEBUDGET, budget > 0 ? budget : GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT);
+        qCDebug(logDaemon) << "Semantic search configuration updated - Enabled:" << ret << "Time budget:" << budget;
     } else {
         qCWarning(logDaemon) << "Configuration not found:" << GRANDSEARCH_SEMANTIC_GROUP;
     }
@@ -0,0 +1,199 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searchstatemonitor.h"
+
+#include <dfm-search/dsearch_global.h>
+
+#include <DConfig>
+
+#include <QTimer>
+#include <QFuture>
+#include <QtConcurrent>
+#include <QLoggingCategory>
+
+#include <atomic>
+
+Q_DECLARE_LOGGING_CATEGORY(logDaemon)
+
+DCORE_USE_NAMESPACE
+
+using namespace GrandSearch;
+
+static constexpr char kCfgAppId[] = "org.deepin.dde.file-manager";
+static constexpr char kSearchCfgPath[] = "org.deepin.dde.file-manager.search";
+static constexpr char kEnableFileIndexSearch[] = "enableFileIndexSearch";
+static constexpr char kEnableFullTextSearch[] = "enableFullTextSearch";
+static constexpr char kEnableOcrTextSearch[] = "enableOcrTextSearch";
+
+// 索引状态轮询间隔
+static constexpr int kIndexPollInterval = 30 * 1000;
+
+namespace GrandSearch {
+
+class SearchStateMonitorPrivate
+{
+public:
+    explicit SearchStateMonitorPrivate(SearchStateMonitor *parent)
+        : q(parent) {}
+    void loadConfig();
+    void pollIndexState();
+public:
+    SearchStateMonitor *q;
+    DConfig *m_dconfig = nullptr;
+    QTimer m_pollTimer;
+    QFuture<void> m_polling;
+
+    // 配置在主线程更新，索引状态在线程池中更新，读取可能来自任意线程
+    std::atomic_bool m_fileIndexEnabled { false };
+    std::atomic_bool m_fullTextEnabled { false };
+    std::atomic_bool m_ocrTextEnabled { false };
+    std::atomic_bool m_fileNameIndexReady { false };
+    std::atomic_bool m_contentIndexAvailable { false };
+    std::atomic_bool m_ocrTextIndexAvailable { false };
+};
+
+}
+
+void SearchStateMonitorPrivate::loadConfig()
+{
+    if (!m_dconfig)
+        return;
+
+    m_fileIndexEnabled = m_dconfig->value(kEnableFileIndexSearch, false).toBool();
+    m_fullTextEnabled = m_dconfig->value(kEnableFullTextSearch, false).toBool();
+    m_ocrTextEnabled = m_dconfig->value(kEnableOcrTextSearch, false).toBool();
+
+    qCDebug(logDaemon) << "Search DConfig loaded - FileIndex:" << m_fileIndexEnabled
+                       << "FullText:" << m_fullTextEnabled << "OcrText:" << m_ocrTextEnabled;
+}
+
+void SearchStateMonitorPrivate::pollIndexState()
+{
+    bool changed = false;
+    auto update = [&changed](std::atomic_bool &state, bool value) {
+        if (state.exchange(value) != value)
+            changed = true;
+    };
+
+    update(m_fileNameIndexReady, DFMSEARCH::Global::isFileNameIndexReadyForSearch());
+    update(m_contentIndexAvailable, DFMSEARCH::Global::isContentIndexAvailable());
+    update(m_ocrTextIndexAvailable, DFMSEARCH::Global::isOcrTextIndexAvailable());
+
+    if (changed) {
+        qCInfo(logDaemon) << "Index state changed - FileName ready:" << m_fileNameIndexReady
+                          << "Content available:" << m_contentIndexAvailable
+                          << "OcrText available:" << m_ocrTextIndexAvailable;
+        QMetaObject::invokeMethod(q, "stateChanged", Qt::QueuedConnection);
+    }
+}
+
+class SearchStateMonitorGlobal : public SearchStateMonitor
+{
+};
+Q_GLOBAL_STATIC(SearchStateMonitorGlobal, searchStateMonitorGlobal)
+
+SearchStateMonitor::SearchStateMonitor(QObject *parent)
+    : QObject(parent),
+      d(new SearchStateMonitorPrivate(this))
+{
+    d->m_pollTimer.setInterval(kIndexPollInterval);
+    connect(&d->m_pollTimer, &QTimer::timeout, this, &SearchStateMonitor::onPollIndexState);
+}
+
+SearchStateMonitor::~SearchStateMonitor()
+{
+    d->m_pollTimer.stop();
+    d->m_polling.waitForFinished();
+
+    delete d->m_dconfig;
+    d->m_dconfig = nullptr;
+
+    delete d;
+    d = nullptr;
+}
+
+SearchStateMonitor *SearchStateMonitor::instance()
+{
+    return searchStateMonitorGlobal;
+}
+
+bool SearchStateMonitor::init()
+{
+    if (d->m_dconfig) {
+        qCDebug(logDaemon) << "SearchStateMonitor already initialized";
+        return true;
+    }
+
+    d->m_dconfig = DConfig::create(kCfgAppId, kSearchCfgPath);
+    if (!d->m_dconfig) {
+        qCWarning(logDaemon) << "Failed to create DConfig for file manager search";
+        return false;
+    }
+
+    d->loadConfig();
+    connect(d->m_dconfig, &DConfig::valueChanged, this, &SearchStateMonitor::onConfigChanged);
+
+    // 首次在启动时同步获取，保证第一次搜索可用；后续在后台轮询
+    d->pollIndexState();
+    d->m_pollTimer.start();
+
+    qCInfo(logDaemon) << "SearchStateMonitor initialized";
+    return true;
+}
+
+bool SearchStateMonitor::isFileIndexSearchEnabled() const
+{
+    return d->m_fileIndexEnabled;
+}
+
+bool SearchStateMonitor::isFullTextSearchEnabled() const
+{
+    return d->m_fullTextEnabled;
+}
+
+bool SearchStateMonitor::isOcrTextSearchEnabled() const
+{
+    return d->m_ocrTextEnabled;
+}
+
+bool SearchStateMonitor::isFileNameIndexReady() const
+{
+    return d->m_fileNameIndexReady;
+}
+
+bool SearchStateMonitor::isContentIndexAvailable() const
+{
+    return d->m_contentIndexAvailable;
+}
+
+bool SearchStateMonitor::isOcrTextIndexAvailable() const
+{
+    return d->m_ocrTextIndexAvailable;
+}
+
+void SearchStateMonitor::onConfigChanged(const QString &key)
+{
+    if (key != kEnableFileIndexSearch && key != kEnableFullTextSearch && key != kEnableOcrTextSearch)
+        return;
+
+    qCInfo(logDaemon) << "Search DConfig changed:" << key;
+    d->loadConfig();
+
+    // 开关打开后索引可能刚刚可用，立即刷新一次
+    onPollIndexState();
+    emit stateChanged();
+}
+
+void SearchStateMonitor::onPollIndexState()
+{
+    if (d->m_polling.isRunning()) {
+        qCDebug(logDaemon) << "Index state polling is still running, skip";
+        return;
+    }
+
+    d->m_polling = QtConcurrent::run([this]() {
+        d->pollIndexState();
+    });
+}
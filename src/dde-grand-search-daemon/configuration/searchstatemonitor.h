@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHSTATEMONITOR_H
+#define SEARCHSTATEMONITOR_H
+
+#include <QObject>
+
+#define SearchStateIns GrandSearch::SearchStateMonitor::instance()
+
+namespace GrandSearch {
+
+class SearchStateMonitorPrivate;
+// 缓存文管搜索DConfig开关与索引就绪状态，避免在每次搜索时创建DConfig
+class SearchStateMonitor : public QObject
+{
+    Q_OBJECT
+    friend class SearchStateMonitorPrivate;
+public:
+    static SearchStateMonitor *instance();
+    bool init();
+
+    bool isFileIndexSearchEnabled() const;
+    bool isFullTextSearchEnabled() const;
+    bool isOcrTextSearchEnabled() const;
+
+    bool isFileNameIndexReady() const;
+    bool isContentIndexAvailable() const;
+    bool isOcrTextIndexAvailable() const;
+signals:
+    void stateChanged();
+protected slots:
+    void onConfigChanged(const QString &key);
+    void onPollIndexState();
+protected:
+    explicit SearchStateMonitor(QObject *parent = nullptr);
+    ~SearchStateMonitor();
+private:
+    SearchStateMonitorPrivate *d;
+};
+
+}
+
+#endif   // SEARCHSTATEMONITOR_H
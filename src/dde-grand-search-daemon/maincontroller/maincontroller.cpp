@@ -5,6 +5,7 @@
 #include "maincontroller.h"
 #include "maincontroller_p.h"
 #include "configuration/configer.h"
+#include "configuration/searchstatemonitor.h"
 #include "global/searchhelper.h"
 
 #include <QDebug>
@@ -221,6 +222,10 @@ bool MainController::init()
         return false;
     }
 
+    // 缓存文管搜索配置与索引状态，避免在搜索时创建DConfig
+    if (!SearchStateIns->init())
+        qCWarning(logDaemon) << "Failed to initialize search state monitor";
+
     // 初始化配置模块
     return ConfigerIns->init();
 }
@@ -235,8 +235,14 @@ QVariantHash FileSearchUtils::extraData(const QFileInfo &info, const QStringList
     QStringList datas;
     auto config = Configer::instance()->group(GRANDSEARCH_TAILER_GROUP);
 
+    // 文件时间，界面计算权重时使用，避免在界面线程中访问文件系统
+    const CommonTools::FileTimes times = CommonTools::getFileTimes(info.absoluteFilePath());
+    hash.insert(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES, QVariantList { times.birth, times.modified, times.accessed });
+
     // 修改时间
-    auto timeModified = CommonTools::getFileModifiedTime(info.absoluteFilePath()).toString("yyyy-MM-dd hh:mm");
+    QString timeModified;
+    if (times.modified > 0)
+        timeModified = QDateTime::fromSecsSinceEpoch(times.modified).toString("yyyy-MM-dd hh:mm");
     hash.insert(GRANDSEARCH_PROPERTY_ITEM_MODIFIED_TIME, timeModified);
     qCDebug(logDaemon) << "Added modification time:" << timeModified;
 
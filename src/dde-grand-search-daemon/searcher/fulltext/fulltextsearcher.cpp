@@ -6,17 +6,12 @@
 #include "fulltextworker.h"
 #include "global/builtinsearch.h"
 #include "configuration/configer.h"
-
-#include <dfm-search/dsearch_global.h>
-
-#include <DConfig>
+#include "configuration/searchstatemonitor.h"
 
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logDaemon)
 
-DCORE_USE_NAMESPACE
-
 using namespace GrandSearch;
 
 FullTextSearcher::FullTextSearcher(QObject *parent)
@@ -34,20 +29,12 @@ bool FullTextSearcher::isActive() const
 {
     // Combination search is not supported for full-text search
     // (check from context - if typeKeywords exist, it's combination)
-    DConfig *dcfg = DConfig::create("org.deepin.dde.file-manager",
-                                    "org.deepin.dde.file-manager.search");
-    if (!dcfg)
-        return false;
-
-    bool enabled = dcfg->value("enableFullTextSearch", false).toBool();
-    delete dcfg;
-
-    if (!enabled) {
+    if (!SearchStateIns->isFullTextSearchEnabled()) {
         qCDebug(logDaemon) << "FullTextSearcher inactive: full-text search disabled by DConfig";
         return false;
     }
 
-    if (!DFMSEARCH::Global::isContentIndexAvailable()) {
+    if (!SearchStateIns->isContentIndexAvailable()) {
         qCDebug(logDaemon) << "FullTextSearcher inactive: content index not available";
         return false;
     }
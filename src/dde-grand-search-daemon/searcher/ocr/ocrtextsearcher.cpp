@@ -5,17 +5,12 @@
 #include "ocrtextsearcher.h"
 #include "ocrtextworker.h"
 #include "global/builtinsearch.h"
-
-#include <dfm-search/dsearch_global.h>
-
-#include <DConfig>
+#include "configuration/searchstatemonitor.h"
 
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logDaemon)
 
-DCORE_USE_NAMESPACE
-
 using namespace GrandSearch;
 
 OcrTextSearcher::OcrTextSearcher(QObject *parent)
@@ -31,13 +26,8 @@ QString OcrTextSearcher::name() const
 
 bool OcrTextSearcher::isActive() const
 {
-    // Check if OCR search is enabled via DConfig
-    DConfig *dcfg = DConfig::create("org.deepin.dde.file-manager", "org.deepin.dde.file-manager.search");
-    if (!dcfg)
-        return false;
-
-    bool enabled = dcfg->value("enableOcrTextSearch").toBool() && DFMSEARCH::Global::isOcrTextIndexAvailable();
-    delete dcfg;
+    // Check if OCR search is enabled via the cached DConfig state
+    bool enabled = SearchStateIns->isOcrTextSearchEnabled() && SearchStateIns->isOcrTextIndexAvailable();
 
     qCDebug(logDaemon) << "OcrTextSearcher activity check - OCR enabled:" << enabled;
     return enabled;
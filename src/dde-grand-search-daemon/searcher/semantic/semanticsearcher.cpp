@@ -6,18 +6,12 @@
 #include "semanticworker.h"
 #include "global/builtinsearch.h"
 #include "configuration/configer.h"
-
-#include <dfm-search/dsearch_global.h>
-
-#include <DConfig>
+#include "configuration/searchstatemonitor.h"
 
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logDaemon)
 
-DFM_SEARCH_USE_NS
-DCORE_USE_NAMESPACE
-
 using namespace GrandSearch;
 
 SemanticSearcher::SemanticSearcher(QObject *parent)
@@ -33,14 +27,7 @@ QString SemanticSearcher::name() const
 
 bool SemanticSearcher::isActive() const
 {
-    DConfig *dcfg = DConfig::create("org.deepin.dde.file-manager", "org.deepin.dde.file-manager.search");
-    if (!dcfg) {
-        qCDebug(logDaemon) << "SemanticSearcher inactive: failed to create DConfig";
-        return false;
-    }
-
-    bool enabled = dcfg->value("enableFileIndexSearch").toBool() && DFMSEARCH::Global::isFileNameIndexReadyForSearch();
-    delete dcfg;
+    bool enabled = SearchStateIns->isFileIndexSearchEnabled() && SearchStateIns->isFileNameIndexReady();
     if (!enabled) {
         qCDebug(logDaemon) << "SemanticSearcher inactive: file index search not enabled or index not ready";
         return false;
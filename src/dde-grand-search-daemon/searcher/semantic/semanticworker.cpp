@@ -7,6 +7,8 @@
 #include "configuration/configer.h"
 
 #include <QDebug>
+#include <QDir>
+#include <QtConcurrent>
 #include <QFileInfo>
 #include <QLoggingCategory>
 
@@ -15,13 +17,23 @@ Q_DECLARE_LOGGING_CATEGORY(logDaemon)
 DFM_SEARCH_USE_NS
 
 #define MAX_SEARCH_NUM_GROUP 100
+#define MAX_CANDIDATE_NUM 20
 #define EMIT_INTERVAL 50
+#define CANDIDATE_WEIGHT 3
+#define REFINED_WEIGHT 5
 
 using namespace GrandSearch;
 
 SemanticWorkerPrivate::SemanticWorkerPrivate(SemanticWorker *qq)
     : q_ptr(qq)
 {
+    auto blacklistConfig = ConfigerIns->group(GRANDSEARCH_BLACKLIST_GROUP);
+    m_blacklist = blacklistConfig->value(GRANDSEARCH_BLACKLIST_PATH, QStringList());
+
+    auto semanticConfig = ConfigerIns->group(GRANDSEARCH_SEMANTIC_GROUP);
+    m_timeBudget = semanticConfig->value(GRANDSEARCH_SEMANTIC_TIMEBUDGET, GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT);
+    if (m_timeBudget <= 0)
+        m_timeBudget = GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT;
 }
 
 SemanticWorkerPrivate::~SemanticWorkerPrivate()
@@ -30,15 +42,13 @@ SemanticWorkerPrivate::~SemanticWorkerPrivate()
 
 bool SemanticWorkerPrivate::doSearch()
 {
-    Q_Q(SemanticWorker);
-
     qCDebug(logDaemon) << "Starting semantic search - Context:" << m_context;
 
     SemanticSearcher dfmSearcher;
 
-    // 设置搜索参数
+    // 设置搜索参数，超时受总耗时预算约束，避免长期占用线程池
     dfmSearcher.setMaxResults(MAX_SEARCH_NUM_GROUP);
-    dfmSearcher.setSearchTimeout(60);
+    dfmSearcher.setSearchTimeout(qMax(1, (m_timeBudget + 999) / 1000));
 
     // 先判断是否为语义查询，如果不是则跳过
     if (!dfmSearcher.isSemanticQuery(m_context)) {
@@ -47,61 +57,137 @@ bool SemanticWorkerPrivate::doSearch()
     }
 
     // 排除黑名单路径，避免搜索出黑名单目录下的文件
-    auto blacklistConfig = Configer::instance()->group(GRANDSEARCH_BLACKLIST_GROUP);
-    auto blacklist = blacklistConfig->value(GRANDSEARCH_BLACKLIST_PATH, QStringList());
-    dfmSearcher.setSearchExcludedPaths(blacklist);
+    dfmSearcher.setSearchExcludedPaths(m_blacklist);
 
     // 通过 intentParsed 信号提取关键词
     // searchSync 内部会发出 intentParsed 信号，但使用 searchSync 时
-    // 信号是在同一个线程中同步发出的，需要提前连接
+    // 信号是在同一个线程中同步发出的，需要提前连接。
+    // 意图解析完成后用关键词在文件名索引中检索候选集并推送，
+    // 候选结果携带关键词，界面可以先行高亮，无需等待语义检索完成。
+    // 候选检索在独立任务中进行，不阻塞仍在进行的语义检索，也不占用其超时时间
     QObject::connect(&dfmSearcher, &SemanticSearcher::intentParsed,
                      [this](const ParsedIntent &intent) {
+                         // 候选任务读取关键词，运行期间不再更新
+                         if (m_candidateFuture.isRunning())
+                             return;
                          m_keywords = intent.keywords();
+                         m_extensions = intent.fileExtensions();
                          qCDebug(logDaemon) << "Semantic intent parsed - Keywords:" << m_keywords
-                                            << "Extensions:" << intent.fileExtensions();
+                                            << "Extensions:" << m_extensions
+                                            << "Time elapsed:" << m_time.elapsed() << "ms";
+                         m_candidateFuture = QtConcurrent::run([this]() {
+                             if (searchCandidates())
+                                 flush();
+                         });
                      });
 
     // 执行同步搜索
     const SearchResultExpected result = dfmSearcher.searchSync(m_context);
 
+    // 候选结果先于精排结果推送，精排结果才能以更高权重覆盖
+    m_candidateFuture.waitForFinished();
+
+    if (m_status.loadAcquire() != ProxyWorker::Runing) {
+        qCDebug(logDaemon) << "Semantic search terminated, discarding refined results";
+        return false;
+    }
+
     if (!result.hasValue()) {
         qCWarning(logDaemon) << "Semantic search failed - Error:" << result.error().message();
         return false;
     }
 
-    processResults(result.value());
+    processResults(result.value(), GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE_REFINED);
 
-    qCInfo(logDaemon) << "Semantic search completed - Total results:" << m_tmpSearchResults.size()
+    qCInfo(logDaemon) << "Semantic search completed - Candidates:" << m_candidateResults.size()
+                      << "Refined:" << m_tmpSearchResults.size()
                       << "Time elapsed:" << m_time.elapsed() << "ms";
 
     return true;
 }
 
-void SemanticWorkerPrivate::processResults(const SearchResultList &results)
+bool SemanticWorkerPrivate::searchCandidates()
+{
+    if (m_status.loadAcquire() != ProxyWorker::Runing || m_keywords.isEmpty())
+        return false;
+
+    if (isOverBudget()) {
+        qCDebug(logDaemon) << "Semantic time budget exhausted, skipping candidate stage";
+        return false;
+    }
+
+    if (!DFMSEARCH::Global::isFileNameIndexDirectoryAvailable()) {
+        qCDebug(logDaemon) << "File name index is not available, skipping candidate stage";
+        return false;
+    }
+
+    QObject holder;
+    SearchEngine *engine = SearchFactory::createEngine(SearchType::FileName, &holder);
+    if (!engine) {
+        qCWarning(logDaemon) << "Failed to create file name search engine for semantic candidates";
+        return false;
+    }
+
+    SearchOptions options;
+    options.setSearchPath(QDir::homePath());
+    options.setSearchExcludedPaths(m_blacklist);
+    options.setSearchMethod(SearchMethod::Indexed);
+    options.setMaxResults(MAX_CANDIDATE_NUM);
+
+    FileNameOptionsAPI fileNameOptions(options);
+    fileNameOptions.setPinyinEnabled(true);
+    if (!m_extensions.isEmpty())
+        fileNameOptions.setFileExtensions(m_extensions);
+
+    engine->setSearchOptions(options);
+
+    SearchQuery query;
+    if (m_keywords.size() > 1) {
+        query = SearchFactory::createQuery(m_keywords, SearchQuery::Type::Boolean);
+        query.setBooleanOperator(SearchQuery::BooleanOperator::AND);
+    } else {
+        query = SearchFactory::createQuery(m_keywords.first(), SearchQuery::Type::Simple);
+    }
+
+    const SearchResultExpected &result = engine->searchSync(query);
+    if (!result.hasValue()) {
+        qCWarning(logDaemon) << "Semantic candidate search failed - Error:" << result.error().message();
+        return false;
+    }
+
+    processResults(result.value(), GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE_CANDIDATE);
+    qCDebug(logDaemon) << "Semantic candidate stage finished - Count:" << m_candidateResults.size()
+                       << "Time elapsed:" << m_time.elapsed() << "ms";
+    return true;
+}
+
+void SemanticWorkerPrivate::processResults(const SearchResultList &results, const QString &stage)
 {
     Q_Q(SemanticWorker);
 
-    qCDebug(logDaemon) << "Processing semantic search results - Count:" << results.size();
+    qCDebug(logDaemon) << "Processing semantic search results - Stage:" << stage << "Count:" << results.size();
+
+    const bool refined = stage == GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE_REFINED;
+    QSet<QString> &seen = refined ? m_tmpSearchResults : m_candidateResults;
 
-    int count = 0;
     for (const auto &r : results) {
         if (m_status.loadAcquire() != ProxyWorker::Runing)
             return;
 
         const QString &filePath = r.path();
 
-        // 去重
-        if (m_tmpSearchResults.contains(filePath)) {
+        // 同阶段内去重；精排结果以更高权重覆盖界面上已有的候选结果
+        if (seen.contains(filePath))
             continue;
-        }
-        m_tmpSearchResults << filePath;
+        seen << filePath;
 
         // 使用 FileSearchUtils 打包结果
         MatchedItem item = FileSearchUtils::packItem(filePath, q->name(), m_keywords);
 
-        // 设置权重
+        // 设置权重与阶段
         QVariantHash extra = item.extra.toHash();
-        extra.insert(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 5);
+        extra.insert(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, refined ? REFINED_WEIGHT : CANDIDATE_WEIGHT);
+        extra.insert(GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE, stage);
         item.extra = extra;
 
         {
@@ -109,7 +195,6 @@ void SemanticWorkerPrivate::processResults(const SearchResultList &results)
             m_items.append(item);
         }
 
-        count++;
         tryNotify();
     }
 }
@@ -124,6 +209,20 @@ void SemanticWorkerPrivate::tryNotify()
     }
 }
 
+void SemanticWorkerPrivate::flush()
+{
+    Q_Q(SemanticWorker);
+    if (m_status.loadAcquire() == ProxyWorker::Runing && q->hasItem()) {
+        m_lastEmit = m_time.elapsed();
+        emit q->unearthed(q);
+    }
+}
+
+bool SemanticWorkerPrivate::isOverBudget() const
+{
+    return m_time.elapsed() >= m_timeBudget;
+}
+
 int SemanticWorkerPrivate::itemCount() const
 {
     QMutexLocker lk(&m_mutex);
@@ -10,10 +10,14 @@
 
 #include <dfm-search/semanticsearcher.h>
 #include <dfm-search/semantic_types.h>
+#include <dfm-search/searchfactory.h>
+#include <dfm-search/filenamesearchapi.h>
+#include <dfm-search/dsearch_global.h>
 
 #include <QMutex>
 #include <QAtomicInt>
 #include <QElapsedTimer>
+#include <QFuture>
 #include <QSet>
 
 namespace GrandSearch {
@@ -25,19 +29,27 @@ public:
     ~SemanticWorkerPrivate();
 
     bool doSearch();
-    void processResults(const DFMSEARCH::SearchResultList &results);
+    bool searchCandidates();
+    void processResults(const DFMSEARCH::SearchResultList &results, const QString &stage);
     void tryNotify();
+    void flush();
     int itemCount() const;
+    bool isOverBudget() const;
 
 public:
     SemanticWorker *q_ptr = nullptr;
     QAtomicInt m_status = ProxyWorker::Ready;
     QString m_context;                      // 搜索上下文（自然语言查询）
     QStringList m_keywords;                 // 从 intentParsed 提取的关键词
+    QStringList m_extensions;               // 从 intentParsed 提取的文件后缀
+    QStringList m_blacklist;
+    int m_timeBudget = 0;                   // 总耗时预算，单位毫秒
 
     mutable QMutex m_mutex;
     MatchedItems m_items;
-    QSet<QString> m_tmpSearchResults;       // 用于去重
+    QSet<QString> m_candidateResults;       // 候选阶段去重
+    QSet<QString> m_tmpSearchResults;       // 精排阶段去重
+    QFuture<void> m_candidateFuture;        // 候选阶段检索任务
 
     QElapsedTimer m_time;
     int m_lastEmit = 0;
@@ -53,12 +53,20 @@
 // 修改时间（独立于拖尾，不限制绘制宽度）
 #define GRANDSEARCH_PROPERTY_ITEM_MODIFIED_TIME    "itemModifiedTime"
 
+// 文件的创建、修改、访问时间，QVariantList，单位秒，用于计算权重
+#define GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES    "itemFileTimes"
+
 // 匹配的到具体信息
 #define GRANDSEARCH_PROPERTY_ITEM_MATCHEDCONTEXT    "itemMatchedContext"
 
 // 匹配的关键词列表
 #define GRANDSEARCH_PROPERTY_ITEM_KEYWORDS          "itemKeywords"
 
+// 语义搜索结果所处阶段：关键词候选集或语义精排结果
+#define GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE            "itemSemanticStage"
+#define GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE_CANDIDATE  "candidate"
+#define GRANDSEARCH_PROPERTY_ITEM_SEMANTIC_STAGE_REFINED    "refined"
+
 /****************** 扩展数据 END ******************************/
 
 #define DEF_BUILTISEARCH_NAMES  \
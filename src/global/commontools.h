@@ -121,6 +121,43 @@ inline QDateTime getFileAccessTime(const QString &filePath)
     return {};
 }
 
+// 文件的创建、修改、访问时间（秒），无法获取时为0
+struct FileTimes
+{
+    qint64 birth = 0;
+    qint64 modified = 0;
+    qint64 accessed = 0;
+};
+
+// 通过一次statx获取文件的三个时间，文件系统不支持创建时间时使用状态改变时间代替
+inline FileTimes getFileTimes(const QString &filePath)
+{
+    FileTimes times;
+    QByteArray path = filePath.toLocal8Bit();
+    struct statx stx;
+    const unsigned int mask = STATX_BTIME | STATX_MTIME | STATX_ATIME | STATX_CTIME;
+    if (syscall(SYS_statx, AT_FDCWD, path.constData(), 0, mask, &stx) != 0) {
+        auto secs = [](const QDateTime &time) {
+            return time.isValid() ? time.toSecsSinceEpoch() : 0;
+        };
+        times.birth = secs(QFileInfo(filePath).birthTime());
+        times.modified = secs(getFileModifiedTime(filePath));
+        times.accessed = secs(getFileAccessTime(filePath));
+        return times;
+    }
+
+    if (stx.stx_mask & STATX_BTIME)
+        times.birth = static_cast<qint64>(stx.stx_btime.tv_sec);
+    else if (stx.stx_mask & STATX_CTIME)
+        times.birth = static_cast<qint64>(stx.stx_ctime.tv_sec);
+    if (stx.stx_mask & STATX_MTIME)
+        times.modified = static_cast<qint64>(stx.stx_mtime.tv_sec);
+    if (stx.stx_mask & STATX_ATIME)
+        times.accessed = static_cast<qint64>(stx.stx_atime.tv_sec);
+
+    return times;
+}
+
 inline QString durationString(qint64 seconds)
 {
     int hour = static_cast<int>(seconds / 3600);
@@ -5,6 +5,8 @@
 #ifndef MATCHEDITEM_H
 #define MATCHEDITEM_H
 
+#include "builtinsearch.h"
+
 #include <QtCore>
 
 namespace GrandSearch {
@@ -18,10 +20,75 @@ struct MatchedItem {
     QString searcher;   //出自的搜索项
     QVariant extra;    //扩展信息，由各搜索结果补充的特殊属性QVariantHash
 
+    //权重计算方法
+    enum WeightMethod {
+        NoWeightMethod = 0,
+        LocalFileWeightMethod,
+        AppWeightMethod,
+        SettingWeightMethod,
+        UnknownWeightMethod     //extra中设置了无法识别的计算方法
+    };
+
+    //排序字段，解码时从extra中解析一次，序列化时写回extra
+    bool hasWeight = false;     //是否设置了权重
+    double weight = 0;          //权重
+    WeightMethod weightMethod = NoWeightMethod;
+
     bool operator == (const MatchedItem &other) const {
         return item == other.item && name == other.name
                 && icon == other.icon && type == other.type
-                && searcher == other.searcher && extra == other.extra;
+                && searcher == other.searcher && extra == other.extra
+                && hasWeight == other.hasWeight && weight == other.weight
+                && weightMethod == other.weightMethod;
+    }
+
+    static inline WeightMethod weightMethodFromString(const QString &method) {
+        if (method.isEmpty())
+            return NoWeightMethod;
+        if (method == QLatin1String(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_LOCALFILE))
+            return LocalFileWeightMethod;
+        if (method == QLatin1String(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP))
+            return AppWeightMethod;
+        if (method == QLatin1String(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_SETTING))
+            return SettingWeightMethod;
+        return UnknownWeightMethod;
+    }
+
+    static inline QString weightMethodToString(WeightMethod method) {
+        switch (method) {
+        case LocalFileWeightMethod:
+            return QStringLiteral(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_LOCALFILE);
+        case AppWeightMethod:
+            return QStringLiteral(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP);
+        case SettingWeightMethod:
+            return QStringLiteral(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_SETTING);
+        default:
+            break;
+        }
+        return QString();
+    }
+
+    //从extra中解析排序字段
+    inline void decodeRanking() {
+        const QVariantHash ext = extra.toHash();
+        auto it = ext.constFind(GRANDSEARCH_PROPERTY_ITEM_WEIGHT);
+        hasWeight = it != ext.constEnd();
+        weight = hasWeight ? it.value().toDouble() : 0;
+        weightMethod = weightMethodFromString(ext.value(GRANDSEARCH_PROPERTY_WEIGHT_METHOD).toString());
+    }
+
+    //将排序字段合并回extra，用于序列化，保持与旧格式兼容
+    inline QVariant encodedExtra() const {
+        const QString method = weightMethodToString(weightMethod);
+        if (!hasWeight && method.isEmpty())
+            return extra;
+
+        QVariantHash ext = extra.toHash();
+        if (hasWeight)
+            ext.insert(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, weight);
+        if (!method.isEmpty())
+            ext.insert(GRANDSEARCH_PROPERTY_WEIGHT_METHOD, method);
+        return QVariant::fromValue(ext);
     }
 };
 
@@ -33,13 +100,14 @@ typedef QMap<QString, MatchedItems> MatchedItemMap; //组-匹配项列表
 //序列化
 inline QDataStream &operator<<(QDataStream &stream, const GrandSearch::MatchedItem &in)
 {
-    stream << in.item << in.name << in.icon << in.type << in.searcher << in.extra;
+    stream << in.item << in.name << in.icon << in.type << in.searcher << in.encodedExtra();
     return stream;
 }
 
 inline QDataStream &operator>>(QDataStream &stream, GrandSearch::MatchedItem &out)
 {
     stream >> out.item >> out.name >> out.icon >> out.type >> out.searcher >> out.extra;
+    out.decodeRanking();
     return stream;
 }
 
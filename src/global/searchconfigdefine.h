@@ -57,6 +57,8 @@
 // 语义搜索
 #define GRANDSEARCH_SEMANTIC_GROUP          "Semantic_Group"
 #define GRANDSEARCH_SEMANTIC_ENABLED        "semantic.enabled"
+#define GRANDSEARCH_SEMANTIC_TIMEBUDGET     "semantic.timeBudget"   // 语义搜索总耗时预算，单位毫秒
+#define GRANDSEARCH_SEMANTIC_TIMEBUDGET_DEFAULT 8000                 // 语义搜索默认耗时预算
 
 // 配置切换界面参数
 #define SWITCHWIDGETWIDTH       476
@@ -31,6 +31,10 @@ void HighlightLabel::setKeywords(const QStringList &keywords)
     if (m_keywords == keywords)
         return;
     m_keywords = keywords;
+    if (keywords.isEmpty())
+        m_matcher.reset();
+    else
+        m_matcher = HighlightUtils::KeywordMatcher::get(keywords);
     relayout();
 }
 
@@ -200,13 +204,13 @@ HighlightLabel::ElideInfo HighlightLabel::computeSmartElidedText(
     ElideInfo info;
     info.displayText = text;
 
-    if (text.isEmpty() || m_keywords.isEmpty())
+    if (text.isEmpty() || !m_matcher)
         return info;
 
     if (HighlightUtils::elideWithTracking(text, Qt::ElideRight, maxWidth, fm).text == text)
         return info;
 
-    auto matchRanges = HighlightUtils::findMatchRanges(text, m_keywords);
+    auto matchRanges = HighlightUtils::findMatchRanges(text, *m_matcher);
     if (matchRanges.isEmpty()) {
         HighlightUtils::ElideResult fallback = HighlightUtils::elideWithTracking(text, Qt::ElideRight, maxWidth, fm);
         info.displayText = fallback.text;
@@ -233,8 +237,11 @@ HighlightLabel::ElideInfo HighlightLabel::computeSmartElidedText(
 QVector<QTextLayout::FormatRange> HighlightLabel::buildFormatRanges(
         const QString &displayText, const QVector<int> &origPosMapping) const
 {
+    if (!m_matcher)
+        return {};
+
     QTextCharFormat fmt = HighlightUtils::defaultHighlightFormat(font(), palette());
-    return HighlightUtils::buildFormatRanges(displayText, origPosMapping, m_text, m_keywords, fmt);
+    return HighlightUtils::buildFormatRanges(displayText, origPosMapping, m_text, *m_matcher, fmt);
 }
 
 void HighlightLabel::paintEvent(QPaintEvent *event)
@@ -6,8 +6,13 @@
 #define HIGHLIGHTLABEL_H
 
 #include <QLabel>
+#include <QSharedPointer>
 #include <QTextLayout>
 
+namespace HighlightUtils {
+class KeywordMatcher;
+}
+
 class HighlightLabel : public QLabel
 {
     Q_OBJECT
@@ -58,6 +63,7 @@ private:
 
     QString m_text;
     QStringList m_keywords;
+    QSharedPointer<const HighlightUtils::KeywordMatcher> m_matcher;   // 关键词变化时获取，重排版时复用
     ElideMode m_elideMode = ElideMode::Right;
     int m_maxLines = 1;
     QTextLayout m_layout;
@@ -6,9 +6,11 @@
 
 #include <QPainter>
 #include <QFontMetricsF>
-#include <QRegularExpression>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QPalette>
 #include <QFont>
+#include <QQueue>
 #include <algorithm>
 
 namespace HighlightUtils {
@@ -23,33 +25,128 @@ static double textWidth(const QFontMetricsF &fm, const QString &text)
     return fm.horizontalAdvance(text);
 }
 
-QVector<MatchRange> findMatchRanges(const QString &text, const QStringList &keywords)
+KeywordMatcher::KeywordMatcher(const QStringList &keywords)
 {
-    QVector<MatchRange> ranges;
+    m_nodes.append(Node());
+
+    // Build the trie over case-folded keywords
     for (const QString &kw : keywords) {
         if (kw.isEmpty())
             continue;
-        QRegularExpression re(QRegularExpression::escape(kw),
-                              QRegularExpression::CaseInsensitiveOption);
-        QRegularExpressionMatchIterator it = re.globalMatch(text);
-        while (it.hasNext()) {
-            auto m = it.next();
-            ranges.append({ static_cast<int>(m.capturedStart()),
-                            static_cast<int>(m.capturedStart() + m.capturedLength()) });
+        int state = 0;
+        for (const QChar &c : kw) {
+            const QChar folded = c.toCaseFolded();
+            int nextState = m_nodes[state].next.value(folded, -1);
+            if (nextState < 0) {
+                nextState = m_nodes.size();
+                m_nodes[state].next.insert(folded, nextState);
+                m_nodes.append(Node());
+            }
+            state = nextState;
+        }
+        m_nodes[state].matchLength = std::max(m_nodes[state].matchLength, static_cast<int>(kw.length()));
+    }
+
+    // Breadth-first fail links; a node reports the longest keyword among its own and its fail chain
+    QQueue<int> queue;
+    for (int child : std::as_const(m_nodes[0].next))
+        queue.enqueue(child);
+
+    while (!queue.isEmpty()) {
+        const int state = queue.dequeue();
+        for (auto it = m_nodes[state].next.cbegin(); it != m_nodes[state].next.cend(); ++it) {
+            const int child = it.value();
+            int fail = m_nodes[state].fail;
+            while (fail > 0 && !m_nodes[fail].next.contains(it.key()))
+                fail = m_nodes[fail].fail;
+            const int target = m_nodes[fail].next.value(it.key(), 0);
+            m_nodes[child].fail = (target == child) ? 0 : target;
+            m_nodes[child].matchLength = std::max(m_nodes[child].matchLength,
+                                                  m_nodes[m_nodes[child].fail].matchLength);
+            queue.enqueue(child);
         }
     }
-    std::sort(ranges.begin(), ranges.end(),
-              [](const MatchRange &a, const MatchRange &b) { return a.start < b.start; });
+}
+
+QSharedPointer<const KeywordMatcher> KeywordMatcher::get(const QStringList &keywords)
+{
+    // Keyword sets change once per query; a handful of recent ones covers the
+    // list, the preview and labels showing the previous query while it fades out.
+    static const int kMaxCached = 8;
+    static QMutex mutex;
+    static QList<QPair<QString, QSharedPointer<const KeywordMatcher>>> cache;
+
+    const QString key = keywords.join(QChar(0x1f));
+
+    QMutexLocker locker(&mutex);
+    for (int i = 0; i < cache.size(); ++i) {
+        if (cache.at(i).first == key) {
+            if (i > 0)
+                cache.move(i, 0);
+            return cache.constFirst().second;
+        }
+    }
+
+    QSharedPointer<const KeywordMatcher> matcher(new KeywordMatcher(keywords));
+    cache.prepend(qMakePair(key, matcher));
+    while (cache.size() > kMaxCached)
+        cache.removeLast();
+    return matcher;
+}
+
+bool KeywordMatcher::isEmpty() const
+{
+    return m_nodes.size() <= 1;
+}
+
+int KeywordMatcher::step(int state, QChar ch) const
+{
+    while (true) {
+        const int next = m_nodes[state].next.value(ch, -1);
+        if (next >= 0)
+            return next;
+        if (state == 0)
+            return 0;
+        state = m_nodes[state].fail;
+    }
+}
+
+QVector<MatchRange> KeywordMatcher::match(const QString &text) const
+{
     QVector<MatchRange> merged;
-    for (const auto &r : ranges) {
-        if (!merged.isEmpty() && r.start <= merged.last().end)
-            merged.last().end = std::max(merged.last().end, r.end);
-        else
-            merged.append(r);
+    if (isEmpty())
+        return merged;
+
+    int state = 0;
+    for (int i = 0; i < text.length(); ++i) {
+        state = step(state, text.at(i).toCaseFolded());
+        const int len = m_nodes[state].matchLength;
+        if (len == 0)
+            continue;
+
+        // Ranges arrive ordered by end; a longer match may reach back over earlier ones
+        int start = i + 1 - len;
+        int end = i + 1;
+        while (!merged.isEmpty() && start <= merged.last().end) {
+            start = std::min(start, merged.last().start);
+            end = std::max(end, merged.last().end);
+            merged.removeLast();
+        }
+        merged.append({ start, end });
     }
     return merged;
 }
 
+QVector<MatchRange> findMatchRanges(const QString &text, const QStringList &keywords)
+{
+    return findMatchRanges(text, *KeywordMatcher::get(keywords));
+}
+
+QVector<MatchRange> findMatchRanges(const QString &text, const KeywordMatcher &matcher)
+{
+    return matcher.match(text);
+}
+
 static ElideResult buildWindowElide(const QString &text, int keepStart, int keepEnd,
                                     int maxWidth, const QFontMetricsF &fm)
 {
@@ -311,68 +408,71 @@ QVector<QTextLayout::FormatRange> buildFormatRanges(
         const QString &originalText,
         const QStringList &keywords,
         const QTextCharFormat &format)
+{
+    if (keywords.isEmpty() || displayText.isEmpty())
+        return {};
+
+    return buildFormatRanges(displayText, origPosMapping, originalText,
+                             *KeywordMatcher::get(keywords), format);
+}
+
+QVector<QTextLayout::FormatRange> buildFormatRanges(
+        const QString &displayText,
+        const QVector<int> &origPosMapping,
+        const QString &originalText,
+        const KeywordMatcher &matcher,
+        const QTextCharFormat &format)
 {
     QVector<QTextLayout::FormatRange> ranges;
 
-    if (keywords.isEmpty() || displayText.isEmpty())
+    if (matcher.isEmpty() || displayText.isEmpty())
         return ranges;
 
+    auto appendRange = [&](int start, int length) {
+        QTextLayout::FormatRange range;
+        range.start = start;
+        range.length = length;
+        range.format = format;
+        ranges.append(range);
+    };
+
     if (origPosMapping.isEmpty()) {
-        for (const QString &keyword : keywords) {
-            if (keyword.isEmpty())
-                continue;
-            QRegularExpression re(QRegularExpression::escape(keyword),
-                                  QRegularExpression::CaseInsensitiveOption);
-            QRegularExpressionMatchIterator it = re.globalMatch(displayText);
-            while (it.hasNext()) {
-                QRegularExpressionMatch match = it.next();
-                QTextLayout::FormatRange range;
-                range.start = match.capturedStart();
-                range.length = match.capturedLength();
-                range.format = format;
-                ranges.append(range);
-            }
+        for (const MatchRange &m : matcher.match(displayText))
+            appendRange(m.start, m.end - m.start);
+        return ranges;
+    }
+
+    // Match once in the original text, then walk the display text a single time.
+    // Elided positions ascend (ellipsis chars are -1), so the match cursor only moves forward.
+    const QVector<MatchRange> matches = matcher.match(originalText);
+    if (matches.isEmpty())
+        return ranges;
+
+    int cursor = 0;
+    int lastOrigPos = -1;
+    int rangeStart = -1;
+    for (int i = 0; i < displayText.length(); ++i) {
+        const int origPos = origPosMapping.value(i, -1);
+        bool inMatch = false;
+        if (origPos >= 0) {
+            if (origPos < lastOrigPos)
+                cursor = 0;
+            lastOrigPos = origPos;
+            while (cursor < matches.size() && matches.at(cursor).end <= origPos)
+                ++cursor;
+            inMatch = cursor < matches.size() && matches.at(cursor).start <= origPos;
         }
-    } else {
-        for (const QString &keyword : keywords) {
-            if (keyword.isEmpty())
-                continue;
-            QRegularExpression re(QRegularExpression::escape(keyword),
-                                  QRegularExpression::CaseInsensitiveOption);
-            QRegularExpressionMatchIterator it = re.globalMatch(originalText);
-            while (it.hasNext()) {
-                QRegularExpressionMatch match = it.next();
-                int origStart = match.capturedStart();
-                int origEnd = origStart + match.capturedLength();
-
-                int rangeStart = -1;
-                for (int i = 0; i < displayText.length(); ++i) {
-                    int origPos = origPosMapping.value(i, -1);
-                    bool inMatch = (origPos >= origStart && origPos < origEnd);
-                    if (inMatch) {
-                        if (rangeStart == -1)
-                            rangeStart = i;
-                    } else {
-                        if (rangeStart != -1) {
-                            QTextLayout::FormatRange range;
-                            range.start = rangeStart;
-                            range.length = i - rangeStart;
-                            range.format = format;
-                            ranges.append(range);
-                            rangeStart = -1;
-                        }
-                    }
-                }
-                if (rangeStart != -1) {
-                    QTextLayout::FormatRange range;
-                    range.start = rangeStart;
-                    range.length = displayText.length() - rangeStart;
-                    range.format = format;
-                    ranges.append(range);
-                }
-            }
+
+        if (inMatch) {
+            if (rangeStart == -1)
+                rangeStart = i;
+        } else if (rangeStart != -1) {
+            appendRange(rangeStart, i - rangeStart);
+            rangeStart = -1;
         }
     }
+    if (rangeStart != -1)
+        appendRange(rangeStart, displayText.length() - rangeStart);
 
     return ranges;
 }
@@ -6,6 +6,8 @@
 #define HIGHLIGHTUTILS_H
 
 #include <QFontMetricsF>
+#include <QHash>
+#include <QSharedPointer>
 #include <QTextLayout>
 #include <QString>
 #include <QStringList>
@@ -27,8 +29,38 @@ struct ElideResult
     QVector<int> origPositions;   // text[i] -> original char position, -1 for ellipsis char
 };
 
+// Case-folded Aho-Corasick automaton over a keyword set.
+// Built once per keyword set and shared by every caller through get();
+// matching a string is a single pass regardless of the number of keywords.
+class KeywordMatcher
+{
+public:
+    explicit KeywordMatcher(const QStringList &keywords);
+
+    // Shared matcher for a keyword set, cached across calls (thread-safe)
+    static QSharedPointer<const KeywordMatcher> get(const QStringList &keywords);
+
+    bool isEmpty() const;
+
+    // All match ranges in text (case-insensitive, overlaps merged, sorted)
+    QVector<MatchRange> match(const QString &text) const;
+
+private:
+    struct Node
+    {
+        QHash<QChar, int> next;
+        int fail = 0;
+        int matchLength = 0;   // longest keyword ending at this node, via fail links
+    };
+
+    int step(int state, QChar ch) const;
+
+    QVector<Node> m_nodes;
+};
+
 // Find all keyword match ranges in text (case-insensitive, merged, sorted)
 QVector<MatchRange> findMatchRanges(const QString &text, const QStringList &keywords);
+QVector<MatchRange> findMatchRanges(const QString &text, const KeywordMatcher &matcher);
 
 // Standard elide with position tracking
 ElideResult elideWithTracking(const QString &text, Qt::TextElideMode mode,
@@ -48,6 +80,12 @@ QVector<QTextLayout::FormatRange> buildFormatRanges(
         const QString &originalText,
         const QStringList &keywords,
         const QTextCharFormat &format);
+QVector<QTextLayout::FormatRange> buildFormatRanges(
+        const QString &displayText,
+        const QVector<int> &origPosMapping,
+        const QString &originalText,
+        const KeywordMatcher &matcher,
+        const QTextCharFormat &format);
 
 // Convenience: create a default highlight format (DemiBold + BrightText foreground)
 QTextCharFormat defaultHighlightFormat(const QFont &baseFont, const QPalette &palette);
@@ -8,10 +8,7 @@
 
 #include <QStandardPaths>
 #include <QFileInfo>
-#include <QJsonParseError>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QElapsedTimer>
+#include <QDateTime>
 #include <QString>
 #include <QApplication>
 #include <QtConcurrent>
@@ -38,16 +35,25 @@ void AccessRecord::startParseRecord()
     std::call_once(m_initFlag, []() {
         qCDebug(logGrandSearch) << "Initializing access record parsing - Path:" << AccessRecord::instance()->m_recordPath;
         // 异步解析
-        QtConcurrent::run(&AccessRecord::parseRecord, AccessRecord::instance()->m_recordPath);
+        QtConcurrent::run(&AccessRecord::parseRecord, AccessRecord::instance()->m_recordPath,
+                          AccessRecord::instance()->m_legacyPath);
     });
 }
 
 /**
- * @brief AccessRecord::getRecord 主线程获取数据
+ * @brief AccessRecord::store 主线程获取访问热度数据
  */
-QHash<QString, QHash<QString, int>> AccessRecord::getRecord()
+const FrecencyStore &AccessRecord::store() const
 {
-    return m_recordHash;
+    return m_store;
+}
+
+/**
+ * @brief AccessRecord::frecency 获取类目在当前时刻的访问热度
+ */
+double AccessRecord::frecency(const QString &searcher, const QString &item) const
+{
+    return m_store.score(searcher, item, QDateTime::currentSecsSinceEpoch());
 }
 
 /**
@@ -57,59 +63,21 @@ QHash<QString, QHash<QString, int>> AccessRecord::getRecord()
  */
 void AccessRecord::updateRecord(const MatchedItem &matchedItem, qint64 time)
 {
-    const QString &seacher = matchedItem.searcher;
-    const QString &item = matchedItem.item;
-
-    qCDebug(logGrandSearch) << "Updating access record - Searcher:" << seacher
-                            << "Item:" << item
+    qCDebug(logGrandSearch) << "Updating access record - Searcher:" << matchedItem.searcher
+                            << "Item:" << matchedItem.item
                             << "Time:" << time;
 
-    QJsonObject recordObj = m_recordObj;
-
-    if (!recordObj.contains(seacher)) {
-        QJsonArray times;
-        times.append(time);
-        QJsonObject itemObj;
-        itemObj.insert(item, times);
-        recordObj.insert(seacher, itemObj);
-        qCDebug(logGrandSearch) << "Created new searcher entry:" << seacher;
-    } else {
-        QJsonObject::iterator searcherIt = recordObj.begin();
-        while (searcherIt != recordObj.end()) {
-            if (searcherIt.key() == seacher) {
-                QJsonObject itemsObj = searcherIt.value().toObject();
-                if (!itemsObj.contains(item)) {
-                    QJsonArray times;
-                    times.append(time);
-                    itemsObj.insert(item, times);
-                    qCDebug(logGrandSearch) << "Created new item entry - Searcher:" << seacher << "Item:" << item;
-                } else {
-                    QJsonObject::iterator itemIt = itemsObj.begin();
-                    while (itemIt != itemsObj.end()) {
-                        if (itemIt.key() == item) {
-                            QJsonArray times = itemIt.value().toArray();
-                            times.append(double(time));
-                            itemsObj.insert(item, times);
-                            qCDebug(logGrandSearch) << "Updated existing item - Searcher:" << seacher
-                                                    << "Item:" << item << "Access count:" << times.size();
-                            break;
-                        }
-                        ++itemIt;
-                    }
-                }
-                recordObj.insert(seacher, itemsObj);
-                break;
-            }
-            ++searcherIt;
-        }
+    // 记录尚未加载完成，待加载完成后再更新
+    if (!m_finished) {
+        m_earlyRecords.append(qMakePair(matchedItem, time));
+        return;
     }
 
-    m_recordObj = recordObj;
-    qCDebug(logGrandSearch) << "Access record update completed";
+    m_store.touch(matchedItem.searcher, matchedItem.item, time);
 }
 
 /**
- * @brief AccessRecord::sync 主线程将更新后的数据回写到文件中
+ * @brief AccessRecord::sync 主线程将新增的记录追加到文件中，无效记录过多时压缩文件
  */
 void AccessRecord::sync()
 {
@@ -119,39 +87,35 @@ void AccessRecord::sync()
     }
 
     qCDebug(logGrandSearch) << "Syncing access records to file:" << m_recordPath;
-    QFile file(m_recordPath);
-    if (!file.open(QFile::WriteOnly)) {
-        qCWarning(logGrandSearch) << "Failed to open record file for writing:" << m_recordPath
-                                  << "Error:" << file.errorString();
-        return;
-    }
-
-    QJsonDocument doc(m_recordObj);
-    QByteArray data = doc.toJson();
-    file.write(data);
-    file.close();
-    qCDebug(logGrandSearch) << "Successfully synced access records - Size:" << data.size() << "bytes";
+    if (m_store.needsCompaction())
+        m_store.compact(m_recordPath, QDateTime::currentSecsSinceEpoch());
+    else
+        m_store.flush(m_recordPath);
 }
 
 AccessRecord::AccessRecord()
 {
     qCDebug(logGrandSearch) << "Creating AccessRecord instance";
 
-    qRegisterMetaType<QHash<QString, QHash<QString, int>>>();
-    auto recordPath = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).first();
-    m_recordPath = recordPath
+    qRegisterMetaType<FrecencyStore>();
+    auto recordPath = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).first()
             + "/" + QApplication::organizationName()
-            + "/" + GRANDSEARCH_NAME
-            + "/" + "accessrecord.json";
+            + "/" + GRANDSEARCH_NAME;
+    m_recordPath = recordPath + "/" + "accessrecord.log";
+    m_legacyPath = recordPath + "/" + "accessrecord.json";
 
     qCDebug(logGrandSearch) << "Initializing access record manager - Path:" << m_recordPath;
 
-    connect(this, &AccessRecord::sigParseFinished, this, [this](const QJsonObject &recordObj, const QHash<QString, QHash<QString, int>> &recordHash) {
+    connect(this, &AccessRecord::sigParseFinished, this, [this](const FrecencyStore &store) {
         qCInfo(logGrandSearch) << "Record parsing completed - Updating data";
-        m_recordObj = recordObj;
-        m_recordHash = recordHash;
+        m_store = store;
         m_finished = true;
-        qCDebug(logGrandSearch) << "Access record initialization completed - Searchers:" << recordHash.size();
+
+        for (const auto &record : m_earlyRecords)
+            m_store.touch(record.first.searcher, record.first.item, record.second);
+        m_earlyRecords.clear();
+
+        qCDebug(logGrandSearch) << "Access record initialization completed - Items:" << m_store.count();
     });
 
     qCDebug(logGrandSearch) << "AccessRecord instance created successfully";
@@ -163,121 +127,25 @@ AccessRecord::~AccessRecord()
 }
 
 /**
- * @brief AccessRecord::ParseRecord 解析记录文件
- */
-void AccessRecord::parseRecord(QString recordPath)
-{
-    qCDebug(logGrandSearch) << "Starting record file parsing - Path:" << recordPath;
-
-    QFileInfo recordFile(recordPath);
-    // 创建文件
-    if (!recordFile.exists()) {
-        qCDebug(logGrandSearch) << "Creating new record file:" << recordPath;
-        recordFile.absoluteDir().mkpath(".");
-        QFile file(recordPath);
-        file.open(QFile::NewOnly);
-        QJsonObject version;
-        version.insert("version", "1.0");
-        QJsonDocument doc(version);
-        QByteArray data = doc.toJson();
-        file.write(data);
-        file.close();
-        qCInfo(logGrandSearch) << "Created new record file with version 1.0";
-    }
-    parseJson(recordPath);
-}
-
-/**
- * @brief AccessRecord::parseJson 解析json数据
- * @param recordPath 文件路径
+ * @brief AccessRecord::parseRecord 加载记录文件，不存在时从旧版json记录迁移
+ * @param logPath 记录文件路径
+ * @param legacyPath 旧版json记录文件路径
  */
-void AccessRecord::parseJson(const QString &recordPath)
+void AccessRecord::parseRecord(QString logPath, QString legacyPath)
 {
-    qCDebug(logGrandSearch) << "Parsing record file:" << recordPath;
-    QFile file(recordPath);
-    if (!file.open(QFile::ReadOnly)) {
-        qCWarning(logGrandSearch) << "Failed to open record file for reading:" << recordPath
-                                  << "Error:" << file.errorString();
-        return;
-    }
-
-    QByteArray allData = file.readAll();
-    file.close();
-
-    QJsonParseError jsonError;
-    QJsonDocument doc(QJsonDocument::fromJson(allData, &jsonError));
-
-    static const int validTime = 7 * 24 * 60 * 60;
-
-    // 记录计算次数的searcher
-    QHash<QString, QHash<QString, int>> searcherHash;
-    QJsonObject searcherObj;
-    if (jsonError.error != QJsonParseError::NoError) {
-        qCWarning(logGrandSearch) << "JSON parsing error:" << jsonError.errorString()
-                                  << "Offset:" << jsonError.offset;
-        emit AccessRecord::instance()->sigParseFinished(searcherObj, searcherHash, QPrivateSignal());
-        return;
-    }
-
-    qCDebug(logGrandSearch) << "JSON parsing successful, processing data";
-
-    searcherObj = doc.object();
-    for (auto searcherIt = searcherObj.begin(); searcherIt != searcherObj.end();) {
-        if (searcherIt.key() == "version") {
-            ++searcherIt;
-            continue;
-        }
-
-        QJsonObject itemsObj = searcherIt.value().toObject();
-        // 记录计算次数的item
-        QHash<QString, int> itemsHash;
-        for (auto itemIt = itemsObj.begin(); itemIt != itemsObj.end();) {
-            QJsonArray timeArray = itemIt.value().toArray();
-            for (auto timeIt = timeArray.begin(); timeIt != timeArray.end();) {
-                qint64 timeT = (*timeIt).toDouble();
-                // 获取当前时间戳
-                const qint64 currentTimeT = QDateTime::currentDateTime().toSecsSinceEpoch();
-                // 计算两个时间戳的差
-                const qint64 intervalTime = currentTimeT - timeT;
-                // 时间戳的差大于七天
-                if (intervalTime > validTime || intervalTime < 0) {
-                    timeIt = timeArray.erase(timeIt);
-                } else {
-                    ++timeIt;
-                }
-            }
-
-            if (timeArray.isEmpty()) {
-                // 时间列表为空，删除该item对象
-                itemIt = itemsObj.erase(itemIt);
-            } else {
-                auto newIt = itemsObj.insert(itemIt.key(), timeArray);
-                Q_ASSERT(newIt == itemIt);
-                ++itemIt;
-            }
-        }
-
-        if (itemsObj.empty()) {
-            // item对象为空，删除该searcher对象
-            searcherIt = searcherObj.erase(searcherIt);
-        } else {
-            for (auto tempItemIt = itemsObj.begin(); tempItemIt != itemsObj.end();) {
-                QJsonArray timeArray = tempItemIt.value().toArray();
-                int times = timeArray.size();
-                if (times > 20) {
-                    itemsHash.insert(tempItemIt.key(), 20);
-                } else {
-                    itemsHash.insert(tempItemIt.key(), times);
-                }
-                ++tempItemIt;
-            }
-            searcherHash.insert(searcherIt.key(), itemsHash);
-            auto newIt = searcherObj.insert(searcherIt.key(), itemsObj);
-            Q_ASSERT(newIt == searcherIt);
-            ++searcherIt;
-        }
+    qCDebug(logGrandSearch) << "Starting record file parsing - Path:" << logPath;
+
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    FrecencyStore store;
+    if (!store.load(logPath, now)) {
+        // 创建文件，若存在旧版记录则一并导入
+        if (store.importJson(legacyPath, now))
+            qCInfo(logGrandSearch) << "Imported legacy access record - Items:" << store.count();
+        store.compact(logPath, now);
+    } else if (store.needsCompaction()) {
+        store.compact(logPath, now);
     }
 
-    qCDebug(logGrandSearch) << "Record parsing completed - Searchers:" << searcherHash.size();
-    emit AccessRecord::instance()->sigParseFinished(searcherObj, searcherHash, QPrivateSignal());
+    qCDebug(logGrandSearch) << "Record parsing completed - Items:" << store.count();
+    emit AccessRecord::instance()->sigParseFinished(store, QPrivateSignal());
 }
@@ -6,6 +6,7 @@
 #define ACCESSRECORD_H
 
 #include "global/matcheditem.h"
+#include "frecencystore.h"
 
 namespace GrandSearch {
 
@@ -16,25 +17,26 @@ public:
     static AccessRecord *instance();
 
     void startParseRecord();
-    QHash<QString, QHash<QString, int>> getRecord();  //主线程获取数据  item:次数
+    const FrecencyStore &store() const;    // 主线程获取数据，不产生拷贝
+    double frecency(const QString &searcher, const QString &item) const;   // 当前时刻的访问热度
     void updateRecord(const MatchedItem &matchedItem, qint64 time); // 主线程更新用户点击后的数据
 public slots:
     void sync();   //主线程回写数据
 
 signals:
-    void sigParseFinished(const QJsonObject &recordObj, const QHash<QString, QHash<QString, int>> &recordHash, QPrivateSignal);
+    void sigParseFinished(const GrandSearch::FrecencyStore &store, QPrivateSignal);
 protected:
     explicit AccessRecord();
     ~AccessRecord();
 
 private:
-    static void parseRecord(QString recordPath);  // 子线程创建/解析文件
-    static void parseJson(const QString &recordPath); //子线程解析文件数据并过滤数据
+    static void parseRecord(QString logPath, QString legacyPath);  // 子线程加载/迁移记录并按需压缩
 
 private:
-    QHash<QString, QHash<QString, int>> m_recordHash; // 存放计算次数后的数据
-    QJsonObject m_recordObj; // 存放文件中的数据
+    FrecencyStore m_store;  // 访问热度数据
+    QList<QPair<MatchedItem, qint64>> m_earlyRecords;  // 解析完成前产生的点击
     QString m_recordPath; // 记录文件的路径
+    QString m_legacyPath; // 旧版json记录文件的路径
     bool m_finished = false;
     std::once_flag m_initFlag;
 };
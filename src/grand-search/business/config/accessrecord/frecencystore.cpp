@@ -0,0 +1,344 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "frecencystore.h"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+#include <QVector>
+#include <QLoggingCategory>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
+
+using namespace GrandSearch;
+
+namespace {
+
+// 日志文件头：魔数 + 版本
+const char LogMagic[4] = { 'G', 'S', 'F', 'R' };
+const quint32 LogVersion = 1;
+const int LogHeaderSize = sizeof(LogMagic) + sizeof(quint32);
+
+// 记录头，其后紧跟 searcher 与 item 的 UTF-8 数据
+struct RecordHeader
+{
+    quint16 searcherSize;
+    quint16 itemSize;
+    quint32 checksum;   // 对 lastAccess、score 及字符串数据计算
+    qint64 lastAccess;
+    double score;
+};
+static_assert(sizeof(RecordHeader) == 24, "unexpected frecency record layout");
+
+// 衰减后低于该值的记录不再保留
+const double MinScore = 0.01;
+
+// 日志中的记录数超过有效记录数的两倍（且超过该值）时压缩
+const int CompactSlack = 64;
+
+quint32 fnv1a(const char *data, size_t size, quint32 hash = 2166136261u)
+{
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uchar>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+quint32 recordChecksum(const RecordHeader &header, const char *strings)
+{
+    quint32 hash = fnv1a(reinterpret_cast<const char *>(&header.lastAccess), sizeof(header.lastAccess));
+    hash = fnv1a(reinterpret_cast<const char *>(&header.score), sizeof(header.score), hash);
+    return fnv1a(strings, header.searcherSize + header.itemSize, hash);
+}
+
+void appendHeader(QByteArray &buffer)
+{
+    buffer.append(LogMagic, sizeof(LogMagic));
+    buffer.append(reinterpret_cast<const char *>(&LogVersion), sizeof(LogVersion));
+}
+
+}
+
+/**
+ * @brief FrecencyStore::decayedScore 计算记录在 now 时刻衰减后的分值
+ */
+double FrecencyStore::decayedScore(const FrecencyEntry &entry, qint64 now)
+{
+    const qint64 elapsed = now - entry.lastAccess;
+    if (elapsed <= 0)
+        return entry.score;
+
+    return entry.score * std::exp(-double(elapsed) / MeanLifetime);
+}
+
+const FrecencyEntry *FrecencyStore::find(const QString &searcher, const QString &item) const
+{
+    auto searcherIt = m_entries.constFind(searcher);
+    if (searcherIt == m_entries.constEnd())
+        return nullptr;
+
+    auto itemIt = searcherIt->constFind(item);
+    if (itemIt == searcherIt->constEnd())
+        return nullptr;
+
+    return &itemIt.value();
+}
+
+double FrecencyStore::score(const QString &searcher, const QString &item, qint64 now) const
+{
+    const FrecencyEntry *entry = find(searcher, item);
+    return entry ? decayedScore(*entry, now) : 0;
+}
+
+int FrecencyStore::count() const
+{
+    int ret = 0;
+    for (const ItemEntries &items : m_entries)
+        ret += items.size();
+    return ret;
+}
+
+/**
+ * @brief FrecencyStore::touch 记录一次访问，同时生成待写入日志的记录
+ */
+void FrecencyStore::touch(const QString &searcher, const QString &item, qint64 time)
+{
+    FrecencyEntry &entry = m_entries[searcher][item];
+    entry.score = decayedScore(entry, time) + 1;
+    entry.lastAccess = qMax(entry.lastAccess, time);
+
+    appendRecord(m_pendingLog, searcher, item, entry);
+    ++m_pendingRecords;
+}
+
+/**
+ * @brief FrecencyStore::load 通过 mmap 重放日志文件，同一类目以最后一条记录为准
+ * @return 日志文件不存在或无法读取时返回 false
+ */
+bool FrecencyStore::load(const QString &logPath, qint64 now)
+{
+    QFile file(logPath);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    m_entries.clear();
+    m_logRecords = 0;
+    m_logDamaged = false;
+
+    const qint64 size = file.size();
+    if (size == 0)
+        return true;
+
+    uchar *mapped = size >= LogHeaderSize ? file.map(0, size) : nullptr;
+    if (!mapped) {
+        qCWarning(logGrandSearch) << "Failed to map frecency log:" << logPath << file.errorString();
+        m_logDamaged = true;
+        return true;
+    }
+
+    const char *data = reinterpret_cast<const char *>(mapped);
+    quint32 version = 0;
+    memcpy(&version, data + sizeof(LogMagic), sizeof(version));
+    if (memcmp(data, LogMagic, sizeof(LogMagic)) != 0 || version != LogVersion) {
+        qCWarning(logGrandSearch) << "Unknown frecency log format, it will be rewritten:" << logPath;
+        m_logDamaged = true;
+        file.unmap(mapped);
+        return true;
+    }
+
+    qint64 offset = LogHeaderSize;
+    while (offset < size) {
+        RecordHeader header;
+        if (size - offset < qint64(sizeof(header))) {
+            m_logDamaged = true;
+            break;
+        }
+        memcpy(&header, data + offset, sizeof(header));
+
+        const char *strings = data + offset + sizeof(header);
+        const qint64 recordSize = qint64(sizeof(header)) + header.searcherSize + header.itemSize;
+        if (size - offset < recordSize || recordChecksum(header, strings) != header.checksum) {
+            // 写入中断导致的残缺记录，其后的数据不再可信
+            m_logDamaged = true;
+            break;
+        }
+
+        const QString searcher = QString::fromUtf8(strings, header.searcherSize);
+        const QString item = QString::fromUtf8(strings + header.searcherSize, header.itemSize);
+        FrecencyEntry &entry = m_entries[searcher][item];
+        entry.score = header.score;
+        entry.lastAccess = header.lastAccess;
+
+        ++m_logRecords;
+        offset += recordSize;
+    }
+
+    file.unmap(mapped);
+
+    if (m_logDamaged)
+        qCWarning(logGrandSearch) << "Frecency log is damaged at offset" << offset << "- Path:" << logPath;
+
+    prune(now);
+    return true;
+}
+
+/**
+ * @brief FrecencyStore::importJson 导入旧版 json 格式的点选记录
+ */
+bool FrecencyStore::importJson(const QString &jsonPath, qint64 now)
+{
+    QFile file(jsonPath);
+    if (!file.open(QFile::ReadOnly))
+        return false;
+
+    QJsonParseError jsonError;
+    const QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &jsonError);
+    if (jsonError.error != QJsonParseError::NoError) {
+        qCWarning(logGrandSearch) << "Failed to parse legacy access record:" << jsonError.errorString();
+        return false;
+    }
+
+    const QJsonObject searcherObj = doc.object();
+    for (auto searcherIt = searcherObj.constBegin(); searcherIt != searcherObj.constEnd(); ++searcherIt) {
+        if (!searcherIt.value().isObject())
+            continue;
+
+        const QJsonObject itemsObj = searcherIt.value().toObject();
+        for (auto itemIt = itemsObj.constBegin(); itemIt != itemsObj.constEnd(); ++itemIt) {
+            const QJsonArray timeArray = itemIt.value().toArray();
+            QVector<qint64> times;
+            times.reserve(timeArray.size());
+            for (const QJsonValue &value : timeArray) {
+                const qint64 time = qint64(value.toDouble());
+                if (time <= now)
+                    times.append(time);
+            }
+            std::sort(times.begin(), times.end());
+
+            FrecencyEntry entry;
+            for (qint64 time : times) {
+                entry.score = decayedScore(entry, time) + 1;
+                entry.lastAccess = time;
+            }
+
+            if (decayedScore(entry, now) >= MinScore)
+                m_entries[searcherIt.key()][itemIt.key()] = entry;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief FrecencyStore::flush 将新增的记录追加到日志文件
+ */
+bool FrecencyStore::flush(const QString &logPath)
+{
+    if (m_pendingLog.isEmpty())
+        return true;
+
+    QFile file(logPath);
+    if (!file.open(QFile::WriteOnly | QFile::Append)) {
+        qCWarning(logGrandSearch) << "Failed to open frecency log for appending:" << logPath << file.errorString();
+        return false;
+    }
+
+    QByteArray data;
+    if (file.size() == 0)
+        appendHeader(data);
+    data.append(m_pendingLog);
+
+    if (file.write(data) != data.size()) {
+        qCWarning(logGrandSearch) << "Failed to append frecency log:" << logPath << file.errorString();
+        return false;
+    }
+
+    m_logRecords += m_pendingRecords;
+    m_pendingRecords = 0;
+    m_pendingLog.clear();
+    return true;
+}
+
+/**
+ * @brief FrecencyStore::compact 丢弃已衰减的记录，并以每个类目一条记录重写日志
+ */
+bool FrecencyStore::compact(const QString &logPath, qint64 now)
+{
+    prune(now);
+
+    QByteArray data;
+    appendHeader(data);
+    int records = 0;
+    for (auto searcherIt = m_entries.constBegin(); searcherIt != m_entries.constEnd(); ++searcherIt) {
+        for (auto itemIt = searcherIt->constBegin(); itemIt != searcherIt->constEnd(); ++itemIt) {
+            appendRecord(data, searcherIt.key(), itemIt.key(), itemIt.value());
+            ++records;
+        }
+    }
+
+    QDir().mkpath(QFileInfo(logPath).absolutePath());
+    QSaveFile file(logPath);
+    if (!file.open(QFile::WriteOnly) || file.write(data) != data.size() || !file.commit()) {
+        qCWarning(logGrandSearch) << "Failed to compact frecency log:" << logPath << file.errorString();
+        return false;
+    }
+
+    qCDebug(logGrandSearch) << "Frecency log compacted - Records:" << m_logRecords + m_pendingRecords
+                            << "->" << records;
+    m_logRecords = records;
+    m_logDamaged = false;
+    m_pendingRecords = 0;
+    m_pendingLog.clear();
+    return true;
+}
+
+bool FrecencyStore::needsCompaction() const
+{
+    return m_logDamaged || m_logRecords + m_pendingRecords > 2 * count() + CompactSlack;
+}
+
+void FrecencyStore::prune(qint64 now)
+{
+    for (auto searcherIt = m_entries.begin(); searcherIt != m_entries.end();) {
+        for (auto itemIt = searcherIt->begin(); itemIt != searcherIt->end();) {
+            if (decayedScore(itemIt.value(), now) < MinScore)
+                itemIt = searcherIt->erase(itemIt);
+            else
+                ++itemIt;
+        }
+
+        if (searcherIt->isEmpty())
+            searcherIt = m_entries.erase(searcherIt);
+        else
+            ++searcherIt;
+    }
+}
+
+void FrecencyStore::appendRecord(QByteArray &buffer, const QString &searcher, const QString &item, const FrecencyEntry &entry)
+{
+    const QByteArray searcherData = searcher.toUtf8().left(std::numeric_limits<quint16>::max());
+    const QByteArray itemData = item.toUtf8().left(std::numeric_limits<quint16>::max());
+    const QByteArray strings = searcherData + itemData;
+
+    RecordHeader header;
+    header.searcherSize = quint16(searcherData.size());
+    header.itemSize = quint16(itemData.size());
+    header.lastAccess = entry.lastAccess;
+    header.score = entry.score;
+    header.checksum = recordChecksum(header, strings.constData());
+
+    buffer.append(reinterpret_cast<const char *>(&header), sizeof(header));
+    buffer.append(strings);
+}
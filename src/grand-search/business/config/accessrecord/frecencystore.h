@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef FRECENCYSTORE_H
+#define FRECENCYSTORE_H
+
+#include <QHash>
+#include <QString>
+#include <QByteArray>
+#include <QMetaType>
+
+namespace GrandSearch {
+
+// 单个类目的访问热度：按指数衰减的分值及其对应的时间
+struct FrecencyEntry
+{
+    double score = 0;       // lastAccess 时刻的分值
+    qint64 lastAccess = 0;  // 最近一次访问的时间戳（秒）
+};
+
+/**
+ * @brief 访问热度存储
+ * 每个 (searcher, item) 记录一个指数衰减的分值，每次访问在衰减后的分值上加一。
+ * 数据以追加写入的二进制日志保存，加载时通过 mmap 重放，无效记录过多时压缩重写。
+ */
+class FrecencyStore
+{
+public:
+    typedef QHash<QString, FrecencyEntry> ItemEntries;
+    typedef QHash<QString, ItemEntries> SearcherEntries;
+
+    // 分值的平均寿命，与原先点选记录的有效期一致
+    static const qint64 MeanLifetime = 7 * 24 * 60 * 60;
+
+    static double decayedScore(const FrecencyEntry &entry, qint64 now);
+
+    const FrecencyEntry *find(const QString &searcher, const QString &item) const;
+    double score(const QString &searcher, const QString &item, qint64 now) const;
+    const SearcherEntries &entries() const { return m_entries; }
+    int count() const;
+
+    void touch(const QString &searcher, const QString &item, qint64 time);
+
+    bool load(const QString &logPath, qint64 now);
+    bool importJson(const QString &jsonPath, qint64 now);
+    bool flush(const QString &logPath);
+    bool compact(const QString &logPath, qint64 now);
+    bool needsCompaction() const;
+
+private:
+    void prune(qint64 now);
+    static void appendRecord(QByteArray &buffer, const QString &searcher, const QString &item, const FrecencyEntry &entry);
+
+private:
+    SearcherEntries m_entries;
+    QByteArray m_pendingLog;    // 尚未写入日志文件的记录
+    int m_pendingRecords = 0;
+    int m_logRecords = 0;       // 日志文件中的记录数，用于判断是否需要压缩
+    bool m_logDamaged = false;  // 日志尾部存在不完整或校验失败的记录
+};
+
+}
+
+Q_DECLARE_METATYPE(GrandSearch::FrecencyStore)
+
+#endif // FRECENCYSTORE_H
@@ -12,12 +12,26 @@
 
 #include "interfaces/daemongrandsearchinterface.h"
 
+#include <QStandardPaths>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
 
 using namespace GrandSearch;
 
+// 参与最佳匹配的高权重搜索项，与 Utils::packageBestMatch 支持的搜索项一致
+static const QStringList kBestMatchSearchers {
+    GRANDSEARCH_CLASS_FILE_DEEPIN,
+    GRANDSEARCH_CLASS_FILE_FULLTEXT,
+    GRANDSEARCH_CLASS_APP_DESKTOP,
+    GRANDSEARCH_CLASS_SETTING_CONTROLCENTER,
+    GRANDSEARCH_CLASS_OCR_TEXT,
+    GRANDSEARCH_CLASS_FILE_SEMANTIC
+};
+
+// 每完成多少次任务保存一次延迟统计
+static constexpr int kLatencySaveInterval = 20;
+
 MatchControllerPrivate::MatchControllerPrivate(MatchController *parent)
     : q_p(parent)
 {
@@ -35,9 +49,18 @@ MatchControllerPrivate::MatchControllerPrivate(MatchController *parent)
                             << "First wait time:" << m_firstWaitTime
                             << "Best item max count:" << m_bestItemMaxCount;
 
+    m_latencyPath = defaultLatencyFilePath();
+    m_latency.load(m_latencyPath);
+
     initConnect();
 }
 
+MatchControllerPrivate::~MatchControllerPrivate()
+{
+    if (m_latency.isDirty())
+        m_latency.save(latencyFilePath());
+}
+
 void MatchControllerPrivate::initConnect()
 {
     connect(m_daemonDbus, &DaemonGrandSearchInterface::Matched, this, &MatchControllerPrivate::onMatched);
@@ -64,6 +87,7 @@ void MatchControllerPrivate::onMatched(const QString &missionId)
 
     MatchedItemMap items;
     stream >> items;
+    recordReported(items);
 
     // 首次收到数据
     if (m_missionIdChanged) {
@@ -73,8 +97,12 @@ void MatchControllerPrivate::onMatched(const QString &missionId)
         for (const MatchedItems &itemValues : items.values()) {
             count += itemValues.count();
         }
+
+        // 按各搜索项的历史延迟选择等待时间，统计不足时使用配置的固定等待时间
+        m_chosenWait = m_latency.chooseWait(kBestMatchSearchers, m_firstWaitTime, &m_expectedSearchers);
         qCDebug(logGrandSearch) << "First data reception - Items:" << count
-                                << "Limit:" << m_firstItemLimit;
+                                << "Limit:" << m_firstItemLimit
+                                << "Wait:" << m_chosenWait << "Expected searchers:" << m_expectedSearchers;
 
         // 总数不够时，将数据放入到缓存中，并开启延迟定时器
         if (count < m_firstItemLimit) {
@@ -83,11 +111,23 @@ void MatchControllerPrivate::onMatched(const QString &missionId)
             for (const QString &groupName : items.keys()) {
                 m_cacheItems[groupName].append(items.value(groupName));
             }
-            connect(m_waitTimer.get(), &QTimer::timeout, this, &MatchControllerPrivate::sendCacheItems);
-            m_waitTimer->start(m_firstWaitTime);
+
+            // 首批数据已包含全部预期的搜索项，立即发送
+            if (expectedReported()) {
+                recordRelease(QStringLiteral("sources"));
+                sendCacheItems();
+                return;
+            }
+
+            connect(m_waitTimer.get(), &QTimer::timeout, this, &MatchControllerPrivate::onWaitTimeout);
+
+            // 等待时间从任务开始计算，已过去的时间不再等待
+            const qint64 elapsed = m_missionTimer.isValid() ? m_missionTimer.elapsed() : 0;
+            m_waitTimer->start(static_cast<int>(qMax<qint64>(0, m_chosenWait - elapsed)));
 
             return;
         } else {
+            recordRelease(QStringLiteral("limit"));
             qCDebug(logGrandSearch) << "Processing initial items with best match:" << m_enableBestMatch;
             Utils::updateItemsWeight(items, m_missionContent);
             Utils::sortByWeight(items);
@@ -104,6 +144,13 @@ void MatchControllerPrivate::onMatched(const QString &missionId)
             m_cacheItems[groupName].append(items.value(groupName));
         }
 
+        // 预期的高权重搜索项均已上报，无须等到超时
+        if (expectedReported()) {
+            m_waitTimer->stop();
+            recordRelease(QStringLiteral("sources"));
+            sendCacheItems();
+        }
+
         return;
     }
 
@@ -119,8 +166,16 @@ void MatchControllerPrivate::onSearchCompleted(const QString &missionId)
         return;
 
     qCDebug(logGrandSearch) << "Search completed for mission:" << missionId;
+    if (m_waitTimer && m_waitTimer->isActive()) {
+        m_waitTimer->stop();
+        recordRelease(QStringLiteral("completed"));
+    }
     sendCacheItems();
 
+    commitReported();
+    if (++m_finishedMissions % kLatencySaveInterval == 0 && m_latency.isDirty())
+        m_latency.save(latencyFilePath());
+
     // 通知界面刷新，若界面有数据不做处理，否则就刷新
     emit q_p->searchCompleted();
 }
@@ -138,6 +193,72 @@ void MatchControllerPrivate::sendCacheItems()
     m_cacheItems.clear();
 }
 
+void MatchControllerPrivate::onWaitTimeout()
+{
+    recordRelease(QStringLiteral("timeout"));
+    sendCacheItems();
+}
+
+void MatchControllerPrivate::recordReported(const MatchedItemMap &items)
+{
+    const qint64 elapsed = m_missionTimer.isValid() ? m_missionTimer.elapsed() : -1;
+    for (const MatchedItems &list : items) {
+        for (const MatchedItem &item : list) {
+            if (item.searcher.isEmpty() || m_reportedSearchers.contains(item.searcher))
+                continue;
+
+            m_reportedSearchers.insert(item.searcher);
+            m_pendingSamples.insert(item.searcher, elapsed);
+        }
+    }
+}
+
+void MatchControllerPrivate::commitReported()
+{
+    // 仅完整结束的任务计入统计。中途切换的任务只记录到了较快的搜索项，
+    // 计入后会使慢速搜索项的分位延迟偏低，也无法区分未上报与未完成
+    for (auto it = m_pendingSamples.cbegin(); it != m_pendingSamples.cend(); ++it)
+        m_latency.addSample(it.key(), it.value());
+
+    m_latency.finishMission(m_reportedSearchers);
+    m_pendingSamples.clear();
+}
+
+bool MatchControllerPrivate::expectedReported() const
+{
+    if (m_expectedSearchers.isEmpty())
+        return false;
+
+    for (const QString &searcher : m_expectedSearchers) {
+        if (!m_reportedSearchers.contains(searcher))
+            return false;
+    }
+    return true;
+}
+
+void MatchControllerPrivate::recordRelease(const QString &reason)
+{
+    if (m_chosenWait < 0)
+        return;
+
+    const qint64 elapsed = m_missionTimer.isValid() ? m_missionTimer.elapsed() : -1;
+    qCInfo(logGrandSearch) << "First batch released - Reason:" << reason << "Wait:" << m_chosenWait
+                           << "Elapsed:" << elapsed << "ms" << "Expected searchers:" << m_expectedSearchers.size();
+    m_latency.addDecision(m_chosenWait, elapsed, reason);
+    m_chosenWait = -1;
+}
+
+QString MatchControllerPrivate::latencyFilePath() const
+{
+    return m_latencyPath;
+}
+
+QString MatchControllerPrivate::defaultLatencyFilePath()
+{
+    return QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).value(0)
+            + "/deepin/" GRANDSEARCH_NAME "/searcherlatency.json";
+}
+
 MatchController::MatchController(QObject *parent)
     : QObject(parent), d_p(new MatchControllerPrivate(this))
 {
@@ -161,6 +282,11 @@ void MatchController::onMissionChanged(const QString &missionId, const QString &
     d_p->m_missionContent = missionContent;
     d_p->m_missionIdChanged = true;
     d_p->m_cacheItems.clear();
+    d_p->m_missionTimer.start();
+    d_p->m_reportedSearchers.clear();
+    d_p->m_pendingSamples.clear();
+    d_p->m_expectedSearchers.clear();
+    d_p->m_chosenWait = -1;
     if (d_p->m_waitTimer.get()) {
         d_p->m_waitTimer->disconnect();
     }
@@ -6,8 +6,10 @@
 #define MATCHCONTROLLER_P_H
 
 #include "matchcontroller.h"
+#include "searcherlatency.h"
 
 #include <QAtomicInteger>
+#include <QElapsedTimer>
 
 namespace GrandSearch {
 
@@ -17,15 +19,28 @@ class MatchControllerPrivate : public QObject
     Q_OBJECT
 public:
     explicit MatchControllerPrivate(MatchController *parent = nullptr);
+    ~MatchControllerPrivate() override;
 
 public slots:
     void onMatched(const QString &missionId);
     void onSearchCompleted(const QString &missionId);
     void sendCacheItems();
+    void onWaitTimeout();
 
 public:
     void initConnect();
 
+    // 记录本次任务中各搜索项首次上报结果的延迟，任务完成时才计入统计
+    void recordReported(const MatchedItemMap &items);
+    // 任务完成，将本次任务的延迟计入统计
+    void commitReported();
+    // 预期会上报结果的高权重搜索项是否均已上报
+    bool expectedReported() const;
+    // 记录首批结果的发送时机，每个任务仅记录一次
+    void recordRelease(const QString &reason);
+    QString latencyFilePath() const;
+    static QString defaultLatencyFilePath();
+
 public:
     MatchController *q_p = nullptr;
 
@@ -40,6 +55,15 @@ public:
     int m_bestItemMaxCount = 4;
     QSharedPointer<QTimer> m_waitTimer = nullptr;
 
+    SearcherLatency m_latency;               // 各搜索项的上报延迟统计
+    QElapsedTimer m_missionTimer;            // 当前任务开始的时间
+    QSet<QString> m_reportedSearchers;       // 当前任务中已上报结果的搜索项
+    QHash<QString, qint64> m_pendingSamples; // 当前任务中各搜索项的首次上报延迟，任务完成前不计入统计
+    QString m_latencyPath;                   // 延迟统计文件路径
+    QStringList m_expectedSearchers;         // 首批结果预期等待的搜索项
+    int m_chosenWait = -1;                   // 当前任务首批结果的等待时间，-1 表示已发送或尚未选择
+    int m_finishedMissions = 0;              // 完成的任务数，用于定期保存统计
+
     DaemonGrandSearchInterface *m_daemonDbus = nullptr;
 };
 
@@ -0,0 +1,236 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "searcherlatency.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+using namespace GrandSearch;
+
+// 延迟区间的上界（毫秒），超出最后一个上界的样本计入溢出区间
+static const QVector<int> kBucketBounds { 25, 50, 75, 100, 150, 200, 300, 400, 500, 700, 1000, 1500, 2000 };
+// 每完成一次任务旧样本保留的比例，约以最近 20 次任务为准
+static constexpr double kDecay = 0.95;
+// 计算分位数所需的最少样本数
+static constexpr double kMinSamples = 3;
+// 上报比例不低于该值的搜索项视为预期会上报结果
+static constexpr double kExpectedReportRate = 0.5;
+// 在分位延迟之上额外等待的时间，吸收事件循环的调度延迟
+static constexpr int kWaitMargin = 20;
+// 导出的最近发送记录数
+static constexpr int kMaxDecisions = 50;
+// 统计文件格式版本
+static constexpr int kVersion = 1;
+
+void SearcherLatency::addSample(const QString &searcher, qint64 latency)
+{
+    if (searcher.isEmpty() || latency < 0)
+        return;
+
+    Histogram &histogram = m_histograms[searcher];
+    if (histogram.counts.size() != kBucketBounds.size() + 1)
+        histogram.counts.fill(0, kBucketBounds.size() + 1);
+
+    int bucket = 0;
+    while (bucket < kBucketBounds.size() && latency > kBucketBounds.at(bucket))
+        ++bucket;
+
+    histogram.counts[bucket] += 1;
+    m_dirty = true;
+}
+
+void SearcherLatency::finishMission(const QSet<QString> &reported)
+{
+    if (m_histograms.isEmpty())
+        return;
+
+    for (auto it = m_histograms.begin(); it != m_histograms.end(); ++it) {
+        Histogram &histogram = it.value();
+        for (double &count : histogram.counts)
+            count *= kDecay;
+
+        histogram.missions = histogram.missions * kDecay + 1;
+        histogram.reported = histogram.reported * kDecay + (reported.contains(it.key()) ? 1 : 0);
+    }
+
+    m_dirty = true;
+}
+
+int SearcherLatency::quantile(const QString &searcher, double q) const
+{
+    auto it = m_histograms.constFind(searcher);
+    if (it == m_histograms.constEnd())
+        return -1;
+
+    const double sum = total(it.value());
+    if (sum < kMinSamples)
+        return -1;
+
+    // 取累计样本数达到分位的区间上界，溢出区间按最后上界的两倍计
+    const QVector<double> &counts = it.value().counts;
+    double cumulative = 0;
+    for (int i = 0; i < counts.size(); ++i) {
+        cumulative += counts.at(i);
+        if (cumulative >= sum * q)
+            return i < kBucketBounds.size() ? kBucketBounds.at(i) : kBucketBounds.last() * 2;
+    }
+
+    return kBucketBounds.last() * 2;
+}
+
+double SearcherLatency::reportRate(const QString &searcher) const
+{
+    auto it = m_histograms.constFind(searcher);
+    if (it == m_histograms.constEnd() || it.value().missions <= 0)
+        return 0;
+
+    return it.value().reported / it.value().missions;
+}
+
+int SearcherLatency::chooseWait(const QStringList &candidates, int maxWait, QStringList *expected) const
+{
+    int wait = -1;
+    QStringList sources;
+    for (const QString &searcher : candidates) {
+        // 未启用或很少有结果的搜索项不参与等待，否则每次都要等到超时
+        if (reportRate(searcher) < kExpectedReportRate)
+            continue;
+
+        const int latency = quantile(searcher, 0.9);
+        if (latency < 0)
+            continue;
+
+        sources << searcher;
+        wait = qMax(wait, latency + kWaitMargin);
+    }
+
+    if (expected)
+        *expected = sources;
+
+    if (sources.isEmpty())
+        return maxWait;
+
+    return qBound(0, wait, maxWait);
+}
+
+void SearcherLatency::addDecision(int chosenWait, qint64 released, const QString &reason)
+{
+    Decision decision;
+    decision.time = QDateTime::currentMSecsSinceEpoch();
+    decision.chosenWait = chosenWait;
+    decision.released = released;
+    decision.reason = reason;
+
+    m_decisions.append(decision);
+    while (m_decisions.size() > kMaxDecisions)
+        m_decisions.removeFirst();
+
+    m_dirty = true;
+}
+
+bool SearcherLatency::load(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    const QJsonObject root = QJsonDocument::fromJson(file.readAll()).object();
+    if (root.value("version").toInt() != kVersion)
+        return false;
+
+    // 区间划分变化后旧样本无法对应，丢弃
+    QVector<int> bounds;
+    for (const QJsonValue &bound : root.value("bounds").toArray())
+        bounds << bound.toInt();
+    if (bounds != kBucketBounds)
+        return false;
+
+    m_histograms.clear();
+    const QJsonObject searchers = root.value("searchers").toObject();
+    for (auto it = searchers.constBegin(); it != searchers.constEnd(); ++it) {
+        const QJsonObject obj = it.value().toObject();
+        const QJsonArray counts = obj.value("counts").toArray();
+        if (counts.size() != kBucketBounds.size() + 1)
+            continue;
+
+        Histogram histogram;
+        for (const QJsonValue &count : counts)
+            histogram.counts << count.toDouble();
+        histogram.missions = obj.value("missions").toDouble();
+        histogram.reported = obj.value("reported").toDouble();
+        m_histograms.insert(it.key(), histogram);
+    }
+
+    m_dirty = false;
+    return true;
+}
+
+bool SearcherLatency::save(const QString &path)
+{
+    if (!QDir().mkpath(QFileInfo(path).absolutePath()))
+        return false;
+
+    QJsonArray bounds;
+    for (int bound : kBucketBounds)
+        bounds.append(bound);
+
+    // 分位数与上报比例仅供查看，加载时按直方图重新计算
+    QJsonObject searchers;
+    for (auto it = m_histograms.constBegin(); it != m_histograms.constEnd(); ++it) {
+        QJsonArray counts;
+        for (double count : it.value().counts)
+            counts.append(count);
+
+        QJsonObject obj;
+        obj.insert("counts", counts);
+        obj.insert("missions", it.value().missions);
+        obj.insert("reported", it.value().reported);
+        obj.insert("p50", quantile(it.key(), 0.5));
+        obj.insert("p90", quantile(it.key(), 0.9));
+        obj.insert("reportRate", reportRate(it.key()));
+        searchers.insert(it.key(), obj);
+    }
+
+    QJsonArray decisions;
+    for (const Decision &decision : m_decisions) {
+        QJsonObject obj;
+        obj.insert("time", decision.time);
+        obj.insert("wait", decision.chosenWait);
+        obj.insert("released", decision.released);
+        obj.insert("reason", decision.reason);
+        decisions.append(obj);
+    }
+
+    QJsonObject root;
+    root.insert("version", kVersion);
+    root.insert("bounds", bounds);
+    root.insert("searchers", searchers);
+    root.insert("decisions", decisions);
+
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    file.write(QJsonDocument(root).toJson(QJsonDocument::Indented));
+    if (!file.commit())
+        return false;
+
+    m_dirty = false;
+    return true;
+}
+
+double SearcherLatency::total(const Histogram &histogram)
+{
+    double sum = 0;
+    for (double count : histogram.counts)
+        sum += count;
+    return sum;
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef SEARCHERLATENCY_H
+#define SEARCHERLATENCY_H
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+namespace GrandSearch {
+
+/**
+ * @brief 各搜索项首次上报结果的延迟统计
+ *
+ * 按搜索项记录从任务开始到首次上报结果的延迟直方图，以及完成的任务中实际上报结果的比例。
+ * 每完成一次任务，旧样本按固定比例衰减，以跟随机器负载和索引状态的变化。
+ * 首批结果据此选择等待时间：等待预期会上报结果的高权重搜索项的 90% 分位延迟。
+ */
+class SearcherLatency
+{
+public:
+    // 记录搜索项在本次任务中首次上报结果的延迟（毫秒）
+    void addSample(const QString &searcher, qint64 latency);
+    // 任务完成，reported 为本次任务中上报过结果的搜索项
+    void finishMission(const QSet<QString> &reported);
+
+    // 搜索项延迟的分位数（毫秒），样本不足时返回 -1
+    int quantile(const QString &searcher, double q) const;
+    // 搜索项在完成的任务中上报结果的比例
+    double reportRate(const QString &searcher) const;
+
+    /**
+     * @brief 选择首批结果的等待时间
+     * @param candidates 参与最佳匹配的高权重搜索项
+     * @param maxWait 等待上限，即配置的固定等待时间
+     * @param expected 输出预期会上报结果的搜索项，为空表示统计不足
+     * @return 等待时间（毫秒），统计不足时返回 maxWait
+     */
+    int chooseWait(const QStringList &candidates, int maxWait, QStringList *expected = nullptr) const;
+
+    // 记录一次首批结果的发送时机，随统计一同导出，用于调整等待参数
+    void addDecision(int chosenWait, qint64 released, const QString &reason);
+
+    bool load(const QString &path);
+    bool save(const QString &path);
+    bool isDirty() const { return m_dirty; }
+
+private:
+    struct Histogram
+    {
+        QVector<double> counts;   // 各延迟区间的样本数，含衰减
+        double missions = 0;      // 完成的任务数，含衰减
+        double reported = 0;      // 其中上报过结果的任务数，含衰减
+    };
+
+    struct Decision
+    {
+        qint64 time = 0;          // 发送时刻（毫秒时间戳）
+        int chosenWait = 0;       // 选择的等待时间
+        qint64 released = 0;      // 实际发送时距任务开始的时间
+        QString reason;           // 发送原因
+    };
+
+    static double total(const Histogram &histogram);
+
+    QHash<QString, Histogram> m_histograms;
+    QList<Decision> m_decisions;
+    bool m_dirty = false;
+};
+
+}
+
+#endif // SEARCHERLATENCY_H
@@ -18,6 +18,13 @@ using namespace GrandSearch;
 
 static const uint KeepAliveTime = 15000;   // 搜索过程中，调用后端心跳函数间隔时间
 
+static constexpr int kTypingBurstGap = 1000;     // 按键间隔超过该值（毫秒）视为重新开始输入
+static constexpr double kSmoothingFactor = 0.3;  // 按键间隔及后端延迟的指数平均权重
+static constexpr double kPauseFactor = 1.5;      // 超过平均按键间隔的该倍数仍无输入，视为输入停顿
+static constexpr int kMaxTypingDelay = 300;      // 等待输入停顿的最长时间（毫秒）
+static constexpr int kShortTextDelay = 150;      // 两字节及以下文本的防抖延迟（毫秒），此类搜索结果多、开销大
+static constexpr int kDotTextDelay = 500;        // 单独输入“.”时额外的防抖延迟（毫秒）
+
 QueryControllerPrivate::QueryControllerPrivate(QueryController *parent)
     : q_p(parent)
 {
@@ -39,6 +46,8 @@ QueryControllerPrivate::QueryControllerPrivate(QueryController *parent)
 
     connect(m_keepAliveTimer, &QTimer::timeout, this, &QueryControllerPrivate::keepAlive);
     connect(m_debounceTimer, &QTimer::timeout, this, &QueryControllerPrivate::performSearch);
+    connect(m_daemonDbus, &DaemonGrandSearchInterface::Matched, this, &QueryControllerPrivate::onMatched);
+    connect(m_daemonDbus, &DaemonGrandSearchInterface::SearchCompleted, this, &QueryControllerPrivate::onSearchCompleted);
 
     qCInfo(logGrandSearch) << "QueryController initialized successfully";
 }
@@ -54,7 +63,68 @@ void QueryControllerPrivate::onSearchCompleted(const QString &missionId)
     if (missionId == m_missionId) {
         m_keepAliveTimer->stop();
         qCInfo(logGrandSearch) << "Search completed for mission:" << m_missionId;
+
+        // 没有结果的搜索以完成时间作为响应延迟
+        recordDaemonLatency();
+        m_searching = false;
+    }
+}
+
+void QueryControllerPrivate::onMatched(const QString &missionId)
+{
+    if (missionId == m_missionId)
+        recordDaemonLatency();
+}
+
+void QueryControllerPrivate::recordKeystroke()
+{
+    // 仅统计连续输入中的按键间隔，停顿后的首次按键不计入
+    const qint64 interval = m_keyTimer.isValid() ? m_keyTimer.restart() : -1;
+    if (!m_keyTimer.isValid())
+        m_keyTimer.start();
+
+    m_typing = interval >= 0 && interval < kTypingBurstGap;
+    if (!m_typing)
+        return;
+
+    m_keyInterval = m_keyInterval < 0 ? interval
+                                      : m_keyInterval * (1 - kSmoothingFactor) + interval * kSmoothingFactor;
+}
+
+void QueryControllerPrivate::recordDaemonLatency(bool responded)
+{
+    if (!m_waitingResponse)
+        return;
+
+    m_waitingResponse = false;
+    const qint64 latency = m_searchTimer.elapsed();
+
+    // 未响应即被替换的搜索，已过去的时间只是响应延迟的下界，仅在超过平均延迟时计入，
+    // 否则后端变慢时每次搜索都在响应前被中止，平均延迟将一直得不到更新
+    if (!responded && (m_daemonLatency < 0 || latency <= m_daemonLatency))
+        return;
+
+    m_daemonLatency = m_daemonLatency < 0 ? latency
+                                          : m_daemonLatency * (1 - kSmoothingFactor) + latency * kSmoothingFactor;
+    qCDebug(logGrandSearch) << "Daemon response - Mission:" << m_missionId << "Responded:" << responded
+                            << "Latency:" << latency << "ms" << "Average:" << qRound(m_daemonLatency) << "ms";
+}
+
+int QueryControllerPrivate::debounceDelay(const QString &text, qint64 keyInterval, qint64 daemonLatency)
+{
+    int delay = 0;
+    if (text.toUtf8().length() <= 2) {
+        delay = kShortTextDelay;
+        if (text == ".")
+            delay += kDotTextDelay;
     }
+
+    // 连续输入中：结果能在下一次按键前返回时立即搜索；
+    // 否则等到输入停顿再搜索，避免发出的搜索被下一次按键中止
+    if (keyInterval > 0 && (daemonLatency < 0 || daemonLatency > keyInterval))
+        delay = qMax(delay, qMin(qRound(keyInterval * kPauseFactor), kMaxTypingDelay));
+
+    return delay;
 }
 
 void QueryControllerPrivate::performSearch()
@@ -67,6 +137,13 @@ void QueryControllerPrivate::performSearch()
     m_searchText = m_pendingSearchText;
     m_pendingSearchText.clear();
 
+    ++m_dispatchedCount;
+    if (m_searching)
+        ++m_abortedCount;
+
+    // 上一次搜索尚未响应即被替换
+    recordDaemonLatency(false);
+
     // 搜索文本改变，创建新的会话ID
     m_missionId = QUuid::createUuid().toString(QUuid::WithoutBraces);
     emit q_p->missionChanged(m_missionId, m_searchText);
@@ -78,9 +155,15 @@ void QueryControllerPrivate::performSearch()
                             << "Started:" << started;
 
     if (started) {
-        qCDebug(logGrandSearch) << "Starting keep-alive timer for mission:" << m_missionId;
+        qCDebug(logGrandSearch) << "Starting keep-alive timer for mission:" << m_missionId
+                                << "Dispatched:" << m_dispatchedCount << "Aborted:" << m_abortedCount;
         m_keepAliveTimer->start();
+        m_searchTimer.start();
+        m_waitingResponse = true;
+        m_searching = true;
     } else {
+        m_waitingResponse = false;
+        m_searching = false;
         qCWarning(logGrandSearch) << "Search failed to start - Mission:" << m_missionId;
     }
 }
@@ -104,6 +187,7 @@ void QueryController::onSearchTextChanged(const QString &txt)
 
     // 停止已有的定时器
     d_p->m_debounceTimer->stop();
+    d_p->recordKeystroke();
     if (normalizedText.isEmpty()) {
         // 停止搜索相关的所有活动
         onTerminateSearch();
@@ -126,22 +210,14 @@ void QueryController::onSearchTextChanged(const QString &txt)
     // 存储待处理的搜索文本
     d_p->m_pendingSearchText = normalizedText;
 
-    // 设置防抖延迟，根据文本字节长度动态调整
-    int debounceDelay = 0;
-    QByteArray bytes = normalizedText.toUtf8();
-    int byteLength = bytes.length();
-
-    if (byteLength <= 2) {
-        debounceDelay += 150;
-
-        if (txt == ".")
-            debounceDelay += 500;
-    } else if (byteLength > 3) {
-        debounceDelay = 0;
-    }
+    // 设置防抖延迟，根据文本长度、输入节奏及后端响应延迟动态调整
+    const qint64 keyInterval = d_p->m_typing ? qRound64(d_p->m_keyInterval) : -1;
+    const qint64 daemonLatency = d_p->m_daemonLatency < 0 ? -1 : qRound64(d_p->m_daemonLatency);
+    const int debounceDelay = QueryControllerPrivate::debounceDelay(normalizedText, keyInterval, daemonLatency);
 
     qCDebug(logGrandSearch) << "Setting debounce delay - Text:" << normalizedText
-                            << "Length:" << byteLength
+                            << "Key interval:" << keyInterval
+                            << "Daemon latency:" << daemonLatency
                             << "Delay:" << debounceDelay;
     d_p->m_debounceTimer->setInterval(debounceDelay);
     d_p->m_debounceTimer->start();
@@ -156,6 +232,8 @@ void QueryController::onTerminateSearch()
 
     qCDebug(logGrandSearch) << "Terminating search - Mission:" << d_p->m_missionId;
     d_p->m_daemonDbus->Terminate();
+    d_p->m_waitingResponse = false;
+    d_p->m_searching = false;
     qCDebug(logGrandSearch) << "Search termination completed - Mission:" << d_p->m_missionId;
 }
 
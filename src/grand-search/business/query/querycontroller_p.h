@@ -9,6 +9,7 @@
 
 #include <QObject>
 #include <QTimer>
+#include <QElapsedTimer>
 
 namespace GrandSearch {
 
@@ -26,8 +27,26 @@ public slots:
     // 接收后端搜索完成信号，停止心跳发送
     void onSearchCompleted(const QString &missionId);
 
+    // 接收后端首次上报结果信号，统计后端响应延迟
+    void onMatched(const QString &missionId);
+
     void performSearch();
 
+public:
+    // 记录一次按键，更新输入连续按键的平均间隔
+    void recordKeystroke();
+    // 记录当前任务从发起搜索到后端首次响应的延迟，responded 为 false 表示搜索未响应即被替换
+    void recordDaemonLatency(bool responded = true);
+
+    /**
+     * @brief 计算搜索防抖延迟
+     * @param text 搜索文本
+     * @param keyInterval 当前处于连续输入时的平均按键间隔（毫秒），否则为 -1
+     * @param daemonLatency 后端近期的平均响应延迟（毫秒），尚无统计时为 -1
+     * @return 防抖延迟（毫秒）
+     */
+    static int debounceDelay(const QString &text, qint64 keyInterval, qint64 daemonLatency);
+
 public:
     QueryController *q_p = nullptr;
     QString m_missionId;
@@ -36,6 +55,16 @@ public:
     QTimer *m_keepAliveTimer = nullptr;
     QTimer *m_debounceTimer = nullptr;   // 防抖定时器
 
+    QElapsedTimer m_keyTimer;            // 距上次按键的时间
+    double m_keyInterval = -1;           // 连续输入时的平均按键间隔，-1 表示尚无统计
+    bool m_typing = false;               // 本次按键是否处于连续输入中
+    QElapsedTimer m_searchTimer;         // 距发起当前搜索的时间
+    double m_daemonLatency = -1;         // 后端近期的平均响应延迟，-1 表示尚无统计
+    bool m_waitingResponse = false;      // 当前搜索尚未收到后端响应
+    bool m_searching = false;            // 当前搜索尚未完成
+    int m_dispatchedCount = 0;           // 发起的搜索数
+    int m_abortedCount = 0;              // 未完成即被新搜索替换的搜索数
+
     DaemonGrandSearchInterface *m_daemonDbus = nullptr;
 };
 
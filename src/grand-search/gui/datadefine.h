@@ -47,6 +47,7 @@ struct PreviewPluginInfo {
     QPluginLoader* pPlugin;     // 预览插件实例对象
     bool bValid;                // 插件是否有效
     QString version;            // 插件适配版本号
+    qint64 loadTime;            // 插件库加载耗时(ms)，未加载时为-1
 
     PreviewPluginInfo() {
         reset();
@@ -59,6 +60,7 @@ struct PreviewPluginInfo {
         pPlugin = nullptr;
         bValid = false;
         version = "";
+        loadTime = -1;
     }
 };
 
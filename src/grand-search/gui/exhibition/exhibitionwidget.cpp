@@ -7,6 +7,8 @@
 #include "matchresult/matchwidget.h"
 #include "preview/previewwidget.h"
 #include "utils/utils.h"
+#include "utils/mimetyperesolver.h"
+#include "gui/datadefine.h"
 
 #include <DFrame>
 
@@ -48,6 +50,8 @@ void ExhibitionWidget::clearData()
 
     qCDebug(logGrandSearch) << "Clearing exhibition data";
     m_matchWidget->clearMatchedData();
+    m_previewWidget->cancelPrefetch();
+    m_previewWidget->cancelPreview();
     m_previewWidget->hide();
     m_vLine->hide();
 }
@@ -100,6 +104,25 @@ void ExhibitionWidget::appendMatchedData(const MatchedItemMap &matchedData)
 {
     qCDebug(logGrandSearch) << "Appending matched data - Groups:" << matchedData.size();
     m_matchWidget->appendMatchedData(matchedData);
+
+    // 结果变化后相邻项可能改变，放弃之前的预取
+    m_previewWidget->cancelPrefetch();
+
+    // 优先预加载预览当前显示结果所需的插件
+    QStringList mimeTypes;
+    for (auto it = matchedData.constBegin(); it != matchedData.constEnd(); ++it) {
+        if (!Utils::canPreview(it.key()))
+            continue;
+
+        const MatchedItems &items = it.value();
+        const int count = qMin(items.size(), GROUP_MAX_SHOW);
+        for (int i = 0; i < count; ++i) {
+            const QString type = MimeTypeResolver::instance()->mimeType(items.at(i).item, items.at(i).type);
+            if (!type.isEmpty() && !mimeTypes.contains(type))
+                mimeTypes << type;
+        }
+    }
+    m_previewWidget->preloadPlugins(mimeTypes);
 }
 
 void ExhibitionWidget::onSearchCompleted()
@@ -116,6 +139,7 @@ void ExhibitionWidget::previewItem(const QString &searchGroupName, const Matched
     // 搜索类型为空，或web搜索、应用、设置等，不显示预览
     if (!Utils::canPreview(searchGroupName) || item.name.isEmpty()) {
         qCDebug(logGrandSearch) << "Hiding preview - Group:" << searchGroupName;
+        m_previewWidget->cancelPreview();
         m_previewWidget->hide();
         m_vLine->hide();
 
@@ -133,8 +157,8 @@ void ExhibitionWidget::previewItem(const QString &searchGroupName, const Matched
     // 显示预览界面，主界面右侧需要与左侧间隙相同
     m_hLayout->setContentsMargins(MARGIN_SIZE, 0, MARGIN_SIZE, MARGIN_SIZE);
 
-    // 预览界面预览选择的匹配结果项
-    m_previewWidget->previewItem(item);
+    // 预览界面预览选择的匹配结果项，快速切换时按帧合并
+    m_previewWidget->requestPreview(item);
     m_vLine->show();
 
     emit sigPreviewStateChanged(true);
@@ -174,6 +198,7 @@ void ExhibitionWidget::initConnect()
     connect(m_matchWidget, &MatchWidget::sigShowNoContent, this, &ExhibitionWidget::sigShowNoContent);
     connect(m_matchWidget, &MatchWidget::sigCloseWindow, this, &ExhibitionWidget::sigCloseWindow);
     connect(m_matchWidget, &MatchWidget::sigCurrentItemChanged, this, &ExhibitionWidget::previewItem);
+    connect(m_matchWidget, &MatchWidget::sigPrefetchItems, m_previewWidget, &PreviewWidget::prefetchItems);
 
     connect(this, &ExhibitionWidget::sigPreviewStateChanged, m_matchWidget, &MatchWidget::onPreviewStateChanged);
 }
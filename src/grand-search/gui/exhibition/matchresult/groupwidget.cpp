@@ -96,26 +96,44 @@ void GroupWidget::appendMatchedItems(const MatchedItems &newItems, const QString
         // 当前组没有数据，则需要判断本次数据是否包含权重
         if (0 == m_listView->rowCount()) {
             const MatchedItem &item = dedupedItems.first();
-            if (!item.extra.isNull()
-                && item.extra.type() == QVariant::Hash
-                && item.extra.toHash().keys().contains(GRANDSEARCH_PROPERTY_ITEM_WEIGHT)) {
+            if (item.hasWeight) {
                 // 已经排序过，直接显示
                 m_cacheWeightItems << dedupedItems;
                 updateShowItems(m_cacheWeightItems);
 
+                indexItems(FirstFiveList);
+                indexItems(CacheWeightList);
                 return;
             }
         }
 
-        // 对未展开的数据排序
+        const int from = m_cacheItems.size();
         m_cacheItems << dedupedItems;
-        Utils::sortByWeight(m_cacheItems);
-        updateShowItems(m_cacheItems);
+
+        if (GROUP_MAX_SHOW != m_listView->rowCount()) {
+            // 显示不足时需要从排序后的缓存中补足
+            Utils::sortByWeight(m_cacheItems);
+            m_cacheItemsSorted = true;
+            updateShowItems(m_cacheItems);
+
+            indexItems(FirstFiveList);
+            indexItems(CacheList);
+        } else {
+            // 显示已满，缓存在展开时才排序，这里只记录新增项
+            m_cacheItemsSorted = false;
+            updateShowItems(m_cacheItems);
+
+            indexItems(CacheList, from);
+        }
     } else {
         // 结果列表已展开，已经显示的数据保持不变，仅对新增数据排序，然后追加到列表末尾
         MatchedItems &tempNewItems = const_cast<MatchedItems &>(dedupedItems);
         Utils::sortByWeight(tempNewItems);
         m_listView->addRows(tempNewItems);
+
+        const int from = m_restShowItems.size();
+        m_restShowItems << tempNewItems;
+        indexItems(RestShowList, from);
     }
 }
 
@@ -229,6 +247,8 @@ void GroupWidget::clear()
     m_restShowItems.clear();
     m_cacheWeightItems.clear();
     m_cacheItems.clear();
+    m_cacheItemsSorted = true;
+    m_pathIndex.clear();
 
     m_bListExpanded = false;
 
@@ -422,12 +442,6 @@ void GroupWidget::deduplicateByPath(MatchedItems &newItems)
     MatchedItems filtered;
     QSet<QString> seenInBatch;
 
-    auto weightOf = [](const MatchedItem &item) {
-        return item.extra.toHash()
-                .value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0)
-                .toDouble();
-    };
-
     for (const auto &newItem : newItems) {
         const QString &path = newItem.item;
         if (path.isEmpty())
@@ -437,11 +451,9 @@ void GroupWidget::deduplicateByPath(MatchedItems &newItems)
             continue;
         seenInBatch.insert(path);
 
-        const double newWeight = weightOf(newItem);
-
-        MatchedItem existing = findItemByPath(path);
-        if (!existing.item.isEmpty()) {
-            if (newWeight <= weightOf(existing))
+        double existingWeight = 0;
+        if (containsPath(path, &existingWeight)) {
+            if (itemWeight(newItem) <= existingWeight)
                 continue;
             updateItemByPath(path, newItem);
         } else {
@@ -478,8 +490,15 @@ void GroupWidget::onMoreBtnClicked()
     Q_ASSERT(m_viewMoreButton);
 
     // 将缓存中的数据转移到剩余显示结果中
+    if (!m_cacheItemsSorted) {
+        Utils::sortByWeight(m_cacheItems);
+        m_cacheItemsSorted = true;
+    }
+
+    const int from = m_restShowItems.size();
     m_restShowItems << m_cacheWeightItems;
     m_restShowItems << m_cacheItems;
+    indexItems(RestShowList, from);
 
     // 剩余显示结果追加显示到列表中
     m_listView->addRows(m_restShowItems);
@@ -509,52 +528,76 @@ void GroupWidget::onMoreBtnClicked()
 
 MatchedItem GroupWidget::findItemByPath(const QString &path) const
 {
-    auto findIn = [&](const MatchedItems &items) -> MatchedItem {
-        for (const auto &item : items) {
-            if (item.item == path)
-                return item;
-        }
+    auto it = m_pathIndex.constFind(path);
+    if (it == m_pathIndex.constEnd())
         return {};
-    };
 
-    MatchedItem found = findIn(m_firstFiveItems);
-    if (!found.item.isEmpty()) return found;
-
-    found = findIn(m_restShowItems);
-    if (!found.item.isEmpty()) return found;
+    return itemList(it->list).value(it->position);
+}
 
-    found = findIn(m_cacheItems);
-    if (!found.item.isEmpty()) return found;
+bool GroupWidget::containsPath(const QString &path, double *weight) const
+{
+    auto it = m_pathIndex.constFind(path);
+    if (it == m_pathIndex.constEnd())
+        return false;
 
-    return findIn(m_cacheWeightItems);
+    if (weight)
+        *weight = it->weight;
+    return true;
 }
 
 bool GroupWidget::updateItemByPath(const QString &path, const MatchedItem &newItem)
 {
-    auto doUpdate = [&](MatchedItems &items) -> bool {
-        for (int i = 0; i < items.size(); ++i) {
-            if (items[i].item == path) {
-                items[i] = newItem;
-                return true;
-            }
-        }
+    auto it = m_pathIndex.find(path);
+    if (it == m_pathIndex.end())
         return false;
-    };
 
-    bool updated = false;
-    updated |= doUpdate(m_firstFiveItems);
-    updated |= doUpdate(m_restShowItems);
-    updated |= doUpdate(m_cacheItems);
-    updated |= doUpdate(m_cacheWeightItems);
+    MatchedItems &items = itemList(it->list);
+    if (it->position < 0 || it->position >= items.size() || items.at(it->position).item != path)
+        return false;
 
-    if (updated) {
-        if (m_bListExpanded) {
-            MatchedItems all = m_firstFiveItems + m_restShowItems;
-            m_listView->setMatchedItems(all);
-        } else {
-            m_listView->setMatchedItems(m_firstFiveItems);
-        }
+    items[it->position] = newItem;
+    it->weight = itemWeight(newItem);
+
+    // 已显示的项直接更新对应行，无需重建列表
+    if (it->list == FirstFiveList || it->list == RestShowList)
+        m_listView->updateItem(newItem);
+
+    return true;
+}
+
+MatchedItems &GroupWidget::itemList(ItemList list)
+{
+    return const_cast<MatchedItems &>(static_cast<const GroupWidget *>(this)->itemList(list));
+}
+
+const MatchedItems &GroupWidget::itemList(ItemList list) const
+{
+    switch (list) {
+    case FirstFiveList:
+        return m_firstFiveItems;
+    case RestShowList:
+        return m_restShowItems;
+    case CacheList:
+        return m_cacheItems;
+    case CacheWeightList:
+        break;
+    }
+
+    return m_cacheWeightItems;
+}
+
+void GroupWidget::indexItems(ItemList list, int from)
+{
+    const MatchedItems &items = itemList(list);
+    for (int i = qMax(0, from); i < items.size(); ++i) {
+        const MatchedItem &item = items.at(i);
+        if (!item.item.isEmpty())
+            m_pathIndex.insert(item.item, { list, i, itemWeight(item) });
     }
+}
 
-    return updated;
+double GroupWidget::itemWeight(const MatchedItem &item)
+{
+    return item.weight;
 }
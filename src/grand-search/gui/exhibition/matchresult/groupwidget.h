@@ -10,6 +10,7 @@
 
 #include <DWidget>
 
+#include <QHash>
 #include <QScopedPointer>
 
 DWIDGET_BEGIN_NAMESPACE
@@ -66,6 +67,13 @@ public:
     MatchedItem findItemByPath(const QString &path) const;
     bool updateItemByPath(const QString &path, const MatchedItem &newItem);
 
+    /**
+     * @brief 判断类目中是否已有该路径的匹配结果
+     * @param path 文件路径
+     * @param weight 非空时返回已有结果的权重
+     */
+    bool containsPath(const QString &path, double *weight = nullptr) const;
+
 public slots:
     virtual void onMoreBtnClicked();
 
@@ -82,6 +90,31 @@ signals:
     void showMore();
     void sigCurrentItemChanged(const QString &groupName, const MatchedItem &item);
 
+protected:
+    // 匹配结果所在的缓存列表
+    enum ItemList {
+        FirstFiveList,
+        RestShowList,
+        CacheList,
+        CacheWeightList
+    };
+
+    // 路径索引项：所在列表、列表中的位置和权重
+    struct ItemLocation
+    {
+        ItemList list;
+        int position;
+        double weight;
+    };
+
+    MatchedItems &itemList(ItemList list);
+    const MatchedItems &itemList(ItemList list) const;
+
+    // 重新记录列表中从 from 开始各项的位置，列表增删或排序后调用
+    void indexItems(ItemList list, int from = 0);
+
+    static double itemWeight(const MatchedItem &item);
+
 protected:
     GrandSearchListView *m_listView = nullptr;
     ViewMoreButton* m_viewMoreButton = nullptr;
@@ -91,6 +124,9 @@ protected:
     MatchedItems m_restShowItems;      // 剩余正在显示的匹配结果
     MatchedItems m_cacheItems;         // 缓存中的匹配结果
     MatchedItems m_cacheWeightItems;   // 缓存经过权重排序的匹配结果
+    bool m_cacheItemsSorted = true;    // m_cacheItems 是否已按权重排序，取用时才排序
+
+    QHash<QString, ItemLocation> m_pathIndex;   // 文件路径 -> 所在列表及权重，用于去重
 
     QString m_searchGroupName;                      // 所属类目
 
@@ -35,14 +35,17 @@ void LevelItemGroupWidget::appendMatchedItems(const GrandSearch::MatchedItems &n
         for (auto level : newLevelItems.keys()) {
             m_levelCacheItems[level].append(newLevelItems.value(level));
         }
+        const int from = m_cacheItems.size();
         m_cacheItems << newGeneralItems;
 
         // 显示不足5个，或显示的5个中存在不是分层项，而现在又有新的分层项时，分层项需要添加显示
         if (GROUP_MAX_SHOW != m_listView->rowCount()
                 || (GROUP_MAX_SHOW != m_listView->levelItemCount() && !newLevelItems.isEmpty())) {
 
-            // 清空列表数据，将已显示数据还原到各自缓存中
+            // 清空列表数据，将已显示数据还原到各自缓存中，分层缓存不建立索引
             for (auto item : m_firstFiveItems) {
+                m_pathIndex.remove(item.item);
+
                 int tempLevel = -1;
                 if (Utils::isLevelItem(item, tempLevel))
                     m_levelCacheItems[tempLevel].append(item);
@@ -53,7 +56,15 @@ void LevelItemGroupWidget::appendMatchedItems(const GrandSearch::MatchedItems &n
 
             takeItemFromLevelCache();
 
+            // 从普通缓存补齐时缓存会重新排序，其中各项的位置都需重新记录；
+            // 分层项最多显示5个，这种情况在一次搜索中只会出现有限次
+            const bool takeGeneral = m_firstFiveItems.size() < GROUP_MAX_SHOW;
             takeItemFromGeneralCache();
+
+            indexItems(FirstFiveList);
+            indexItems(CacheList, takeGeneral ? 0 : from);
+        } else {
+            indexItems(CacheList, from);
         }
 
         // 缓存中有数据，显示'查看更多'按钮
@@ -65,13 +76,19 @@ void LevelItemGroupWidget::appendMatchedItems(const GrandSearch::MatchedItems &n
             Utils::sort(newLevelItems[level]);
         }
 
+        // 追加的行记入剩余显示结果，仅为这些行建立索引
+        const int from = m_restShowItems.size();
         for (auto level : newLevelItems.keys()) {
             auto items = newLevelItems.value(level);
             m_listView->addRows(items, level);
+            m_restShowItems << items;
         }
 
         Utils::sort(newGeneralItems);
         m_listView->addRows(newGeneralItems);
+        m_restShowItems << newGeneralItems;
+
+        indexItems(RestShowList, from);
     }
 
     layout();
@@ -27,6 +27,7 @@
 #define TailMaxWidth 150   // 拖尾信息最大显示宽度
 #define ContextLineSpacing 1   // 文件名与匹配内容行间距
 #define ListLineMargin 8   // 行上下边距
+#define LayoutCacheMaxCount 512   // 排版缓存最大条数（每行最多两条）
 
 DWIDGET_USE_NAMESPACE
 DGUI_USE_NAMESPACE
@@ -35,6 +36,7 @@ using namespace GrandSearch;
 GrandSearchListDelegate::GrandSearchListDelegate(QAbstractItemView *parent)
     : DStyledItemDelegate(parent)
 {
+    m_layoutCache.setMaxCost(LayoutCacheMaxCount);
 }
 
 GrandSearchListDelegate::~GrandSearchListDelegate()
@@ -296,6 +298,15 @@ void GrandSearchListDelegate::drawSearchResultText(QPainter *painter, const QSty
     }
 }
 
+QString GrandSearchListDelegate::layoutCacheKey(QChar kind, const QString &text, const QStringList &keywords,
+                                                const QFont &font, bool isDark, int width)
+{
+    // 以显示内容作为行数据版本：行数据变化后文本或关键词随之变化，旧缓存自然失效
+    return QStringList { QString(kind), QString::number(width), isDark ? QStringLiteral("1") : QStringLiteral("0"),
+                         font.key(), keywords.join(QChar(0x1f)), text }
+            .join(QChar(0x1e));
+}
+
 void GrandSearchListDelegate::drawItemName(QPainter *painter, const QModelIndex &index, const QStyleOptionViewItem &option,
                                            const QString &name, const QString &searcher,
                                            const QStringList &keywords, const QFont &font,
@@ -304,62 +315,72 @@ void GrandSearchListDelegate::drawItemName(QPainter *painter, const QModelIndex
 {
     int textStartX = ItemDataSpacing + ListIconSize + ItemDataSpacing;
     int nameTextMaxWidth = option.rect.width() - textStartX;
+    const bool isWeb = GRANDSEARCH_CLASS_WEB_STATICTEXT == searcher;
+
+    // 省略、高亮和排版结果按内容缓存，悬停、选中和滚动重绘时直接绘制
+    const QString key = layoutCacheKey(isWeb ? 'w' : 'n', name, keywords, font, isDark, nameTextMaxWidth);
+    TextLayoutEntry *entry = m_layoutCache.object(key);
+    if (!entry) {
+        // 使用 QFontMetricsF 进行精确的字体宽度计算
+        QFontMetricsF fontMetricsF(fontMetrics);
 
-    // 使用 QFontMetricsF 进行精确的字体宽度计算
-    QFontMetricsF fontMetricsF(fontMetrics);
+        // 关键词匹配器按关键词集合共享，每次查询只构建一次
+        const auto matcher = HighlightUtils::KeywordMatcher::get(keywords);
 
-    // 使用智能省略，确保高亮关键词优先显示
-    HighlightUtils::ElideResult elideResult;
+        // 使用智能省略，确保高亮关键词优先显示
+        HighlightUtils::ElideResult elideResult;
 
-    if (!keywords.isEmpty()) {
-        auto matchRanges = HighlightUtils::findMatchRanges(name, keywords);
-        if (!matchRanges.isEmpty()) {
-            elideResult = HighlightUtils::smartElideWithTracking(name, nameTextMaxWidth, fontMetricsF, matchRanges);
+        if (!keywords.isEmpty()) {
+            auto matchRanges = HighlightUtils::findMatchRanges(name, *matcher);
+            if (!matchRanges.isEmpty()) {
+                elideResult = HighlightUtils::smartElideWithTracking(name, nameTextMaxWidth, fontMetricsF, matchRanges);
+            }
         }
-    }
-    if (elideResult.text.isEmpty())
-        elideResult = HighlightUtils::elideWithTracking(name, Qt::ElideRight, nameTextMaxWidth, fontMetricsF);
-
-    QString displayText = elideResult.text;
-
-    // Web 搜索器特殊处理：保留末尾的标记字符
-    if (elideResult.text != name && GRANDSEARCH_CLASS_WEB_STATICTEXT == searcher) {
-        QString lastChar = name.right(1);
-        int lastCharWidth = static_cast<int>(fontMetricsF.horizontalAdvance(lastChar));
-        nameTextMaxWidth -= lastCharWidth;
-        if (nameTextMaxWidth > 0) {
-            elideResult = HighlightUtils::elideWithTracking(name.left(name.size() - 1), Qt::ElideRight, nameTextMaxWidth, fontMetricsF);
-            displayText = elideResult.text + lastChar;
+        if (elideResult.text.isEmpty())
+            elideResult = HighlightUtils::elideWithTracking(name, Qt::ElideRight, nameTextMaxWidth, fontMetricsF);
+
+        QString displayText = elideResult.text;
+        const bool elided = elideResult.text != name;
+
+        // Web 搜索器特殊处理：保留末尾的标记字符
+        if (elided && isWeb) {
+            QString lastChar = name.right(1);
+            int lastCharWidth = static_cast<int>(fontMetricsF.horizontalAdvance(lastChar));
+            int maxWidth = nameTextMaxWidth - lastCharWidth;
+            if (maxWidth > 0) {
+                elideResult = HighlightUtils::elideWithTracking(name.left(name.size() - 1), Qt::ElideRight, maxWidth, fontMetricsF);
+                displayText = elideResult.text + lastChar;
+            }
         }
-    }
-
-    // 构建高亮格式（映射到省略后的文本位置）
-    QTextCharFormat hlFmt;
-    hlFmt.setFontWeight(QFont::DemiBold);
-    hlFmt.setForeground(isDark ? QColor("#FFFFFF") : QColor("#000000"));
-    auto formats = HighlightUtils::buildFormatRanges(
-            displayText, elideResult.origPositions, name, keywords, hlFmt);
 
-    // 使用 QTextLayout 绘制
-    QTextLayout layout;
-    layout.setText(displayText);
-    layout.setFont(font);
-    layout.setFormats(formats);
-    layout.beginLayout();
-    layout.createLine();
-    layout.endLayout();
-
-    QRect drawRect(textStartX, startY, nameTextMaxWidth, fontMetrics.height());
+        // 构建高亮格式（映射到省略后的文本位置）
+        QTextCharFormat hlFmt;
+        hlFmt.setFontWeight(QFont::DemiBold);
+        hlFmt.setForeground(isDark ? QColor("#FFFFFF") : QColor("#000000"));
+        auto formats = HighlightUtils::buildFormatRanges(
+                displayText, elideResult.origPositions, name, *matcher, hlFmt);
+
+        entry = new TextLayoutEntry;
+        entry->elided = elided;
+        entry->layout.setText(displayText);
+        entry->layout.setFont(font);
+        entry->layout.setFormats(formats);
+        entry->layout.beginLayout();
+        entry->layout.createLine();
+        entry->layout.endLayout();
+        m_layoutCache.insert(key, entry);
+    }
 
     // 文件名被省略时，记录 tooltip 区域
-    if (elideResult.text != name) {
+    if (entry->elided) {
+        QRect drawRect(textStartX, startY, nameTextMaxWidth, fontMetrics.height());
         recordTooltipRegion(index.row(), drawRect, name);
     }
 
     painter->save();
     painter->translate(textStartX, startY);
     painter->setPen(textColor);
-    layout.draw(painter, QPointF(0, 0));
+    entry->layout.draw(painter, QPointF(0, 0));
     painter->restore();
 }
 
@@ -372,50 +393,59 @@ void GrandSearchListDelegate::drawMatchedContext(QPainter *painter, const QModel
         startX = ItemDataSpacing + ListIconSize + ItemDataSpacing;
     int maxWidth = option.rect.width() - startX;
 
-    // 使用 QFontMetricsF 进行精确的字体宽度计算
-    QFontMetricsF fontMetricsF(fontMetrics);
-
     QColor textColor = isDark ? QColor(255, 255, 255, int(255 * 0.5)) : QColor(0, 0, 0, int(255 * 0.5));
-    QColor highlightColor = isDark ? QColor(255, 255, 255, int(255 * 0.8)) : QColor(0, 0, 0, int(255 * 0.85));
-
-    // 以最左边的关键词匹配为锚点进行省略
-    auto allRanges = HighlightUtils::findMatchRanges(matchedContext, keywords);
-    QVector<HighlightUtils::MatchRange> leftmostOnly;
-    if (!allRanges.isEmpty())
-        leftmostOnly.append(allRanges.constFirst());
-
-    HighlightUtils::ElideResult elideResult;
-    if (!leftmostOnly.isEmpty())
-        elideResult = HighlightUtils::smartElideWithTracking(matchedContext, maxWidth, fontMetricsF, leftmostOnly);
-    if (elideResult.text.isEmpty())
-        elideResult = HighlightUtils::elideWithTracking(matchedContext, Qt::ElideRight, maxWidth, fontMetricsF);
-
-    // 构建高亮格式
-    QTextCharFormat hlFmt;
-    hlFmt.setFont(font);
-    hlFmt.setFontWeight(QFont::DemiBold);
-    hlFmt.setForeground(highlightColor);
-    auto formats = HighlightUtils::buildFormatRanges(
-            elideResult.text, elideResult.origPositions, matchedContext, keywords, hlFmt);
 
-    // 绘制
-    QTextLayout layout;
-    layout.setText(elideResult.text);
-    layout.setFont(font);
-    layout.setFormats(formats);
-    layout.beginLayout();
-    layout.createLine();
-    layout.endLayout();
+    const QString key = layoutCacheKey('c', matchedContext, keywords, font, isDark, maxWidth);
+    TextLayoutEntry *entry = m_layoutCache.object(key);
+    if (!entry) {
+        // 使用 QFontMetricsF 进行精确的字体宽度计算
+        QFontMetricsF fontMetricsF(fontMetrics);
+
+        QColor highlightColor = isDark ? QColor(255, 255, 255, int(255 * 0.8)) : QColor(0, 0, 0, int(255 * 0.85));
+
+        const auto matcher = HighlightUtils::KeywordMatcher::get(keywords);
+
+        // 以最左边的关键词匹配为锚点进行省略
+        auto allRanges = HighlightUtils::findMatchRanges(matchedContext, *matcher);
+        QVector<HighlightUtils::MatchRange> leftmostOnly;
+        if (!allRanges.isEmpty())
+            leftmostOnly.append(allRanges.constFirst());
+
+        HighlightUtils::ElideResult elideResult;
+        if (!leftmostOnly.isEmpty())
+            elideResult = HighlightUtils::smartElideWithTracking(matchedContext, maxWidth, fontMetricsF, leftmostOnly);
+        if (elideResult.text.isEmpty())
+            elideResult = HighlightUtils::elideWithTracking(matchedContext, Qt::ElideRight, maxWidth, fontMetricsF);
+
+        // 构建高亮格式
+        QTextCharFormat hlFmt;
+        hlFmt.setFont(font);
+        hlFmt.setFontWeight(QFont::DemiBold);
+        hlFmt.setForeground(highlightColor);
+        auto formats = HighlightUtils::buildFormatRanges(
+                elideResult.text, elideResult.origPositions, matchedContext, *matcher, hlFmt);
+
+        entry = new TextLayoutEntry;
+        entry->elided = elideResult.text != matchedContext;
+        entry->layout.setText(elideResult.text);
+        entry->layout.setFont(font);
+        entry->layout.setFormats(formats);
+        entry->layout.beginLayout();
+        entry->layout.createLine();
+        entry->layout.endLayout();
+        m_layoutCache.insert(key, entry);
+    }
 
+    // 绘制
     painter->save();
     painter->setPen(textColor);
     painter->translate(startX, startY);
-    layout.draw(painter, QPointF(0, 0));
+    entry->layout.draw(painter, QPointF(0, 0));
     painter->restore();
 
     // 摘要被省略时，记录 tooltip 区域
-    if (elideResult.text != matchedContext) {
-        QTextLine tl = layout.lineAt(0);
+    if (entry->elided) {
+        QTextLine tl = entry->layout.lineAt(0);
         recordTooltipRegion(index.row(),
                             QRect(startX, startY, int(tl.naturalTextWidth()), fontMetrics.height()),
                             matchedContext);
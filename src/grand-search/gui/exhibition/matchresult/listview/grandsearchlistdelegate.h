@@ -8,7 +8,9 @@
 #include <DListView>
 #include <DHiDPIHelper>
 
+#include <QCache>
 #include <QScopedPointer>
+#include <QTextLayout>
 #include <DStyledItemDelegate>
 
 namespace GrandSearch {
@@ -20,6 +22,13 @@ struct TooltipRegion
     QString fullText;   // 被省略前的完整文本
 };
 
+// 排版缓存项：省略、高亮后已完成排版的单行文本
+struct TextLayoutEntry
+{
+    QTextLayout layout;
+    bool elided = false;   // 是否被省略
+};
+
 class GrandSearchListDelegate : public Dtk::Widget::DStyledItemDelegate
 {
     Q_OBJECT
@@ -48,6 +57,11 @@ private:
     void recordTooltipRegion(int row, const QRect &rect, const QString &fullText) const;
 
     mutable QHash<int, QList<TooltipRegion>> m_tooltipRegionCache;
+
+    // 排版缓存键：类别、可用宽度、主题、字体、关键词和文本
+    static QString layoutCacheKey(QChar kind, const QString &text, const QStringList &keywords,
+                                  const QFont &font, bool isDark, int width);
+    mutable QCache<QString, TextLayoutEntry> m_layoutCache;
     void drawIcon(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
     void drawSearchResultText(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const;
     void drawItemName(QPainter *painter, const QModelIndex &index, const QStyleOptionViewItem &option,
@@ -11,7 +11,7 @@ using namespace GrandSearch;
 GrandSearchListModel::GrandSearchListModel(int rows, int columns, QObject *parent):
     QStandardItemModel(rows, columns, parent)
 {
-
+    connect(this, &QAbstractItemModel::modelReset, this, &GrandSearchListModel::onModelReset);
 }
 
 GrandSearchListModel::~GrandSearchListModel()
@@ -21,7 +21,24 @@ GrandSearchListModel::~GrandSearchListModel()
 
 bool GrandSearchListModel::setData(const QModelIndex &index, const QVariant &value, int role)
 {
-    return QStandardItemModel::setData(index, value, role);
+    if (m_batchDepth < 1 || !index.isValid())
+        return QStandardItemModel::setData(index, value, role);
+
+    // 批量更新期间屏蔽逐条通知，记录变化范围
+    bool ok = false;
+    {
+        const QSignalBlocker blocker(this);
+        ok = QStandardItemModel::setData(index, value, role);
+    }
+
+    if (ok) {
+        m_batchFirstRow = m_batchFirstRow < 0 ? index.row() : qMin(m_batchFirstRow, index.row());
+        m_batchLastRow = qMax(m_batchLastRow, index.row());
+        if (!m_batchRoles.contains(role))
+            m_batchRoles.append(role);
+    }
+
+    return ok;
 }
 
 Qt::ItemFlags GrandSearchListModel::flags(const QModelIndex &index) const
@@ -33,3 +50,74 @@ Qt::ItemFlags GrandSearchListModel::flags(const QModelIndex &index) const
         return Qt::ItemIsDropEnabled | defaultFlags;
     }
 }
+
+void GrandSearchListModel::setItemPath(const QModelIndex &index, const QString &path)
+{
+    if (!index.isValid())
+        return;
+
+    const QString oldPath = index.data(PATH_ROLE).toString();
+    if (oldPath == path)
+        return;
+
+    if (!oldPath.isEmpty()) {
+        auto it = m_pathIndex.find(oldPath);
+        if (it != m_pathIndex.end()) {
+            it->removeAll(QPersistentModelIndex(index));
+            if (it->isEmpty())
+                m_pathIndex.erase(it);
+        }
+    }
+
+    QStandardItemModel::setData(index, path, PATH_ROLE);
+
+    if (!path.isEmpty())
+        m_pathIndex[path].append(QPersistentModelIndex(index));
+}
+
+QModelIndexList GrandSearchListModel::indexesForPath(const QString &path)
+{
+    QModelIndexList indexes;
+
+    auto it = m_pathIndex.find(path);
+    if (it == m_pathIndex.end())
+        return indexes;
+
+    // 行被删除后持久索引失效，顺便清理
+    for (auto idx = it->begin(); idx != it->end();) {
+        if (idx->isValid()) {
+            indexes.append(*idx);
+            ++idx;
+        } else {
+            idx = it->erase(idx);
+        }
+    }
+
+    if (it->isEmpty())
+        m_pathIndex.erase(it);
+
+    return indexes;
+}
+
+void GrandSearchListModel::beginBatchUpdate()
+{
+    ++m_batchDepth;
+}
+
+void GrandSearchListModel::endBatchUpdate()
+{
+    if (m_batchDepth < 1 || --m_batchDepth > 0)
+        return;
+
+    if (m_batchFirstRow >= 0 && m_batchLastRow < rowCount())
+        emit dataChanged(index(m_batchFirstRow, 0), index(m_batchLastRow, 0), m_batchRoles);
+
+    m_batchFirstRow = -1;
+    m_batchLastRow = -1;
+    m_batchRoles.clear();
+}
+
+void GrandSearchListModel::onModelReset()
+{
+    m_pathIndex.clear();
+}
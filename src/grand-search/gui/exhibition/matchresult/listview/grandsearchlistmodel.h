@@ -7,6 +7,11 @@
 
 #include <QStandardItemModel>
 #include <QScopedPointer>
+#include <QPersistentModelIndex>
+#include <QHash>
+#include <QVector>
+
+#define PATH_ROLE Qt::UserRole + 3
 
 namespace GrandSearch {
 
@@ -19,6 +24,42 @@ public:
 
     virtual bool setData(const QModelIndex &index, const QVariant &value, int role = Qt::EditRole) Q_DECL_OVERRIDE;
     virtual Qt::ItemFlags flags(const QModelIndex &index) const Q_DECL_OVERRIDE;
+
+    /**
+     * @brief 记录行对应的文件路径
+     * @param index 行索引
+     * @param path 文件路径，为空时仅移除原有记录
+     *
+     * 索引使用持久索引保存，行插入、删除和移动后自动修正，无需重建。
+     */
+    void setItemPath(const QModelIndex &index, const QString &path);
+
+    /**
+     * @brief 查找文件路径对应的所有行
+     * @param path 文件路径
+     * @return 行索引列表，同一文件可能出现在多行
+     */
+    QModelIndexList indexesForPath(const QString &path);
+
+    /**
+     * @brief 开始批量更新
+     *
+     * 批量更新期间 setData 不逐条发出 dataChanged，
+     * endBatchUpdate 时按涉及的最小行范围合并发出一次。
+     */
+    void beginBatchUpdate();
+    void endBatchUpdate();
+
+private slots:
+    void onModelReset();
+
+private:
+    QHash<QString, QList<QPersistentModelIndex>> m_pathIndex;   // 文件路径 -> 行
+
+    int m_batchDepth = 0;
+    int m_batchFirstRow = -1;
+    int m_batchLastRow = -1;
+    QVector<int> m_batchRoles;
 };
 
 }
@@ -6,6 +6,7 @@
 #include "grandsearchlistmodel.h"
 #include "grandsearchlistdelegate.h"
 #include "utils/utils.h"
+#include "utils/mimetyperesolver.h"
 #include "utils/highlightprovider.h"
 #include "global/matcheditem.h"
 #include "global/builtinsearch.h"
@@ -17,10 +18,12 @@
 #include <DGuiApplicationHelper>
 #include <DStandardPaths>
 
+#include <QAbstractScrollArea>
 #include <QDebug>
 #include <QFileInfo>
 #include <QPainter>
 #include <QMouseEvent>
+#include <QTimer>
 
 using namespace GrandSearch;
 DCORE_USE_NAMESPACE
@@ -28,6 +31,8 @@ DGUI_USE_NAMESPACE
 DWIDGET_USE_NAMESPACE
 
 #define ICON_SIZE 24
+#define THUMBNAIL_SCHEDULE_INTERVAL 30   // 缩略图调度合并间隔（毫秒）
+#define UPDATE_FRAME_INTERVAL 16         // 缩略图和高亮更新合并间隔（一帧，毫秒）
 
 GrandSearchListView::GrandSearchListView(QWidget *parent)
     : DListView(parent)
@@ -59,6 +64,27 @@ GrandSearchListView::GrandSearchListView(QWidget *parent)
     // 连接缩略图生成完成信号
     connect(ThumbnailProvider::instance(), &ThumbnailProvider::thumbnailReady,
             this, &GrandSearchListView::onThumbnailReady);
+    // 失败或被其他请求挤掉的任务不会再有结果，清除请求记录以便之后重新请求
+    connect(ThumbnailProvider::instance(), &ThumbnailProvider::thumbnailFailed,
+            this, &GrandSearchListView::onThumbnailFailed);
+    connect(ThumbnailProvider::instance(), &ThumbnailProvider::thumbnailCanceled,
+            this, &GrandSearchListView::onThumbnailCanceled);
+
+    // 无后缀文件的类型在后台探测，完成后刷新对应行
+    connect(MimeTypeResolver::instance(), &MimeTypeResolver::mimeTypeResolved,
+            this, &GrandSearchListView::onMimeTypeResolved);
+
+    // 缩略图按可视区域调度，频繁的滚动和行变化合并处理
+    m_thumbnailTimer = new QTimer(this);
+    m_thumbnailTimer->setSingleShot(true);
+    m_thumbnailTimer->setInterval(THUMBNAIL_SCHEDULE_INTERVAL);
+    connect(m_thumbnailTimer, &QTimer::timeout, this, &GrandSearchListView::updateThumbnailRequests);
+
+    // 缩略图和高亮结果成批到达，按帧合并写入模型
+    m_updateTimer = new QTimer(this);
+    m_updateTimer->setSingleShot(true);
+    m_updateTimer->setInterval(UPDATE_FRAME_INTERVAL);
+    connect(m_updateTimer, &QTimer::timeout, this, &GrandSearchListView::flushPendingUpdates);
 }
 
 GrandSearchListView::~GrandSearchListView()
@@ -139,6 +165,16 @@ void GrandSearchListView::insertRows(int nRow, const MatchedItems &items)
 void GrandSearchListView::removeRows(int nRow, int nCount)
 {
     m_model->removeRows(nRow, nCount);
+    scheduleThumbnailUpdate();
+}
+
+bool GrandSearchListView::updateItem(const MatchedItem &item)
+{
+    const QModelIndexList indexes = m_model->indexesForPath(item.item);
+    for (const QModelIndex &index : indexes)
+        setData(index, item);
+
+    return !indexes.isEmpty();
 }
 
 int GrandSearchListView::levelItemCount(const int level)
@@ -173,6 +209,14 @@ void GrandSearchListView::clear()
         m_delegate->clearTooltipCache();
     if (m_model)
         m_model->clear();
+
+    cancelThumbnailRequests();
+
+    // 丢弃尚未写入的旧结果，避免套用到新搜索的同名文件
+    m_updateTimer->stop();
+    m_pendingThumbnails.clear();
+    m_pendingHighlights.clear();
+    m_failedThumbnails.clear();
 }
 
 void GrandSearchListView::setSearchKeyword(const QString &keyword)
@@ -199,6 +243,12 @@ void GrandSearchListView::onSetThemeType(int type)
     m_themeType = type;
 }
 
+void GrandSearchListView::scheduleThumbnailUpdate()
+{
+    if (!m_thumbnailTimer->isActive())
+        m_thumbnailTimer->start();
+}
+
 bool GrandSearchListView::event(QEvent *event)
 {
     Q_UNUSED(event)
@@ -237,15 +287,66 @@ void GrandSearchListView::mousePressEvent(QMouseEvent *event)
     DListView::mousePressEvent(event);
 }
 
+void GrandSearchListView::showEvent(QShowEvent *event)
+{
+    DListView::showEvent(event);
+    scheduleThumbnailUpdate();
+}
+
+void GrandSearchListView::hideEvent(QHideEvent *event)
+{
+    DListView::hideEvent(event);
+    scheduleThumbnailUpdate();
+}
+
+void GrandSearchListView::scrollContentsBy(int dx, int dy)
+{
+    DListView::scrollContentsBy(dx, dy);
+    scheduleThumbnailUpdate();
+}
+
 void GrandSearchListView::onThumbnailReady(const QString &filePath, const QPixmap &thumbnail)
 {
     if (thumbnail.isNull()) {
         return;
     }
 
+    m_thumbnailRequests.remove(filePath);
     updateThumbnail(filePath, thumbnail);
 }
 
+void GrandSearchListView::onThumbnailFailed(const QString &filePath)
+{
+    // 仅记录本视图请求过的文件，本次搜索中不再重复生成
+    if (m_thumbnailRequests.remove(filePath))
+        m_failedThumbnails.insert(filePath);
+}
+
+void GrandSearchListView::onThumbnailCanceled(const QString &filePath, const void *owner)
+{
+    // 多个视图可能请求同一文件，其他视图的请求被取消不影响本视图
+    if (owner != this)
+        return;
+
+    m_thumbnailRequests.remove(filePath);
+}
+
+void GrandSearchListView::onMimeTypeResolved(const QString &filePath)
+{
+    // 只有图标和缩略图依赖类型，高亮内容等其他数据保持不变
+    bool changed = false;
+    for (const QModelIndex &index : m_model->indexesForPath(filePath)) {
+        const MatchedItem item = index.data(DATA_ROLE).value<MatchedItem>();
+        if (item.type.isEmpty()) {
+            setItemIcon(index, item);
+            changed = true;
+        }
+    }
+
+    if (changed)
+        scheduleThumbnailUpdate();
+}
+
 QString GrandSearchListView::cacheDir()
 {
     auto userCachePath = DStandardPaths::standardLocations(QStandardPaths::CacheLocation).value(0);
@@ -260,7 +361,21 @@ void GrandSearchListView::setData(const QModelIndex &index, const MatchedItem &i
     QVariant searchMeta;
     searchMeta.setValue(item);
     m_model->setData(index, searchMeta, DATA_ROLE);
+    m_model->setItemPath(index, item.item);
+
+    setItemIcon(index, item);
 
+    // 缩略图按可视区域异步请求，"查看更多"之后的行和滚出视图的行不会占用生成线程
+    scheduleThumbnailUpdate();
+
+    if (!item.item.isEmpty()) {
+        // 异步请求高亮内容（仅对全文搜索和OCR搜索），默认展示的行优先处理
+        requestHighlightContent(item, index.row() < GROUP_MAX_SHOW);
+    }
+}
+
+void GrandSearchListView::setItemIcon(const QModelIndex &index, const MatchedItem &item)
+{
     // 设置icon - 先显示默认图标
     QIcon itemIcon = Utils::defaultIcon(item);
     const QString &strIcon = item.icon;
@@ -281,22 +396,6 @@ void GrandSearchListView::setData(const QModelIndex &index, const MatchedItem &i
     if (itemIcon.isNull())
         itemIcon = QIcon::fromTheme("unknown");
     m_model->setData(index, itemIcon, Qt::DecorationRole);
-
-    // 异步请求缩略图
-    if (!item.item.isEmpty()) {
-        QString mimetype = item.type;
-        if (mimetype.isEmpty()) {
-            mimetype = Utils::getFileMimetype(item.item);
-        }
-
-        // 检查是否支持该类型的缩略图
-        if (ThumbnailProvider::instance()->isSupported(mimetype)) {
-            ThumbnailProvider::instance()->requestThumbnail(item.item, mimetype, GrandSearch::ThumbnailSize::Large);
-        }
-
-        // 异步请求高亮内容（仅对全文搜索和OCR搜索）
-        requestHighlightContent(item, true);
-    }
 }
 
 int GrandSearchListView::levelItemLastRow(const int level)
@@ -319,28 +418,115 @@ void GrandSearchListView::updateThumbnail(const QString &filePath, const QPixmap
         return;
     }
 
-    // 遍历所有项，找到匹配的文件路径
-    for (int row = 0; row < m_model->rowCount(); ++row) {
-        QModelIndex index = m_model->index(row, 0);
-        if (!index.isValid()) {
-            continue;
+    m_pendingThumbnails.insert(filePath, thumbnail);
+    if (!m_updateTimer->isActive())
+        m_updateTimer->start();
+}
+
+void GrandSearchListView::updateThumbnailRequests()
+{
+    // 可视区域：自身视口与外层滚动区域视口的交集（列表本身不滚动，由匹配界面的滚动区域滚动）
+    QRect visibleRect;
+    QRect prefetchRect;
+    if (isVisible()) {
+        QRect clipRect = viewport()->rect();
+        for (QWidget *w = parentWidget(); w; w = w->parentWidget()) {
+            if (auto area = qobject_cast<QAbstractScrollArea *>(w)) {
+                QWidget *clip = area->viewport();
+                clipRect = QRect(viewport()->mapFrom(clip, QPoint(0, 0)), clip->size());
+                break;
+            }
         }
 
-        // 获取该项的数据
-        QVariant data = m_model->data(index, DATA_ROLE);
-        if (!data.isValid()) {
-            continue;
+        visibleRect = clipRect & viewport()->rect();
+        // 上下各预取一屏
+        prefetchRect = clipRect.adjusted(0, -clipRect.height(), 0, clipRect.height()) & viewport()->rect();
+    }
+
+    executeDelayedItemsLayout();
+
+    // 计算每个文件期望的请求优先级，同一文件取最高优先级
+    QHash<QString, int> wanted;
+    if (!prefetchRect.isEmpty()) {
+        for (int row = 0; row < m_model->rowCount(); ++row) {
+            const QModelIndex index = m_model->index(row, 0);
+            const QRect rect = visualRect(index);
+            int priority = -1;
+            if (rect.intersects(visibleRect))
+                priority = ThumbnailTaskManager::VisiblePriority;
+            else if (rect.intersects(prefetchRect))
+                priority = ThumbnailTaskManager::PrefetchPriority;
+            else
+                continue;
+
+            // 已有缩略图的行无需请求
+            if (!index.data(THUMBNAIL_ROLE).isNull())
+                continue;
+
+            const QString filePath = index.data(PATH_ROLE).toString();
+            if (filePath.isEmpty() || m_failedThumbnails.contains(filePath))
+                continue;
+
+            wanted.insert(filePath, qMax(wanted.value(filePath, -1), priority));
         }
+    }
+
+    // 先撤销离开可视区域的请求，为新请求腾出任务表空间
+    for (auto it = m_thumbnailRequests.begin(); it != m_thumbnailRequests.end();) {
+        if (!wanted.contains(it.key())) {
+            ThumbnailProvider::instance()->cancelRequest(it.key(), this);
+            it = m_thumbnailRequests.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (wanted.isEmpty())
+        return;
+
+    // 发起新请求，或将预取请求提升为可见请求
+    for (int row = 0; row < m_model->rowCount() && !wanted.isEmpty(); ++row) {
+        const QModelIndex index = m_model->index(row, 0);
+        const QString filePath = index.data(PATH_ROLE).toString();
+        auto want = wanted.find(filePath);
+        if (want == wanted.end())
+            continue;
+
+        const int priority = want.value();
+        wanted.erase(want);
+        if (m_thumbnailRequests.value(filePath, -1) >= priority)
+            continue;
+
+        // 类型尚在后台探测，完成后由 onMimeTypeResolved 重新调度
+        bool resolved = true;
+        const QString mimetype = MimeTypeResolver::instance()->mimeType(filePath,
+                                                                        index.data(DATA_ROLE).value<MatchedItem>().type,
+                                                                        &resolved);
+        if (!resolved)
+            continue;
 
-        MatchedItem item = data.value<MatchedItem>();
-        if (item.item == filePath) {
-            // 更新缩略图到独立角色，保留原始图标
-            m_model->setData(index, thumbnail, THUMBNAIL_ROLE);
-            break;   // 找到后退出循环
+        // 先记录再请求，内存缓存命中时会同步回调 onThumbnailReady
+        m_thumbnailRequests.insert(filePath, priority);
+
+        // 检查是否支持该类型的缩略图；任务表已满未能提交时清除记录，下次调度时重试
+        if (ThumbnailProvider::instance()->isSupported(mimetype)
+                && !ThumbnailProvider::instance()->requestThumbnail(filePath, mimetype, GrandSearch::ThumbnailSize::Large,
+                                                                    priority, this)) {
+            m_thumbnailRequests.remove(filePath);
         }
     }
 }
 
+void GrandSearchListView::cancelThumbnailRequests()
+{
+    if (m_thumbnailTimer)
+        m_thumbnailTimer->stop();
+
+    for (auto it = m_thumbnailRequests.cbegin(); it != m_thumbnailRequests.cend(); ++it)
+        ThumbnailProvider::instance()->cancelRequest(it.key(), this);
+    m_thumbnailRequests.clear();
+}
+
 void GrandSearchListView::requestHighlightContent(const MatchedItem &item, bool highPriority)
 {
     // 高亮内容
@@ -393,29 +579,40 @@ void GrandSearchListView::updateHighlight(const QString &filePath, const QString
         return;
     }
 
-    // 遍历所有项，找到匹配的文件路径
-    for (int row = 0; row < m_model->rowCount(); ++row) {
-        QModelIndex index = m_model->index(row, 0);
-        if (!index.isValid()) {
-            continue;
-        }
+    m_pendingHighlights.insert(filePath, content);
+    if (!m_updateTimer->isActive())
+        m_updateTimer->start();
+}
 
-        QVariant data = m_model->data(index, DATA_ROLE);
-        if (!data.isValid()) {
-            continue;
-        }
+void GrandSearchListView::flushPendingUpdates()
+{
+    if (m_pendingThumbnails.isEmpty() && m_pendingHighlights.isEmpty())
+        return;
+
+    m_model->beginBatchUpdate();
 
-        MatchedItem item = data.value<MatchedItem>();
-        if (item.item == filePath) {
+    for (auto it = m_pendingThumbnails.cbegin(); it != m_pendingThumbnails.cend(); ++it) {
+        // 更新缩略图到独立角色，保留原始图标
+        for (const QModelIndex &index : m_model->indexesForPath(it.key()))
+            m_model->setData(index, it.value(), THUMBNAIL_ROLE);
+    }
+
+    for (auto it = m_pendingHighlights.cbegin(); it != m_pendingHighlights.cend(); ++it) {
+        for (const QModelIndex &index : m_model->indexesForPath(it.key())) {
             // 更新 extra hash 中的 matchedContext
+            MatchedItem item = index.data(DATA_ROLE).value<MatchedItem>();
             QVariantHash extraHash = item.extra.toHash();
-            extraHash.insert(GRANDSEARCH_PROPERTY_ITEM_MATCHEDCONTEXT, content);
+            extraHash.insert(GRANDSEARCH_PROPERTY_ITEM_MATCHEDCONTEXT, it.value());
             item.extra = extraHash;
 
             QVariant searchMeta;
             searchMeta.setValue(item);
             m_model->setData(index, searchMeta, DATA_ROLE);
-            break;
         }
     }
+
+    m_pendingThumbnails.clear();
+    m_pendingHighlights.clear();
+
+    m_model->endBatchUpdate();
 }
@@ -10,8 +10,12 @@
 
 #include <DListView>
 
+#include <QHash>
+#include <QSet>
 #include <QPixmap>
 
+class QTimer;
+
 #define THUMBNAIL_ROLE Qt::UserRole + 1
 #define DATA_ROLE Qt::UserRole + 2
 
@@ -35,6 +39,8 @@ public:
     void insertRows(int nRow, const MatchedItems &items);
     // 从给定行开始删除指定行数
     void removeRows(int nRow, int nCount);
+    // 原地更新与 item 路径相同的行，不重建列表
+    bool updateItem(const MatchedItem &item);
 
     // 对应level级别项的数量,默认返回所有层级项的总和
     int levelItemCount(const int level = -1);
@@ -53,9 +59,23 @@ public:
      */
     void setSearchKeyword(const QString &keyword);
 
+    /**
+     * @brief 请求指定项的高亮内容（如果尚未请求）
+     * @param item 搜索结果项
+     * @param highPriority 是否为高优先级（可见区域或即将预览）
+     */
+    void requestHighlightContent(const MatchedItem &item, bool highPriority = false);
+
 public slots:
     void onSetThemeType(int type);
 
+    /**
+     * @brief 延迟重新计算缩略图请求
+     *
+     * 行增删、自身或外层滚动区域滚动、显隐变化后调用，多次调用合并为一次计算。
+     */
+    void scheduleThumbnailUpdate();
+
     /**
      * @brief 处理高亮内容获取完成（由 MatchWidget 统一连接信号后路由调用）
      * @param keyword 搜索关键词（taskId）
@@ -71,6 +91,9 @@ signals:
 protected:
     bool event(QEvent *event) Q_DECL_OVERRIDE;
     void mousePressEvent(QMouseEvent *event) Q_DECL_OVERRIDE;
+    void showEvent(QShowEvent *event) Q_DECL_OVERRIDE;
+    void hideEvent(QHideEvent *event) Q_DECL_OVERRIDE;
+    void scrollContentsBy(int dx, int dy) Q_DECL_OVERRIDE;
 
 private slots:
     /**
@@ -80,18 +103,54 @@ private slots:
      */
     void onThumbnailReady(const QString &filePath, const QPixmap &thumbnail);
 
+    /**
+     * @brief 处理缩略图生成失败，本次搜索中不再请求该文件
+     * @param filePath 文件路径
+     */
+    void onThumbnailFailed(const QString &filePath);
+
+    /**
+     * @brief 处理缩略图任务被取消，清除本视图的请求记录以便重新请求
+     * @param filePath 文件路径
+     * @param owner 请求方标识，其他请求方的任务被取消时忽略
+     */
+    void onThumbnailCanceled(const QString &filePath, const void *owner);
+
+    /**
+     * @brief 处理后台 MIME 类型探测完成，以最终类型刷新图标并重新调度缩略图
+     * @param filePath 文件路径
+     */
+    void onMimeTypeResolved(const QString &filePath);
+
 private:
     QString cacheDir();
     void setData(const QModelIndex &index, const MatchedItem &item);
+    // 按搜索项的类型或指定图标设置行图标
+    void setItemIcon(const QModelIndex &index, const MatchedItem &item);
     int levelItemLastRow(const int level);
 
     /**
      * @brief 更新指定文件路径对应的项的缩略图
      * @param filePath 文件路径
      * @param thumbnail 缩略图
+     *
+     * 更新先暂存，下一帧统一写入模型，见 flushPendingUpdates。
      */
     void updateThumbnail(const QString &filePath, const QPixmap &thumbnail);
 
+    /**
+     * @brief 按可视区域调度缩略图请求
+     *
+     * 可视区域内的行以高优先级请求，上下各一屏范围内的行预取，
+     * 其余行撤销本视图发起的请求。
+     */
+    void updateThumbnailRequests();
+
+    /**
+     * @brief 撤销本视图发起的所有缩略图请求
+     */
+    void cancelThumbnailRequests();
+
     /**
      * @brief 更新指定文件路径对应的项的高亮内容
      * @param filePath 文件路径
@@ -100,11 +159,11 @@ private:
     void updateHighlight(const QString &filePath, const QString &content);
 
     /**
-     * @brief 请求指定项的高亮内容（如果尚未请求）
-     * @param item 搜索结果项
-     * @param highPriority 是否为高优先级（可见区域）
+     * @brief 将暂存的缩略图和高亮内容写入模型
+     *
+     * 按路径索引定位行，整批只发出一次 dataChanged。
      */
-    void requestHighlightContent(const MatchedItem &item, bool highPriority = false);
+    void flushPendingUpdates();
 
 private:
     GrandSearchListModel *m_model = nullptr;
@@ -115,6 +174,14 @@ private:
 
     bool m_isPreviewItem = false;
     QString m_currentKeyword;  // 当前搜索关键词，用于高亮任务管理
+
+    QTimer *m_thumbnailTimer = nullptr;        // 合并缩略图调度请求
+    QHash<QString, int> m_thumbnailRequests;   // 已发起的缩略图请求：文件路径 -> 优先级
+    QSet<QString> m_failedThumbnails;          // 本次搜索中生成失败的文件
+
+    QTimer *m_updateTimer = nullptr;                  // 按帧合并缩略图和高亮更新
+    QHash<QString, QPixmap> m_pendingThumbnails;      // 待写入的缩略图：文件路径 -> 缩略图
+    QHash<QString, QString> m_pendingHighlights;      // 待写入的高亮内容：文件路径 -> 内容
 };
 
 }
@@ -125,7 +125,7 @@ void MatchWidget::clearMatchedData()
 
     m_vGroupWidgets.clear();
 
-    // 清空并隐藏所有类目列表
+    // 清空并隐藏所有类目列表，列表视图清空时撤销自身尚未完成的缩略图请求
     for (GroupWidgetMap::Iterator it = m_groupWidgetMap.begin(); it != m_groupWidgetMap.end(); ++it) {
         if (it.value())
             it.value()->clear();
@@ -233,6 +233,7 @@ void MatchWidget::selectNextItem()
     }
 
     adjustScrollBar();
+    prefetchAdjacentItems(true);
 }
 
 void MatchWidget::selectPreviousItem()
@@ -284,6 +285,7 @@ void MatchWidget::selectPreviousItem()
     }
 
     adjustScrollBar();
+    prefetchAdjacentItems(false);
 }
 
 void MatchWidget::handleItem()
@@ -358,6 +360,53 @@ void MatchWidget::onSelectItemByMouse(const MatchedItem &item)
     emit sigCurrentItemChanged(searchGroupName, item);
 }
 
+void MatchWidget::prefetchAdjacentItems(bool forward)
+{
+    // 预取项数，与预览侧的预取上限一致，避免按住方向键时积压后台任务
+    static constexpr int kPrefetchCount = 2;
+
+    int groupNumber = -1;
+    for (int i = 0; i < m_vGroupWidgets.count(); ++i) {
+        if (hasSelectItem(i)) {
+            groupNumber = i;
+            break;
+        }
+    }
+
+    if (groupNumber < 0)
+        return;
+
+    // 查看更多按钮位于类目列表首行之前，选中时视为第 -1 行
+    GroupWidget *group = m_vGroupWidgets.at(groupNumber);
+    int row = group->getViewMoreButton()->isSelected() ? -1 : group->getListView()->currentIndex().row();
+
+    MatchedItems items;
+    for (int i = groupNumber; i >= 0 && i < m_vGroupWidgets.count() && items.count() < kPrefetchCount;
+         forward ? ++i : --i) {
+        group = m_vGroupWidgets.at(i);
+        if (i != groupNumber)
+            row = forward ? -1 : group->getListView()->model()->rowCount();
+
+        if (!group->isVisible() || !Utils::canPreview(group->searchGroupName()))
+            continue;
+
+        GrandSearchListView *listView = group->getListView();
+        QAbstractItemModel *model = listView->model();
+        for (int r = forward ? row + 1 : row - 1; r >= 0 && r < model->rowCount() && items.count() < kPrefetchCount;
+             forward ? ++r : --r) {
+            const MatchedItem &item = model->index(r, 0).data(DATA_ROLE).value<MatchedItem>();
+            if (item.item.isEmpty())
+                continue;
+
+            listView->requestHighlightContent(item, true);
+            items.append(item);
+        }
+    }
+
+    if (!items.isEmpty())
+        emit sigPrefetchItems(items);
+}
+
 bool MatchWidget::selectFirstItem(int groupNumber)
 {
     if (this->isHidden())
@@ -573,11 +622,23 @@ void MatchWidget::initConnect()
         if (content.isEmpty())
             return;
         for (GroupWidget *groupWidget : std::as_const(m_groupWidgetMap)) {
-            if (groupWidget && groupWidget->findItemByPath(filePath).item == filePath) {
+            if (groupWidget && groupWidget->containsPath(filePath)) {
                 groupWidget->getListView()->onHighlightReady(keyword, filePath, content);
             }
         }
     });
+
+    // 滚动时按新的可视区域调度缩略图
+    connect(m_scrollArea->verticalScrollBar(), &QScrollBar::valueChanged,
+            this, &MatchWidget::updateThumbnailViewport);
+}
+
+void MatchWidget::updateThumbnailViewport()
+{
+    for (GroupWidget *groupWidget : std::as_const(m_vGroupWidgets)) {
+        if (groupWidget)
+            groupWidget->getListView()->scheduleThumbnailUpdate();
+    }
 }
 
 void MatchWidget::reLayout()
@@ -626,6 +687,9 @@ void MatchWidget::reLayout()
     }
 
     layout();
+
+    // 类目列表位置和高度变化后，可视区域内的行随之变化
+    updateThumbnailViewport();
 }
 
 GroupWidget *MatchWidget::createGroupWidget(const QString &searchGroupName)
@@ -700,6 +764,8 @@ void MatchWidget::resizeEvent(QResizeEvent *event)
     }
 
     DWidget::resizeEvent(event);
+
+    updateThumbnailViewport();
 }
 
 MatchedItems MatchWidget::deduplicateAgainstBestMatch(const MatchedItems &items, const QString &groupName)
@@ -723,12 +789,10 @@ MatchedItems MatchWidget::deduplicateAgainstBestMatch(const MatchedItems &items,
 
     MatchedItems filtered;
     for (const auto &item : items) {
-        MatchedItem existing = bestMatchWidget->findItemByPath(item.item);
-        if (!existing.item.isEmpty()) {
-            // Already in Best Match — update if new item has higher weight
-            double newWeight = item.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
-            double existingWeight = existing.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
-            if (newWeight > existingWeight) {
+        double existingWeight = 0;
+        if (bestMatchWidget->containsPath(item.item, &existingWeight)) {
+            // Already in Best Match — update in place if new item has higher weight
+            if (item.weight > existingWeight) {
                 bestMatchWidget->updateItemByPath(item.item, item);
             }
             // Don't add to current group — item belongs to Best Match
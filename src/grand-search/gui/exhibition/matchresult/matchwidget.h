@@ -48,6 +48,8 @@ private slots:
 
 signals:
     void sigCurrentItemChanged(const QString &searchGroupName, const MatchedItem &item);
+    // 按键切换后，沿切换方向即将被选中的可预览项，按距离由近到远排列
+    void sigPrefetchItems(const MatchedItems &items);
     void sigShowNoContent(bool noContent);
     void sigCloseWindow();
 
@@ -69,6 +71,12 @@ private:
 
     void currentIndexChanged(const QString &searchGroupName, const QModelIndex& index);
 
+    // 沿切换方向收集当前选择项之后的可预览项，请求其高亮内容并通知预取
+    void prefetchAdjacentItems(bool forward);
+
+    // 通知所有显示中的类目列表按当前可视区域重新调度缩略图
+    void updateThumbnailViewport();
+
 protected:
     void initUi();
     void initConnect();
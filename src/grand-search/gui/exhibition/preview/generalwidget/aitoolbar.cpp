@@ -20,6 +20,7 @@
 #include <QDBusReply>
 #include <QVariantMap>
 #include <QtDBus>
+#include <QElapsedTimer>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
@@ -29,14 +30,41 @@ DGUI_USE_NAMESPACE
 DCORE_USE_NAMESPACE
 using namespace GrandSearch;
 
+// UOS AI 安装状态的缓存有效期（毫秒），过期后在后台刷新
+static constexpr int kUosAiCheckInterval = 10000;
+
 bool AiToolBar::checkUosAiInstalled()
 {
-    QDBusInterface iface("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus");
-    QDBusReply<QStringList> reply = iface.call("ListActivatableNames");
-    if (reply.isValid())
-        return reply.value().contains("com.deepin.copilot");
+    static bool installed = false;
+    static bool refreshing = false;
+    static QElapsedTimer checked;
+
+    // 每次预览都会检查，仅首次同步查询，之后返回缓存结果并在过期后异步刷新，
+    // 避免切换预览时阻塞在 D-Bus 调用上
+    if (!checked.isValid()) {
+        QDBusInterface iface("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus");
+        QDBusReply<QStringList> reply = iface.call("ListActivatableNames");
+        installed = reply.isValid() && reply.value().contains("com.deepin.copilot");
+        checked.start();
+        return installed;
+    }
+
+    if (!refreshing && checked.elapsed() > kUosAiCheckInterval) {
+        refreshing = true;
+        QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                          "org.freedesktop.DBus", "ListActivatableNames");
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(msg));
+        QObject::connect(watcher, &QDBusPendingCallWatcher::finished, [](QDBusPendingCallWatcher *call) {
+            QDBusPendingReply<QStringList> reply = *call;
+            if (!reply.isError())
+                installed = reply.value().contains("com.deepin.copilot");
+            refreshing = false;
+            checked.restart();
+            call->deleteLater();
+        });
+    }
 
-    return false;
+    return installed;
 }
 
 void AiToolBar::showWarningDialog(QString name)
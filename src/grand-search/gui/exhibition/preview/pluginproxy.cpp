@@ -4,6 +4,9 @@
 
 #include "pluginproxy.h"
 #include "generalwidget/detailwidget.h"
+#include "generalwidget/aitoolbar.h"
+#include "thumbnail/thumbnailcache.h"
+#include "utils/mediametacache.h"
 
 #include <QDebug>
 #include <QLoggingCategory>
@@ -19,6 +22,21 @@ PluginProxy::PluginProxy(PreviewWidget *parent)
 
 }
 
+QObject *PluginProxy::thumbnailCache() const
+{
+    return ThumbnailCache::instance();
+}
+
+QObject *PluginProxy::mediaMetaCache() const
+{
+    return MediaMetaCache::instance();
+}
+
+bool PluginProxy::uosAiInstalled() const
+{
+    return AiToolBar::checkUosAiInstalled();
+}
+
 void PluginProxy::updateDetailInfo(PreviewPlugin *plugin)
 {
     if (plugin == nullptr || plugin != q->m_preview) {
@@ -17,6 +17,12 @@ class PluginProxy : public QObject
     Q_OBJECT
 public:
     explicit PluginProxy(PreviewWidget *parent);
+    // 宿主的缩略图缓存，生命周期与进程相同，插件可在工作线程中直接调用
+    Q_INVOKABLE QObject *thumbnailCache() const;
+    // 宿主的音视频元数据缓存，同上
+    Q_INVOKABLE QObject *mediaMetaCache() const;
+    // 宿主是否显示 AI 工具栏所依赖的 UOS AI 安装状态，插件据此调整布局
+    Q_INVOKABLE bool uosAiInstalled() const;
 
 signals:
 
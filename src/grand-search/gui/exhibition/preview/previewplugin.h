@@ -10,6 +10,7 @@
 #include <QObject>
 #include <QHash>
 #include <QPair>
+#include <QStringList>
 
 namespace GrandSearch {
 
@@ -83,5 +84,23 @@ public:
     virtual bool expandContent() const { return false; }
 };
 
+/**
+ * @brief  请求插件在后台预先解析即将预览的文件（可选接口）
+ * @state  插件类声明 Q_INVOKABLE bool prefetch(const QStringList &files) 即可支持，解析结果写入缓存，不得改变当前预览内容；
+ *         新的请求替换尚未完成的请求，files 为空时取消预取
+ * @return bool 插件未实现该接口或拒绝预取时返回 false
+ */
+inline bool requestPrefetch(PreviewPlugin *plugin, const QStringList &files)
+{
+    QObject *obj = dynamic_cast<QObject *>(plugin);
+    if (!obj || obj->metaObject()->indexOfMethod("prefetch(QStringList)") < 0)
+        return false;
+
+    bool accepted = false;
+    return QMetaObject::invokeMethod(obj, "prefetch", Qt::DirectConnection,
+                                     Q_RETURN_ARG(bool, accepted), Q_ARG(QStringList, files))
+            && accepted;
+}
+
 }
 #endif // PREVIEWPLUGINUI_H
@@ -7,17 +7,28 @@
 #include "generalpreviewplugin.h"
 #include "utils/previewpluginconf.h"
 #include "utils/utils.h"
+#include "utils/mimetyperesolver.h"
 
+#include <QThreadPool>
+#include <QElapsedTimer>
+#include <QMutexLocker>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
 
 using namespace GrandSearch;
 
+// 预加载优先级：当前显示结果所需的插件优先于空闲时的全量预加载
+static constexpr int kIdlePreloadPriority = 0;
+static constexpr int kVisiblePreloadPriority = 1;
+
 PreviewPluginManager::PreviewPluginManager()
     : QObject()
+    , m_preloadPool(new QThreadPool(this))
 {
     qCDebug(logGrandSearch) << "Creating PreviewPluginManager";
+    // 逐个加载插件，避免与界面线程争抢磁盘及 CPU
+    m_preloadPool->setMaxThreadCount(1);
     readPluginConfig();
     qCDebug(logGrandSearch) << "PreviewPluginManager created - Total plugins:" << m_plugins.size();
 }
@@ -25,76 +36,199 @@ PreviewPluginManager::PreviewPluginManager()
 PreviewPluginManager::~PreviewPluginManager()
 {
     qCDebug(logGrandSearch) << "Destroying PreviewPluginManager";
+    m_preloadPool->clear();
+    m_preloadPool->waitForDone();
     clearPluginInfo();
 }
 
-PreviewPlugin *PreviewPluginManager::getPreviewPlugin(const MatchedItem &item)
+QSharedPointer<PreviewPlugin> PreviewPluginManager::getPreviewPlugin(const MatchedItem &item, QObject *proxy)
 {
     qCDebug(logGrandSearch) << "Getting preview plugin for item - Name:" << item.name
                             << "Type:" << item.type;
 
-    PreviewPlugin *previewPlugin = nullptr;
-
-    QString mimeType = item.type;
+    // 类型未探测完成时按占位类型选择插件，探测完成后由预览界面重新预览
+    const QString mimeType = MimeTypeResolver::instance()->mimeType(item.item, item.type);
     if (mimeType.isEmpty())
-        mimeType = Utils::getFileMimetype(item.item);
+        return nullptr;
+
+    for (PreviewPluginInfo &pluginInfo : m_plugins) {
+        if (!pluginInfo.bValid)
+            continue;
+
+        // 需支持正则表达式 todo
+        const QString family = matchedMimeType(mimeType, pluginInfo.mimeTypes);
+        if (family.isEmpty())
+            continue;
 
-    if (!mimeType.isEmpty()) {
-        for (auto pluginInfo : m_plugins) {
-            if (!pluginInfo.bValid)
+        const QString key = instanceKey(pluginInfo.name, mimeType);
+        auto it = m_instances.constFind(key);
+        if (it != m_instances.constEnd())
+            return it.value();
+
+        if (nullptr == pluginInfo.pPlugin) {
+            // 加载预览插件，加载器在插件信息清空前一直保留
+            QElapsedTimer timer;
+            timer.start();
+            QPluginLoader *loader = new QPluginLoader(pluginInfo.path, this);
+            if (!loader->load()) {
+                qCWarning(logGrandSearch) << "Failed to load preview plugin - Path:" << pluginInfo.path << "Error:" << loader->errorString();
+                loader->deleteLater();
                 continue;
+            }
 
-            // 需支持正则表达式 todo
-            if (isMimeTypeMatch(mimeType, pluginInfo.mimeTypes)) {
-                if (nullptr == pluginInfo.pPlugin) {
-                    // 加载预览插件
-                    QPluginLoader *loader = new QPluginLoader(pluginInfo.path, this);
-                    if (!loader->load()) {
-                        qCWarning(logGrandSearch) << "Failed to load preview plugin - Path:" << pluginInfo.path << "Error:" << loader->errorString();
-                        loader->deleteLater();
-                        continue;
-                    }
-
-                    pluginInfo.pPlugin = loader;
-                }
+            pluginInfo.pPlugin = loader;
 
-                // 从预览插件创建或获取预览界面
-                QObject *pluginObject = pluginInfo.pPlugin->instance();
-                if (PreviewPluginInterface *pluginIFace = qobject_cast<PreviewPluginInterface *>(pluginObject)) {
-                    previewPlugin = pluginIFace->create(mimeType);
-                    qCDebug(logGrandSearch) << "Created preview plugin - Name:" << pluginInfo.name
-                                            << "MimeType:" << mimeType;
-                }
-                break;
+            // 已预加载时此处仅复用已加载的库，耗时即为冷启动预览省下的部分
+            const qint64 cost = timer.elapsed();
+            bool preloaded = false;
+            {
+                QMutexLocker lk(&m_preloadMutex);
+                preloaded = m_preloaded.contains(pluginInfo.path);
+            }
+            if (pluginInfo.loadTime < 0)
+                pluginInfo.loadTime = cost;
+            qCInfo(logGrandSearch) << "Preview plugin loaded - Name:" << pluginInfo.name
+                                   << "Cost:" << cost << "ms" << "Preloaded:" << preloaded;
+        }
+
+        // 从预览插件创建预览界面，并缓存以供后续同类文件复用
+        QSharedPointer<PreviewPlugin> previewPlugin;
+        QObject *pluginObject = pluginInfo.pPlugin->instance();
+        if (PreviewPluginInterface *pluginIFace = qobject_cast<PreviewPluginInterface *>(pluginObject)) {
+            previewPlugin.reset(pluginIFace->create(mimeType));
+            if (previewPlugin) {
+                previewPlugin->init(proxy);
+                m_instances.insert(key, previewPlugin);
+                qCDebug(logGrandSearch) << "Created preview plugin - Name:" << pluginInfo.name
+                                        << "MimeType:" << mimeType << "Family:" << family;
             }
         }
+        return previewPlugin;
     }
 
-    return previewPlugin;
+    return nullptr;
+}
+
+QSharedPointer<PreviewPlugin> PreviewPluginManager::existingPreviewPlugin(const MatchedItem &item) const
+{
+    const QString mimeType = MimeTypeResolver::instance()->mimeType(item.item, item.type);
+    if (mimeType.isEmpty())
+        return nullptr;
+
+    // 与 getPreviewPlugin 选择相同的插件，插件库未加载或界面未创建时不返回其他插件的实例
+    for (const PreviewPluginInfo &pluginInfo : m_plugins) {
+        if (!pluginInfo.bValid)
+            continue;
+
+        const QString family = matchedMimeType(mimeType, pluginInfo.mimeTypes);
+        if (family.isEmpty())
+            continue;
+
+        if (nullptr == pluginInfo.pPlugin)
+            return nullptr;
+
+        return m_instances.value(instanceKey(pluginInfo.name, mimeType));
+    }
+
+    return nullptr;
 }
 
 bool PreviewPluginManager::isMimeTypeMatch(const QString &mimetype, const QStringList &supportMimeTypes)
 {
-    bool match = false;
+    return !matchedMimeType(mimetype, supportMimeTypes).isEmpty();
+}
+
+QString PreviewPluginManager::matchedMimeType(const QString &mimetype, const QStringList &supportMimeTypes)
+{
     for (const QString &mt : supportMimeTypes) {
-        if (mimetype.compare(mt, Qt::CaseInsensitive) == 0) {
-            match = true;
-            break;
-        }
+        if (mimetype.compare(mt, Qt::CaseInsensitive) == 0)
+            return mt;
 
         int starPos = mt.indexOf("*");
         if (starPos > 0 && mimetype.size() > starPos) {
-            if (mt.left(starPos).compare(mimetype.left(starPos)) == 0) {
-                match = true;
+            if (mt.left(starPos).compare(mimetype.left(starPos)) == 0)
+                return mt;
+        }
+    }
+    return QString();
+}
+
+void PreviewPluginManager::preload(const QStringList &mimeTypes)
+{
+    for (const PreviewPluginInfo &info : m_plugins) {
+        if (!info.bValid || info.pPlugin)
+            continue;
+
+        if (mimeTypes.isEmpty()) {
+            schedulePreload(info, kIdlePreloadPriority);
+            continue;
+        }
+
+        for (const QString &type : mimeTypes) {
+            if (isMimeTypeMatch(type, info.mimeTypes)) {
+                schedulePreload(info, kVisiblePreloadPriority);
                 break;
             }
         }
     }
-    return match;
+}
+
+void PreviewPluginManager::schedulePreload(const PreviewPluginInfo &info, int priority)
+{
+    // 已按相同或更高优先级提交过则忽略；提高优先级时重复提交，任务执行时会跳过已加载的插件
+    auto it = m_preloadPriority.constFind(info.name);
+    if (it != m_preloadPriority.constEnd() && it.value() >= priority)
+        return;
+    m_preloadPriority.insert(info.name, priority);
+
+    const QString name = info.name;
+    const QString path = info.path;
+    m_preloadPool->start([this, name, path]() {
+        {
+            QMutexLocker lk(&m_preloadMutex);
+            if (m_preloaded.contains(path))
+                return;
+        }
+
+        // 加载器析构时不卸载插件库，界面线程再次加载同一路径时直接复用
+        QElapsedTimer timer;
+        timer.start();
+        QPluginLoader loader(path);
+        const bool ok = loader.load();
+        const qint64 cost = timer.elapsed();
+
+        {
+            QMutexLocker lk(&m_preloadMutex);
+            m_preloaded.insert(path);
+        }
+
+        if (!ok) {
+            qCWarning(logGrandSearch) << "Failed to preload preview plugin - Path:" << path << "Error:" << loader.errorString();
+            return;
+        }
+
+        QMetaObject::invokeMethod(this, [this, name, cost]() {
+            onPreloaded(name, cost);
+        }, Qt::QueuedConnection);
+    }, priority);
+}
+
+void PreviewPluginManager::onPreloaded(const QString &name, qint64 cost)
+{
+    qCInfo(logGrandSearch) << "Preview plugin preloaded - Name:" << name << "Cost:" << cost << "ms";
+
+    PreviewPluginInfo *info = getPreviewPlugin(name);
+    if (info && info->loadTime < 0)
+        info->loadTime = cost;
 }
 
 void PreviewPluginManager::clearPluginInfo()
 {
+    m_preloadPriority.clear();
+
+    // 插件界面由插件库创建，需先于加载器释放
+    m_instances.clear();
+
     for (auto pluginInfo : m_plugins) {
         if (pluginInfo.pPlugin)
             delete pluginInfo.pPlugin;
@@ -234,3 +368,9 @@ bool PreviewPluginManager::downwardCompatibility(const QString &version)
 
     return true;
 }
+
+QString PreviewPluginManager::instanceKey(const QString &name, const QString &mimeType)
+{
+    // 配置中可能逐个列出具体类型，按顶层类型复用实例，切换 jpeg 与 png 时无需重建界面
+    return name + QLatin1Char('|') + mimeType.section(QLatin1Char('/'), 0, 0);
+}
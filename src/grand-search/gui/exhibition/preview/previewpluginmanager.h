@@ -8,6 +8,13 @@
 #include "gui/datadefine.h"
 #include "global/matcheditem.h"
 
+#include <QSharedPointer>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+
+class QThreadPool;
+
 namespace GrandSearch {
 
 class PreviewPlugin;
@@ -18,8 +25,25 @@ public:
     explicit PreviewPluginManager();
     ~PreviewPluginManager();
 
-    PreviewPlugin *getPreviewPlugin(const MatchedItem& item);
+    /**
+     * @brief 获取用于预览指定搜索项的插件界面
+     * 同一插件下顶层 mimetype 相同的类型（如 image/jpeg 与 image/png）共用一个插件界面实例，新建的实例以 proxy 初始化
+     */
+    QSharedPointer<PreviewPlugin> getPreviewPlugin(const MatchedItem& item, QObject *proxy);
+    /**
+     * @brief 获取已创建的用于预览指定搜索项的插件界面
+     * 不加载插件库也不创建新实例，可在键盘切换等频繁调用的路径中使用；尚未创建时返回空
+     */
+    QSharedPointer<PreviewPlugin> existingPreviewPlugin(const MatchedItem &item) const;
     static bool isMimeTypeMatch(const QString &mimetype, const QStringList &supportMimeTypes);
+    // 返回 supportMimeTypes 中与 mimetype 匹配的配置项，无匹配时返回空
+    static QString matchedMimeType(const QString &mimetype, const QStringList &supportMimeTypes);
+
+    /**
+     * @brief 在后台线程中预加载预览插件库及其依赖库，避免首次预览时在界面线程中加载
+     * @param mimeTypes 为空时预加载全部插件；否则仅以较高优先级预加载支持这些类型的插件
+     */
+    void preload(const QStringList &mimeTypes = QStringList());
 private:
     void clearPluginInfo();
     bool readPluginConfig();
@@ -30,11 +54,21 @@ private:
     void setPluginPath(const QStringList &dirPaths);
     // 插件版本是否向下兼容
     bool downwardCompatibility(const QString &version);
+    // 插件界面实例的缓存键：插件名称+顶层 mimetype
+    static QString instanceKey(const QString &name, const QString &mimeType);
+    void schedulePreload(const PreviewPluginInfo &info, int priority);
+    void onPreloaded(const QString &name, qint64 cost);
 
 private:
     QStringList m_paths;
     PreviewPluginInfoList m_plugins;
     QString m_mainVersion;
+    QHash<QString, QSharedPointer<PreviewPlugin>> m_instances;  // 插件名称+顶层mimetype -> 插件界面
+
+    QThreadPool *m_preloadPool = nullptr;
+    QHash<QString, int> m_preloadPriority;  // 已提交预加载的插件名称 -> 优先级
+    QMutex m_preloadMutex;
+    QSet<QString> m_preloaded;              // 后台已加载完成的插件库路径
 };
 
 }
@@ -0,0 +1,91 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "previewprefetcher.h"
+#include "previewplugin.h"
+#include "previewpluginmanager.h"
+#include "utils/mimetyperesolver.h"
+#include "thumbnail/thumbnail.h"
+
+#include <QLoggingCategory>
+
+#include <algorithm>
+
+Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
+
+using namespace GrandSearch;
+
+// 每次预取的最大项数，限制预取占用的 CPU 与缓存空间
+static constexpr int kMaxPrefetchItems = 2;
+
+PreviewPrefetcher::PreviewPrefetcher(PreviewPluginManager *manager, QObject *parent)
+    : QObject(parent)
+    , m_manager(manager)
+{
+}
+
+PreviewPrefetcher::~PreviewPrefetcher()
+{
+    cancel();
+}
+
+void PreviewPrefetcher::prefetch(const MatchedItems &items)
+{
+    cancel();
+
+    QList<QPair<QSharedPointer<PreviewPlugin>, QStringList>> requests;
+    int count = 0;
+    for (const MatchedItem &item : items) {
+        if (count >= kMaxPrefetchItems)
+            break;
+
+        // 类型尚在后台探测的项不预取，避免按占位类型选错插件
+        bool resolved = true;
+        const QString mimeType = MimeTypeResolver::instance()->mimeType(item.item, item.type, &resolved);
+        if (item.item.isEmpty() || mimeType.isEmpty() || !resolved)
+            continue;
+
+        ++count;
+        if (mimeType.startsWith("image/") && ThumbnailProvider::instance()->isSupported(mimeType)) {
+            ThumbnailProvider::instance()->requestThumbnail(item.item, mimeType, ThumbnailSize::Large,
+                                                            ThumbnailTaskManager::PrefetchPriority, this);
+            m_thumbnailRequests.insert(item.item);
+            continue;
+        }
+
+        // 预取在每次按键时执行，只交给已创建的插件界面，不在此加载插件
+        QSharedPointer<PreviewPlugin> plugin = m_manager->existingPreviewPlugin(item);
+        if (!plugin)
+            continue;
+
+        auto it = std::find_if(requests.begin(), requests.end(), [&plugin](const QPair<QSharedPointer<PreviewPlugin>, QStringList> &request) {
+            return request.first == plugin;
+        });
+        if (it == requests.end())
+            requests.append(qMakePair(plugin, QStringList { item.item }));
+        else
+            it->second.append(item.item);
+    }
+
+    for (const auto &request : requests) {
+        if (requestPrefetch(request.first.data(), request.second))
+            m_plugins.append(request.first.toWeakRef());
+    }
+
+    qCDebug(logGrandSearch) << "Preview prefetch - Thumbnails:" << m_thumbnailRequests.size()
+                            << "Plugins:" << m_plugins.size();
+}
+
+void PreviewPrefetcher::cancel()
+{
+    for (const QString &path : m_thumbnailRequests)
+        ThumbnailProvider::instance()->cancelRequest(path, this);
+    m_thumbnailRequests.clear();
+
+    for (const QWeakPointer<PreviewPlugin> &weak : m_plugins) {
+        if (QSharedPointer<PreviewPlugin> plugin = weak.toStrongRef())
+            requestPrefetch(plugin.data(), {});
+    }
+    m_plugins.clear();
+}
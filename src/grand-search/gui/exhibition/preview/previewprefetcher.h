@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PREVIEWPREFETCHER_H
+#define PREVIEWPREFETCHER_H
+
+#include "global/matcheditem.h"
+
+#include <QObject>
+#include <QSet>
+#include <QWeakPointer>
+
+namespace GrandSearch {
+
+class PreviewPlugin;
+class PreviewPluginManager;
+
+/**
+ * @brief 键盘切换结果时预取即将预览的搜索项
+ *
+ * - 图片：以预取优先级请求缩略图，预览插件可直接缩放缓存的缩略图
+ * - 其他类型：交给已创建且支持预取的预览插件，由插件在后台解析并写入缓存（音视频元数据、PDF 首页等），
+ *   不为预取加载插件库或创建插件界面
+ * 每次最多预取 kMaxPrefetchItems 项，新的预取替换尚未完成的预取，搜索结果变化时全部放弃。
+ */
+class PreviewPrefetcher : public QObject
+{
+    Q_OBJECT
+public:
+    explicit PreviewPrefetcher(PreviewPluginManager *manager, QObject *parent = nullptr);
+    ~PreviewPrefetcher() override;
+
+    // 预取给定的搜索项，按列表顺序处理
+    void prefetch(const MatchedItems &items);
+    // 放弃全部预取
+    void cancel();
+
+private:
+    PreviewPluginManager *m_manager = nullptr;
+    QSet<QString> m_thumbnailRequests;                 // 已提交的缩略图预取
+    QList<QWeakPointer<PreviewPlugin>> m_plugins;      // 已提交预取的插件界面
+};
+
+}
+
+#endif // PREVIEWPREFETCHER_H
@@ -5,7 +5,9 @@
 #ifndef PREVIEWPROXYINTERFACE_H
 #define PREVIEWPROXYINTERFACE_H
 
+#include <QImage>
 #include <QObject>
+#include <QVariantHash>
 
 namespace GrandSearch {
 
@@ -16,5 +18,75 @@ inline bool requestUpdateDetailInfo(QObject *proxy, PreviewPlugin *self)
     return QMetaObject::invokeMethod(proxy, "updateDetailInfo", Qt::AutoConnection, Q_ARG(GrandSearch::PreviewPlugin*, self));
 }
 
+// 查询宿主缓存的 UOS AI 安装状态，应在界面线程调用
+inline bool requestUosAiInstalled(QObject *proxy)
+{
+    bool installed = false;
+    if (proxy)
+        QMetaObject::invokeMethod(proxy, "uosAiInstalled", Qt::DirectConnection, Q_RETURN_ARG(bool, installed));
+    return installed;
+}
+
+// 获取宿主的缩略图缓存，插件不自行编译缓存实现，与列表共用同一份内存缓存
+inline QObject *requestThumbnailCache(QObject *proxy)
+{
+    QObject *cache = nullptr;
+    if (proxy)
+        QMetaObject::invokeMethod(proxy, "thumbnailCache", Qt::DirectConnection, Q_RETURN_ARG(QObject*, cache));
+    return cache;
+}
+
+// 读取缓存的缩略图，会访问磁盘，应在工作线程调用
+inline QImage requestCachedThumbnail(QObject *cache, const QString &file, int edge)
+{
+    QImage image;
+    if (cache)
+        QMetaObject::invokeMethod(cache, "cachedImage", Qt::DirectConnection, Q_RETURN_ARG(QImage, image),
+                                  Q_ARG(QString, file), Q_ARG(int, edge));
+    return image;
+}
+
+// 写入缩略图缓存，会访问磁盘，应在工作线程调用
+inline bool requestStoreThumbnail(QObject *cache, const QString &file, int edge, const QImage &image)
+{
+    if (!cache)
+        return false;
+    return QMetaObject::invokeMethod(cache, "storeImage", Qt::DirectConnection,
+                                     Q_ARG(QString, file), Q_ARG(int, edge), Q_ARG(QImage, image));
+}
+
+// 获取宿主的音视频元数据缓存，插件不自行编译缓存实现，与宿主共用同一份内存缓存
+inline QObject *requestMediaMetaCache(QObject *proxy)
+{
+    QObject *cache = nullptr;
+    if (proxy)
+        QMetaObject::invokeMethod(proxy, "mediaMetaCache", Qt::DirectConnection, Q_RETURN_ARG(QObject*, cache));
+    return cache;
+}
+
+// 读取缓存的音视频元数据与预览帧，会访问磁盘，应在工作线程调用
+inline bool requestCachedMediaMeta(QObject *cache, const QString &file, QVariantHash &info, QImage &frame)
+{
+    QVariantHash entry;
+    if (cache)
+        QMetaObject::invokeMethod(cache, "cachedEntry", Qt::DirectConnection, Q_RETURN_ARG(QVariantHash, entry),
+                                  Q_ARG(QString, file));
+    if (entry.isEmpty())
+        return false;
+
+    info = entry.value("info").toHash();
+    frame = entry.value("frame").value<QImage>();
+    return true;
+}
+
+// 写入音视频元数据缓存，会访问磁盘，应在工作线程调用
+inline bool requestStoreMediaMeta(QObject *cache, const QString &file, const QVariantHash &info, const QImage &frame)
+{
+    if (!cache)
+        return false;
+    return QMetaObject::invokeMethod(cache, "storeEntry", Qt::DirectConnection,
+                                     Q_ARG(QString, file), Q_ARG(QVariantHash, info), Q_ARG(QImage, frame));
+}
+
 }
 #endif // PREVIEWPROXYINTERFACE_H
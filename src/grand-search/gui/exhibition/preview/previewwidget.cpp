@@ -5,11 +5,13 @@
 #include "previewwidget.h"
 #include "utils/utils.h"
 #include "utils/highlightprovider.h"
+#include "utils/mimetyperesolver.h"
 #include "generalpreviewplugin.h"
 #include "generalwidget/detailwidget.h"
 #include "generalwidget/generaltoolbar.h"
 #include "generalwidget/aitoolbar.h"
 #include "pluginproxy.h"
+#include "previewprefetcher.h"
 #include "global/builtinsearch.h"
 
 #include <DScrollArea>
@@ -28,12 +30,15 @@
 #include <QScrollBar>
 #include <QToolButton>
 #include <QClipboard>
+#include <QTimer>
 #include <QLoggingCategory>
 
 DWIDGET_USE_NAMESPACE
 using namespace GrandSearch;
 
 #define CONTENT_WIDTH           372
+#define PLUGIN_PRELOAD_DELAY    1500    // 启动后延迟预加载全部预览插件的时间(ms)
+#define PREVIEW_FRAME_INTERVAL  16      // 预览请求合并间隔（一帧，毫秒）
 
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
 
@@ -46,9 +51,21 @@ PreviewWidget::PreviewWidget(QWidget *parent)
     m_generalPreview = QSharedPointer<PreviewPlugin>(new GeneralPreviewPlugin());
     m_generalPreview->init(m_proxy);
 
+    m_prefetcher = new PreviewPrefetcher(&m_pluginManager, this);
+
+    // 按住方向键连续切换时，每帧最多预览一次
+    m_previewTimer = new QTimer(this);
+    m_previewTimer->setSingleShot(true);
+    m_previewTimer->setInterval(PREVIEW_FRAME_INTERVAL);
+
     initUi();
     initConnect();
 
+    // 启动完成后空闲时在后台加载预览插件及其依赖库
+    QTimer::singleShot(PLUGIN_PRELOAD_DELAY, this, [this]() {
+        m_pluginManager.preload();
+    });
+
     qCDebug(logGrandSearch) << "PreviewWidget created successfully";
 }
 
@@ -56,6 +73,10 @@ PreviewWidget::~PreviewWidget()
 {
     qCDebug(logGrandSearch) << "Destroying PreviewWidget";
 
+    // 预取依赖插件管理对象，需在其析构前释放
+    delete m_prefetcher;
+    m_prefetcher = nullptr;
+
     // 解除当前预览插件界面与预览主界面父子窗口关系，所有预览插件界面统一由插件管理类析构函数释放
     clearLayoutWidgets();
     if (m_vSpaceItem) {
@@ -69,17 +90,22 @@ bool PreviewWidget::previewItem(const MatchedItem &item)
     qCDebug(logGrandSearch) << "Previewing item:" << item.name << "Type:" << item.type;
 
     m_item = item;
+    m_mimeType = MimeTypeResolver::instance()->mimeType(item.item, item.type);
 
-    QSharedPointer<PreviewPlugin> preview = QSharedPointer<PreviewPlugin>(m_pluginManager.getPreviewPlugin(item));
+    // 同类文件复用已创建的插件界面，切换结果时不重建界面部件
+    QSharedPointer<PreviewPlugin> preview = m_pluginManager.getPreviewPlugin(item, m_proxy);
 
     if (!preview) {
         qCDebug(logGrandSearch) << "Using general preview plugin";
         preview = m_generalPreview;
     } else {
         qCDebug(logGrandSearch) << "Using specific preview plugin";
-        preview->init(m_proxy);
     }
 
+    // 复用当前插件界面时，先结束上一项的预览
+    if (preview == m_preview)
+        preview->stopPreview();
+
     // 插件界面根据新来搜索结果刷新预览内容
     ItemInfo itemInfo;
     itemInfo[PREVIEW_ITEMINFO_ITEM] = item.item;
@@ -176,6 +202,72 @@ bool PreviewWidget::previewItem(const MatchedItem &item)
     return true;
 }
 
+void PreviewWidget::requestPreview(const MatchedItem &item)
+{
+    if (!m_previewTimer->isActive()) {
+        // 距上次预览已超过一帧，立即预览，并开始新的合并周期
+        m_hasPendingItem = false;
+        m_previewTimer->start();
+        previewItem(item);
+        return;
+    }
+
+    // 切换到其他项时，上一项已无须继续解码
+    if (m_preview && !m_hasPendingItem && (item.item != m_item.item || item.searcher != m_item.searcher))
+        m_preview->stopPreview();
+
+    m_pendingItem = item;
+    m_hasPendingItem = true;
+}
+
+void PreviewWidget::cancelPreview()
+{
+    m_previewTimer->stop();
+    m_hasPendingItem = false;
+    m_pendingItem = MatchedItem();
+
+    if (m_preview)
+        m_preview->stopPreview();
+}
+
+void PreviewWidget::flushPendingPreview()
+{
+    if (!m_hasPendingItem)
+        return;
+
+    const MatchedItem item = m_pendingItem;
+    m_hasPendingItem = false;
+    m_pendingItem = MatchedItem();
+
+    // 本帧内有新的预览，下一帧的请求继续合并
+    m_previewTimer->start();
+    previewItem(item);
+}
+
+void PreviewWidget::preloadPlugins(const QStringList &mimeTypes)
+{
+    if (!mimeTypes.isEmpty())
+        m_pluginManager.preload(mimeTypes);
+}
+
+void PreviewWidget::prefetchItems(const MatchedItems &items)
+{
+    // 当前预览项已在加载，无需预取
+    MatchedItems pending;
+    const MatchedItem &current = m_hasPendingItem ? m_pendingItem : m_item;
+    for (const MatchedItem &item : items) {
+        if (item.item != current.item || item.searcher != current.searcher)
+            pending.append(item);
+    }
+
+    m_prefetcher->prefetch(pending);
+}
+
+void PreviewWidget::cancelPrefetch()
+{
+    m_prefetcher->cancel();
+}
+
 void PreviewWidget::initUi()
 {
     m_vMainLayout = new QVBoxLayout(this);
@@ -197,10 +289,25 @@ void PreviewWidget::initConnect()
     connect(m_generalToolBar, &GeneralToolBar::sigOpenClicked, this, &PreviewWidget::onOpenClicked);
     connect(m_generalToolBar, &GeneralToolBar::sigOpenPathClicked, this, &PreviewWidget::onOpenpathClicked);
     connect(m_generalToolBar, &GeneralToolBar::sigCopyPathClicked, this, &PreviewWidget::onCopypathClicked);
+    connect(m_previewTimer, &QTimer::timeout, this, &PreviewWidget::flushPendingPreview);
 
     // 连接高亮内容获取完成信号
     connect(HighlightProvider::instance(), &HighlightProvider::highlightReady,
-            this, &PreviewWidget::updateHighlightContent);
+            this, [this](const QString &keyword, const QString &filePath, const QString &content) {
+                Q_UNUSED(keyword)
+                updateHighlightContent(filePath, content);
+            });
+
+    // 当前预览项的类型探测完成且与占位类型不同时，按最终类型重新选择预览插件
+    connect(MimeTypeResolver::instance(), &MimeTypeResolver::mimeTypeResolved,
+            this, [this](const QString &filePath, const QString &mimeType) {
+                // 有等待中的预览请求时，当前项即将被替换，无须重新预览
+                if (m_hasPendingItem || filePath != m_item.item || !m_item.type.isEmpty() || mimeType == m_mimeType)
+                    return;
+
+                qCDebug(logGrandSearch) << "MIME type resolved, previewing again:" << filePath << mimeType;
+                previewItem(m_item);
+            });
 }
 
 void PreviewWidget::clearLayoutWidgets()
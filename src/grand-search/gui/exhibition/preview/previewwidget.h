@@ -12,6 +12,7 @@
 
 class QVBoxLayout;
 class QSpacerItem;
+class QTimer;
 
 namespace GrandSearch {
 
@@ -19,6 +20,7 @@ class GeneralToolBar;
 class AiToolBar;
 class DetailWidget;
 class PluginProxy;
+class PreviewPrefetcher;
 class PreviewWidget : public Dtk::Widget::DWidget
 {
     Q_OBJECT
@@ -30,6 +32,16 @@ public:
     // 预览指定搜索项
     bool previewItem(const MatchedItem &item);
 
+    /**
+     * @brief 请求预览指定搜索项
+     * 空闲时立即预览；一帧内的后续请求只保留最后一项，在帧末预览，
+     * 被替换的请求不会加载，当前插件尚未完成的解码随即取消
+     * @param item 搜索项
+     */
+    void requestPreview(const MatchedItem &item);
+    // 放弃尚未执行的预览请求，并结束当前插件的解码
+    void cancelPreview();
+
     /**
      * @brief 更新当前预览项的高亮内容
      * 当 HighlightProvider 异步获取到高亮内容时调用
@@ -38,10 +50,19 @@ public:
      */
     void updateHighlightContent(const QString &filePath, const QString &content);
 
+    // 后台预加载可预览给定类型的插件，用于当前显示的搜索结果
+    void preloadPlugins(const QStringList &mimeTypes);
+
+    // 预取即将预览的搜索项，替换尚未完成的预取
+    void prefetchItems(const MatchedItems &items);
+    // 放弃全部预取，搜索结果变化时调用
+    void cancelPrefetch();
+
 private:
     void initUi();
     void initConnect();
     void clearLayoutWidgets();
+    void flushPendingPreview();
     int calculateContentHeight(bool hasDetailInfo, bool showAiToolBar) const;
 
     void onOpenClicked();
@@ -60,10 +81,15 @@ private:
     GeneralToolBar *m_generalToolBar = nullptr;     // 通用工具栏部件
     AiToolBar *m_aiToolBar = nullptr;     // AI工具栏部件
     PluginProxy *m_proxy = nullptr; //用于预览插件回调预览框架的接口
+    PreviewPrefetcher *m_prefetcher = nullptr; //预取相邻搜索项的预览数据
+    QTimer *m_previewTimer = nullptr; //按帧合并预览请求
 
 
 private:
     MatchedItem m_item; //当前正在预览的匹配结果
+    MatchedItem m_pendingItem; //等待帧末预览的匹配结果
+    bool m_hasPendingItem = false;
+    QString m_mimeType; //选择预览插件时使用的类型，可能为占位类型
     PreviewPluginManager m_pluginManager; //预览插件管理对象
 };
 
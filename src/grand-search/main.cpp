@@ -12,6 +12,7 @@
 #include "business/matchresult/matchcontroller.h"
 #include "contacts/services/grandsearchservice.h"
 #include "business/config/accessrecord/accessrecord.h"
+#include "utils/utils.h"
 
 #include "services/grandsearchserviceadaptor.h"
 
@@ -119,6 +120,9 @@ int main(int argc, char *argv[])
         QTimer::singleShot(0, &mainWindow, [&mainWindow]() {
             // 界面初始化完成后，再处理与业务有关的连接
             mainWindow.connectToController();
+
+            // 后台预热常见文件类型的默认应用图标
+            Utils::warmUpAppIcons();
         });
 
         // 注册dbus服务
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mediathumbnailgenerator.h"
+#include "utils/mediametacache.h"
+
+#include <QDebug>
+#include <QImage>
+
+namespace GrandSearch {
+
+bool MediaThumbnailGenerator::canHandle(const QString &mimetype) const
+{
+    return mimetype.startsWith("video/");
+}
+
+QPixmap MediaThumbnailGenerator::generate(const QString &filePath, const QSize &size)
+{
+    if (filePath.isEmpty() || size.isEmpty()) {
+        return QPixmap();
+    }
+
+    MediaMetaCache::Entry entry;
+    if (!MediaMetaCache::instance()->find(filePath, entry) || entry.frame.isNull()) {
+        return QPixmap();
+    }
+
+    QImage image = entry.frame;
+    if (image.width() > size.width() || image.height() > size.height()) {
+        image = image.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return QPixmap::fromImage(image);
+}
+
+QStringList MediaThumbnailGenerator::supportedMimeTypes() const
+{
+    return {
+        "video/mp4",
+        "video/x-matroska",
+        "video/webm",
+        "video/quicktime",
+        "video/x-msvideo",
+        "video/x-flv",
+        "video/mpeg"
+    };
+}
+
+}   // namespace GrandSearch
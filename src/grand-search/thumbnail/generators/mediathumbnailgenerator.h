@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MEDIATHUMBNAILGENERATOR_H
+#define MEDIATHUMBNAILGENERATOR_H
+
+#include "../thumbnailgenerator.h"
+
+namespace GrandSearch {
+
+/**
+ * @brief 视频缩略图生成器
+ *
+ * 不解码视频，仅使用视频预览插件写入 MediaMetaCache 的预览帧。
+ * 未预览过的视频没有缓存，生成失败，列表中仍显示文件图标。
+ */
+class MediaThumbnailGenerator : public ThumbnailGenerator
+{
+public:
+    MediaThumbnailGenerator() = default;
+    ~MediaThumbnailGenerator() override = default;
+
+    bool canHandle(const QString &mimetype) const override;
+    QPixmap generate(const QString &filePath, const QSize &size) override;
+    int priority() const override { return 5; }
+    QString name() const override { return QStringLiteral("MediaThumbnailGenerator"); }
+    QStringList supportedMimeTypes() const override;
+};
+
+}   // namespace GrandSearch
+
+#endif   // MEDIATHUMBNAILGENERATOR_H
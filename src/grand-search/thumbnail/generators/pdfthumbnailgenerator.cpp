@@ -0,0 +1,44 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "pdfthumbnailgenerator.h"
+#include "../thumbnail.h"
+
+namespace GrandSearch {
+
+bool PdfThumbnailGenerator::canHandle(const QString &mimetype) const
+{
+    return mimetype == "application/pdf";
+}
+
+QPixmap PdfThumbnailGenerator::generate(const QString &filePath, const QSize &size)
+{
+    if (filePath.isEmpty() || size.isEmpty()) {
+        return QPixmap();
+    }
+
+    // 请求的尺寸等级已由任务管理器查询过，此处查找更大的尺寸等级
+    for (ThumbnailSize level : { ThumbnailSize::Large, ThumbnailSize::XLarge }) {
+        const QSize box = ThumbnailCache::enumToSize(level);
+        if (box.width() <= size.width() && box.height() <= size.height()) {
+            continue;
+        }
+
+        QPixmap pixmap = ThumbnailCache::instance()->get(filePath, level);
+        if (pixmap.isNull()) {
+            continue;
+        }
+
+        return pixmap.scaled(size, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return QPixmap();
+}
+
+QStringList PdfThumbnailGenerator::supportedMimeTypes() const
+{
+    return { "application/pdf" };
+}
+
+}   // namespace GrandSearch
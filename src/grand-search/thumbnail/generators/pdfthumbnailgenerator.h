@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef PDFTHUMBNAILGENERATOR_H
+#define PDFTHUMBNAILGENERATOR_H
+
+#include "../thumbnailgenerator.h"
+
+namespace GrandSearch {
+
+/**
+ * @brief PDF 缩略图生成器
+ *
+ * 不解析文档，仅使用 PDF 预览插件写入缩略图缓存的首页渲染结果。
+ * 请求尺寸等级未命中时，缩放更大尺寸等级中的缓存；均未命中时生成失败，列表中仍显示文件图标。
+ */
+class PdfThumbnailGenerator : public ThumbnailGenerator
+{
+public:
+    PdfThumbnailGenerator() = default;
+    ~PdfThumbnailGenerator() override = default;
+
+    bool canHandle(const QString &mimetype) const override;
+    QPixmap generate(const QString &filePath, const QSize &size) override;
+    int priority() const override { return 5; }
+    QString name() const override { return QStringLiteral("PdfThumbnailGenerator"); }
+    QStringList supportedMimeTypes() const override;
+};
+
+}   // namespace GrandSearch
+
+#endif   // PDFTHUMBNAILGENERATOR_H
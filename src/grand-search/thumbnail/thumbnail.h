@@ -37,6 +37,8 @@ enum class ThumbnailSize {
 // 内置生成器
 #include "generators/imagethumbnailgenerator.h"
 #include "generators/textthumbnailgenerator.h"
+#include "generators/mediathumbnailgenerator.h"
+#include "generators/pdfthumbnailgenerator.h"
 
 namespace GrandSearch {
 
@@ -51,9 +53,13 @@ inline void initThumbnailModule()
     // 注册内置生成器
     static ImageThumbnailGenerator imageGenerator;
     static TextThumbnailGenerator textGenerator;
+    static MediaThumbnailGenerator mediaGenerator;
+    static PdfThumbnailGenerator pdfGenerator;
 
     ThumbnailProvider::instance()->registerGenerator(&imageGenerator);
     ThumbnailProvider::instance()->registerGenerator(&textGenerator);
+    ThumbnailProvider::instance()->registerGenerator(&mediaGenerator);
+    ThumbnailProvider::instance()->registerGenerator(&pdfGenerator);
 }
 
 }   // namespace GrandSearch
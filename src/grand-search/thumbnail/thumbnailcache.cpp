@@ -5,6 +5,7 @@
 #include "thumbnailcache.h"
 #include "global/commontools.h"
 
+#include <QCoreApplication>
 #include <QCryptographicHash>
 #include <QDir>
 #include <QFile>
@@ -13,6 +14,7 @@
 #include <QImageReader>
 #include <QPixmap>
 #include <QStandardPaths>
+#include <QThread>
 #include <QUrl>
 
 namespace GrandSearch {
@@ -24,18 +26,23 @@ constexpr const char *MTime = "Thumb::MTime";
 constexpr const char *Path = "Thumb::Path";
 }   // namespace Thumb
 
-ThumbnailCache *ThumbnailCache::s_instance = nullptr;
+// 内存缓存默认容量：64MB，约 64 张 512x512 的 ARGB32 缩略图
+static constexpr int kDefaultMemoryCacheBytes = 64 * 1024 * 1024;
 
 ThumbnailCache::ThumbnailCache(QObject *parent)
-    : QObject(parent), m_maxMemoryCacheItems(100)   // 默认缓存 100 个缩略图
+    : QObject(parent), m_maxMemoryCacheBytes(kDefaultMemoryCacheBytes)
 {
     // 设置缓存目录：使用文管的标准路径 ~/.cache/thumbnails
     m_cacheDir = QDir::homePath() + "/.cache/thumbnails";
 
     ensureCacheDirExists();
 
-    // 设置内存缓存最大条目数
-    m_memoryCache.setMaxCost(m_maxMemoryCacheItems);
+    // 设置内存缓存容量
+    m_memoryCache.setMaxCost(m_maxMemoryCacheBytes);
+
+    // 首次访问可能发生在工作线程，对象始终归属主线程
+    if (qApp && thread() != qApp->thread())
+        moveToThread(qApp->thread());
 }
 
 ThumbnailCache::~ThumbnailCache()
@@ -45,24 +52,43 @@ ThumbnailCache::~ThumbnailCache()
 
 ThumbnailCache *ThumbnailCache::instance()
 {
-    if (!s_instance) {
-        s_instance = new ThumbnailCache();
-    }
-    return s_instance;
+    // 局部静态变量的初始化是线程安全的，解码线程并发首次访问时只会构造一次
+    static ThumbnailCache ins;
+    return &ins;
+}
+
+QImage ThumbnailCache::cachedImage(const QString &filePath, int edge)
+{
+    const QPixmap pixmap = get(filePath, sizeToEnum(QSize(edge, edge)));
+    return pixmap.isNull() ? QImage() : pixmap.toImage();
+}
+
+void ThumbnailCache::storeImage(const QString &filePath, int edge, const QImage &image)
+{
+    if (image.isNull())
+        return;
+
+    put(filePath, sizeToEnum(QSize(edge, edge)), QPixmap::fromImage(image));
 }
 
 QString ThumbnailCache::cacheKey(const QString &filePath, const ThumbnailSize &size)
 {
-    // 使用文件 URL 的 MD5 作为缓存键（与文管保持一致）
+    // 同一文件的各尺寸等级在内存中分别缓存，避免以小图冒充大图
+    return urlHash(filePath) + QLatin1Char('@') + QString::number(static_cast<int>(size));
+}
+
+QString ThumbnailCache::urlHash(const QString &filePath) const
+{
+    // 使用文件 URL 的 MD5 作为缓存文件名（与文管保持一致）
     QString fileUrl = filePathToUrl(filePath);
     return QString::fromLatin1(QCryptographicHash::hash(fileUrl.toUtf8(), QCryptographicHash::Md5).toHex());
 }
 
 QString ThumbnailCache::cacheFilePath(const QString &filePath, const ThumbnailSize &size)
 {
-    QString key = cacheKey(filePath, size);
+    // 尺寸等级由目录区分，文件名只取 URL 的 MD5
     QString dirPath = sizeToDirPath(size);
-    return dirPath + "/" + key + ".png";
+    return dirPath + "/" + urlHash(filePath) + ".png";
 }
 
 void ThumbnailCache::ensureCacheDirExists()
@@ -86,41 +112,49 @@ void ThumbnailCache::ensureCacheDirExists()
 
 QPixmap ThumbnailCache::get(const QString &filePath, const ThumbnailSize &size)
 {
-    QMutexLocker locker(&m_mutex);
-
     QString key = cacheKey(filePath, size);
 
     // 1. 先检查内存缓存
-    if (m_memoryCache.contains(key)) {
-        return *m_memoryCache.object(key);
+    {
+        QMutexLocker locker(&m_mutex);
+        if (QPixmap *cached = m_memoryCache.object(key))
+            return *cached;
     }
 
-    // 2. 检查磁盘缓存
+    // 2. 检查磁盘缓存，磁盘 I/O 不持锁
     QString diskPath = cacheFilePath(filePath, size);
-    if (QFile::exists(diskPath)) {
-        // 读取图片并验证元数据
-        QImageReader reader(diskPath, "PNG");
-        if (!reader.canRead()) {
-            return QPixmap();
-        }
+    if (!QFile::exists(diskPath))
+        return QPixmap();
 
-        QImage image = reader.read();
-        if (image.isNull()) {
-            return QPixmap();
-        }
+    QImageReader reader(diskPath, "PNG");
+    if (!reader.canRead())
+        return QPixmap();
 
-        // 验证元数据中的 MTime
-        bool cacheValid = !isCacheExpired(filePath, diskPath, image);
+    // 仅读取 PNG 文本块验证元数据中的 MTime，过期的缓存不解码
+    if (isMTimeExpired(filePath, reader.text(Thumb::MTime)))
+        return QPixmap();
 
-        if (cacheValid) {
-            QPixmap pixmap = QPixmap::fromImage(image);
-            if (!pixmap.isNull()) {
-                // 存入内存缓存
-                m_memoryCache.insert(key, new QPixmap(pixmap));
-                return pixmap;
-            }
-        }
-    }
+    QImage image = reader.read();
+    if (image.isNull())
+        return QPixmap();
+
+    QPixmap pixmap = QPixmap::fromImage(image);
+    if (pixmap.isNull())
+        return QPixmap();
+
+    // 存入内存缓存
+    QMutexLocker locker(&m_mutex);
+    m_memoryCache.insert(key, new QPixmap(pixmap), pixmapCost(pixmap));
+    return pixmap;
+}
+
+QPixmap ThumbnailCache::getFromMemory(const QString &filePath, const ThumbnailSize &size)
+{
+    QString key = cacheKey(filePath, size);
+
+    QMutexLocker locker(&m_mutex);
+    if (QPixmap *cached = m_memoryCache.object(key))
+        return *cached;
 
     return QPixmap();
 }
@@ -131,14 +165,15 @@ void ThumbnailCache::put(const QString &filePath, const ThumbnailSize &size, con
         return;
     }
 
-    QMutexLocker locker(&m_mutex);
-
     QString key = cacheKey(filePath, size);
 
     // 1. 存入内存缓存
-    m_memoryCache.insert(key, new QPixmap(thumbnail));
+    {
+        QMutexLocker locker(&m_mutex);
+        m_memoryCache.insert(key, new QPixmap(thumbnail), pixmapCost(thumbnail));
+    }
 
-    // 2. 存入磁盘缓存（添加元数据）
+    // 2. 存入磁盘缓存（添加元数据），编码与写盘不持锁
     QString diskPath = cacheFilePath(filePath, size);
 
     // 获取文件修改时间
@@ -152,56 +187,58 @@ void ThumbnailCache::put(const QString &filePath, const ThumbnailSize &size, con
     image.setText(Thumb::URL, fileUrl);
     image.setText(Thumb::MTime, QString::number(mtime));
 
-    // 保存为 PNG
-    image.save(diskPath, "PNG");
+    // 先写临时文件再重命名，避免其他线程读到写了一半的 PNG
+    QString tmpPath = diskPath + QString(".%1.tmp").arg(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+    if (image.save(tmpPath, "PNG")) {
+        QFile::remove(diskPath);
+        if (!QFile::rename(tmpPath, diskPath))
+            QFile::remove(tmpPath);
+    }
 }
 
 bool ThumbnailCache::exists(const QString &filePath, const ThumbnailSize &size)
 {
-    QMutexLocker locker(&m_mutex);
     QString key = cacheKey(filePath, size);
 
     // 检查内存缓存
-    if (m_memoryCache.contains(key)) {
-        return true;
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_memoryCache.contains(key))
+            return true;
     }
 
-    // 检查磁盘缓存
+    // 检查磁盘缓存，仅读取文本块验证元数据
     QString diskPath = cacheFilePath(filePath, size);
-    if (QFile::exists(diskPath)) {
-        // 读取并验证元数据
-        QImageReader reader(diskPath, "PNG");
-        if (reader.canRead()) {
-            QImage image = reader.read();
-            if (!image.isNull()) {
-                return !isCacheExpired(filePath, diskPath, image);
-            }
-        }
-    }
+    if (!QFile::exists(diskPath))
+        return false;
 
-    return false;
+    QImageReader reader(diskPath, "PNG");
+    return reader.canRead() && !isMTimeExpired(filePath, reader.text(Thumb::MTime));
 }
 
 bool ThumbnailCache::isCacheExpired(const QString &filePath, const QString &cachePath)
 {
-    // 兼容旧版本调用，读取图片后调用新版本
+    // 仅读取 PNG 文本块，不解码图片
     QImageReader reader(cachePath, "PNG");
     if (!reader.canRead()) {
         return true;
     }
 
-    QImage image = reader.read();
-    return isCacheExpired(filePath, cachePath, image);
+    return isMTimeExpired(filePath, reader.text(Thumb::MTime));
 }
 
 bool ThumbnailCache::isCacheExpired(const QString &filePath, const QString &cachePath, const QImage &cacheImage)
+{
+    Q_UNUSED(cachePath)
+    return isMTimeExpired(filePath, cacheImage.text(Thumb::MTime));
+}
+
+bool ThumbnailCache::isMTimeExpired(const QString &filePath, const QString &mtimeStr) const
 {
     if (!QFile::exists(filePath)) {
         return true;
     }
 
-    // 从元数据中获取 MTime
-    QString mtimeStr = cacheImage.text(Thumb::MTime);
     if (mtimeStr.isEmpty()) {
         // 没有元数据的缓存文件无效，需要重新生成
         return true;
@@ -215,6 +252,12 @@ bool ThumbnailCache::isCacheExpired(const QString &filePath, const QString &cach
     return sourceMTime > cachedMTime;
 }
 
+int ThumbnailCache::pixmapCost(const QPixmap &pixmap)
+{
+    // 至少为 1，避免空图占用为 0 导致缓存无上限
+    return qMax(1, pixmap.width() * pixmap.height() * qMax(1, pixmap.depth() / 8));
+}
+
 void ThumbnailCache::clearMemoryCache()
 {
     QMutexLocker locker(&m_mutex);
@@ -242,11 +285,11 @@ void ThumbnailCache::clearDiskCache()
     }
 }
 
-void ThumbnailCache::setMaxMemoryCacheItems(int maxItems)
+void ThumbnailCache::setMaxMemoryCacheBytes(int maxBytes)
 {
     QMutexLocker locker(&m_mutex);
-    m_maxMemoryCacheItems = maxItems;
-    m_memoryCache.setMaxCost(maxItems);
+    m_maxMemoryCacheBytes = maxBytes;
+    m_memoryCache.setMaxCost(maxBytes);
 }
 
 ThumbnailSize ThumbnailCache::sizeToEnum(const QSize &size)
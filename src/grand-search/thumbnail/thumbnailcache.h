@@ -21,11 +21,11 @@ namespace GrandSearch {
  * @brief 缩略图缓存管理器
  *
  * 实现两级缓存机制：
- * 1. 内存缓存：使用 QCache 存储最近使用的缩略图
+ * 1. 内存缓存：使用 QCache 存储最近使用的缩略图，容量按像素数据字节数计算
  * 2. 磁盘缓存：遵循 XDG 标准，存储在 ~/.cache/thumbnails/
  *    与文管（dde-file-manager）共用缩略图缓存
  *
- * 缓存文件命名使用文件 URL 的 MD5 哈希。
+ * 缓存文件命名使用文件 URL 的 MD5 哈希，内存缓存键另附尺寸等级。
  */
 class ThumbnailCache : public QObject
 {
@@ -38,14 +38,44 @@ public:
      */
     static ThumbnailCache *instance();
 
+    /**
+     * @brief 按缩略图边长获取缓存的缩略图，供预览插件通过宿主代理调用
+     *
+     * 预览插件不直接链接缓存实现，经由 PluginProxy::thumbnailCache 取得宿主的唯一实例，
+     * 在工作线程中以 Qt::DirectConnection 调用，与列表共用内存缓存和磁盘缓存。
+     * @param filePath 文件路径
+     * @param edge 缩略图边长，映射到不小于该值的 XDG 尺寸
+     * @return 缓存的缩略图，不存在时返回空 QImage
+     */
+    Q_INVOKABLE QImage cachedImage(const QString &filePath, int edge);
+
+    /**
+     * @brief 按缩略图边长存入缩略图，供预览插件通过宿主代理调用
+     * @param filePath 文件路径
+     * @param edge 缩略图边长
+     * @param image 缩略图
+     */
+    Q_INVOKABLE void storeImage(const QString &filePath, int edge, const QImage &image);
+
     /**
      * @brief 从缓存获取缩略图
+     *
+     * 先查内存缓存，未命中时读取磁盘缓存。磁盘缓存仅读取 PNG 文本块校验 MTime，
+     * 校验通过后才解码图片。涉及磁盘 I/O，不应在 GUI 线程调用。
      * @param filePath 文件路径
      * @param size 缩略图尺寸
      * @return 缓存的缩略图，如果不存在返回空 QPixmap
      */
     QPixmap get(const QString &filePath, const ThumbnailSize &size);
 
+    /**
+     * @brief 仅从内存缓存获取缩略图，不访问磁盘，可在 GUI 线程调用
+     * @param filePath 文件路径
+     * @param size 缩略图尺寸
+     * @return 缓存的缩略图，如果不存在返回空 QPixmap
+     */
+    QPixmap getFromMemory(const QString &filePath, const ThumbnailSize &size);
+
     /**
      * @brief 将缩略图存入缓存
      * @param filePath 文件路径
@@ -55,7 +85,7 @@ public:
     void put(const QString &filePath, const ThumbnailSize &size, const QPixmap &thumbnail);
 
     /**
-     * @brief 检查缓存是否存在
+     * @brief 检查缓存是否存在（磁盘缓存仅读取 PNG 文本块，不解码图片）
      * @param filePath 文件路径
      * @param size 缩略图尺寸
      * @return 如果缓存存在返回 true，否则返回 false
@@ -87,10 +117,10 @@ public:
     void clearDiskCache();
 
     /**
-     * @brief 设置内存缓存最大条目数
-     * @param maxItems 最大条目数
+     * @brief 设置内存缓存容量
+     * @param maxBytes 最大字节数，按缩略图像素数据大小计算
      */
-    void setMaxMemoryCacheItems(int maxItems);
+    void setMaxMemoryCacheBytes(int maxBytes);
 
     /**
      * @brief 获取缓存文件路径
@@ -126,13 +156,35 @@ private:
     ThumbnailCache &operator=(const ThumbnailCache &) = delete;
 
     /**
-     * @brief 生成缓存键
+     * @brief 生成内存缓存键，包含尺寸等级
      * @param filePath 文件路径
      * @param size 缩略图尺寸
      * @return 缓存键
      */
     QString cacheKey(const QString &filePath, const ThumbnailSize &size);
 
+    /**
+     * @brief 计算文件 URL 的 MD5，用作磁盘缓存文件名
+     * @param filePath 文件路径
+     * @return MD5 十六进制字符串
+     */
+    QString urlHash(const QString &filePath) const;
+
+    /**
+     * @brief 根据 PNG 元数据中的 MTime 判断缓存是否过期
+     * @param filePath 原始文件路径
+     * @param mtimeStr 元数据中的 MTime
+     * @return 如果缓存过期返回 true，否则返回 false
+     */
+    bool isMTimeExpired(const QString &filePath, const QString &mtimeStr) const;
+
+    /**
+     * @brief 计算缩略图在内存缓存中的开销
+     * @param pixmap 缩略图
+     * @return 像素数据字节数
+     */
+    static int pixmapCost(const QPixmap &pixmap);
+
     /**
      * @brief 确保缓存目录存在
      */
@@ -153,12 +205,10 @@ private:
     QString filePathToUrl(const QString &filePath) const;
 
 private:
-    static ThumbnailCache *s_instance;
-
-    QCache<QString, QPixmap> m_memoryCache;   // 内存缓存
-    QMutex m_mutex;   // 线程安全锁
+    QCache<QString, QPixmap> m_memoryCache;   // 内存缓存，开销按字节计算
+    QMutex m_mutex;   // 内存缓存锁，不在持锁期间进行磁盘 I/O
     QString m_cacheDir;   // 磁盘缓存根目录 (~/.cache/thumbnails)
-    int m_maxMemoryCacheItems;   // 内存缓存最大条目数
+    int m_maxMemoryCacheBytes;   // 内存缓存最大字节数
 };
 
 }   // namespace GrandSearch
@@ -23,6 +23,8 @@ ThumbnailProvider::ThumbnailProvider(QObject *parent)
             this, &ThumbnailProvider::onThumbnailReady);
     connect(ThumbnailTaskManager::instance(), &ThumbnailTaskManager::thumbnailFailed,
             this, &ThumbnailProvider::onThumbnailFailed);
+    connect(ThumbnailTaskManager::instance(), &ThumbnailTaskManager::thumbnailCanceled,
+            this, &ThumbnailProvider::thumbnailCanceled);
 }
 
 ThumbnailProvider::~ThumbnailProvider()
@@ -87,23 +89,24 @@ ThumbnailGenerator *ThumbnailProvider::findGenerator(const QString &mimetype) co
     return nullptr;
 }
 
-void ThumbnailProvider::requestThumbnail(const QString &filePath, const QString &mimetype,
-                                         const ThumbnailSize &size, int priority)
+bool ThumbnailProvider::requestThumbnail(const QString &filePath, const QString &mimetype,
+                                         const ThumbnailSize &size, int priority,
+                                         const void *owner)
 {
     // 检查是否有生成器支持
     if (!isSupported(mimetype)) {
         emit thumbnailFailed(filePath);
-        return;
+        return true;
     }
 
-    // 先检查缓存
-    QPixmap cached = ThumbnailCache::instance()->get(filePath, size);
+    // 先检查内存缓存，磁盘缓存在工作线程中读取
+    QPixmap cached = ThumbnailCache::instance()->getFromMemory(filePath, size);
     if (!cached.isNull()) {
         emit thumbnailReady(filePath, cached);
-        return;
+        return true;
     }
 
-    ThumbnailTaskManager::instance()->submit(filePath, mimetype, size, priority);
+    return !ThumbnailTaskManager::instance()->submit(filePath, mimetype, size, priority, owner).isEmpty();
 }
 
 QPixmap ThumbnailProvider::getThumbnailSync(const QString &filePath, const QString &mimetype,
@@ -134,9 +137,12 @@ QPixmap ThumbnailProvider::getThumbnailSync(const QString &filePath, const QStri
     return thumbnail;
 }
 
-void ThumbnailProvider::cancelRequest(const QString &filePath)
+void ThumbnailProvider::cancelRequest(const QString &filePath, const void *owner)
 {
-    ThumbnailTaskManager::instance()->cancelByFilePath(filePath);
+    if (owner)
+        ThumbnailTaskManager::instance()->cancelByOwner(filePath, owner);
+    else
+        ThumbnailTaskManager::instance()->cancelByFilePath(filePath);
 }
 
 bool ThumbnailProvider::isSupported(const QString &mimetype) const
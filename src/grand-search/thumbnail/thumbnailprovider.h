@@ -56,13 +56,16 @@ public:
      * @param filePath 文件路径
      * @param mimetype MIME 类型
      * @param size 目标尺寸
-     * @param priority 优先级
+     * @param priority 优先级，见 ThumbnailTaskManager::Priority
+     * @param owner 请求方标识，用于 cancelRequest 撤销本方请求
      *
      * 此方法会先检查缓存，如果缓存存在则直接发送 thumbnailReady 信号。
      * 否则提交异步任务生成缩略图。
+     * @return 任务表已满而未能提交时返回 false，此时不会有结果信号
      */
-    void requestThumbnail(const QString &filePath, const QString &mimetype,
-                          const ThumbnailSize &size, int priority = 0);
+    bool requestThumbnail(const QString &filePath, const QString &mimetype,
+                          const ThumbnailSize &size, int priority = 0,
+                          const void *owner = nullptr);
 
     /**
      * @brief 同步获取缩略图（阻塞）
@@ -79,8 +82,10 @@ public:
     /**
      * @brief 取消指定文件的缩略图请求
      * @param filePath 文件路径
+     * @param owner 请求方标识，为空时取消该文件的所有请求；
+     *              否则仅撤销该请求方，无其他请求方时才取消任务
      */
-    void cancelRequest(const QString &filePath);
+    void cancelRequest(const QString &filePath, const void *owner = nullptr);
 
     /**
      * @brief 检查是否支持指定 mimetype
@@ -109,6 +114,13 @@ signals:
      */
     void thumbnailFailed(const QString &filePath);
 
+    /**
+     * @brief 缩略图任务被取消信号，见 ThumbnailTaskManager::thumbnailCanceled
+     * @param filePath 文件路径
+     * @param owner 请求方标识
+     */
+    void thumbnailCanceled(const QString &filePath, const void *owner);
+
 private slots:
     /**
      * @brief 处理任务管理器的完成信号
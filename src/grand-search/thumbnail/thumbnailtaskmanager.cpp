@@ -45,74 +45,157 @@ QString ThumbnailTaskManager::generateTaskId(const QString &filePath, const Thum
 }
 
 QString ThumbnailTaskManager::submit(const QString &filePath, const QString &mimetype,
-                                     const ThumbnailSize &size, int priority)
+                                     const ThumbnailSize &size, int priority, const void *owner)
 {
     QMutexLocker locker(&m_mutex);
 
     QString taskId = generateTaskId(filePath, size);
 
-    // 检查是否已有相同任务
-    if (m_pendingTasks.contains(taskId)) {
+    // 检查是否已有相同任务：合并请求方，尚未开始的任务按更高优先级重新排队
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end()) {
+        it->owners.insert(owner);
+        if (priority > it->priority && it->runnable && m_threadPool->tryTake(it->runnable)) {
+            delete it->runnable;
+            it->runnable = nullptr;
+            it->priority = priority;
+            enqueueLocked(taskId, *it);
+        }
         return taskId;
     }
 
-    // 检查缓存是否已存在
-    if (ThumbnailCache::instance()->exists(filePath, size)) {
-        QPixmap cached = ThumbnailCache::instance()->get(filePath, size);
-        if (!cached.isNull()) {
-            // 异步发送信号，避免死锁
-            QMetaObject::invokeMethod(
-                    this, [this, filePath, cached]() {
-                        emit thumbnailReady(filePath, cached);
-                    },
-                    Qt::QueuedConnection);
-        }
+    // 仅检查内存缓存，磁盘缓存由工作线程读取
+    QPixmap cached = ThumbnailCache::instance()->getFromMemory(filePath, size);
+    if (!cached.isNull()) {
+        // 异步发送信号，避免死锁
+        QMetaObject::invokeMethod(
+                this, [this, filePath, cached]() {
+                    emit thumbnailReady(filePath, cached);
+                },
+                Qt::QueuedConnection);
         return taskId;
     }
 
+    // 任务表已满时只允许更高优先级的任务挤掉排队中的低优先级任务
+    if (m_tasks.size() >= kMaxTaskCount && !evictLocked(priority))
+        return QString();
+
     // 创建任务
     ThumbnailTask task(filePath, mimetype, size, priority);
+    task.owners.insert(owner);
+    enqueueLocked(taskId, task);
     m_tasks.insert(taskId, task);
-    m_pendingTasks.insert(taskId);
 
-    // 创建工作线程并提交
-    ThumbnailWorker *worker = new ThumbnailWorker(task, this);
+    return taskId;
+}
+
+void ThumbnailTaskManager::enqueueLocked(const QString &taskId, ThumbnailTask &task)
+{
+    // 工作对象持有任务副本，取消标记通过 shared_ptr 共享
+    ThumbnailWorker *worker = new ThumbnailWorker(taskId, task, this);
     worker->setAutoDelete(true);
-    m_threadPool->start(worker, priority);
+    task.runnable = worker;
+    m_threadPool->start(worker, task.priority);
+}
 
-    return taskId;
+QHash<QString, ThumbnailTask>::iterator ThumbnailTaskManager::cancelLocked(QHash<QString, ThumbnailTask>::iterator it, bool notify)
+{
+    it->canceled->store(true);
+
+    // 尚未开始的任务直接从线程池队列移除，取出后所有权归调用方
+    if (it->runnable && m_threadPool->tryTake(it->runnable))
+        delete it->runnable;
+
+    // 持锁期间不能直接发送信号，异步通知其余请求方
+    if (notify) {
+        const QString filePath = it->filePath;
+        const QSet<const void *> owners = it->owners;
+        QMetaObject::invokeMethod(
+                this, [this, filePath, owners]() {
+                    for (const void *owner : owners)
+                        emit thumbnailCanceled(filePath, owner);
+                },
+                Qt::QueuedConnection);
+    }
+
+    return m_tasks.erase(it);
+}
+
+bool ThumbnailTaskManager::evictLocked(int priority)
+{
+    auto victim = m_tasks.end();
+    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+        if (!it->runnable || it->priority >= priority)
+            continue;
+        if (victim == m_tasks.end() || it->priority < victim->priority)
+            victim = it;
+    }
+
+    if (victim == m_tasks.end())
+        return false;
+
+    cancelLocked(victim);
+    return true;
+}
+
+void ThumbnailTaskManager::markStarted(const QString &taskId, const std::shared_ptr<std::atomic_bool> &canceled)
+{
+    QMutexLocker locker(&m_mutex);
+
+    // 同一任务 ID 可能在取消后被重新提交，需按取消标记确认是同一个任务
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end() && it->canceled == canceled)
+        it->runnable = nullptr;
+}
+
+void ThumbnailTaskManager::markFinished(const QString &taskId, const std::shared_ptr<std::atomic_bool> &canceled)
+{
+    QMutexLocker locker(&m_mutex);
+
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end() && it->canceled == canceled)
+        m_tasks.erase(it);
 }
 
 void ThumbnailTaskManager::cancel(const QString &taskId)
 {
     QMutexLocker locker(&m_mutex);
 
-    if (m_tasks.contains(taskId)) {
-        m_tasks[taskId].canceled = true;
-        m_pendingTasks.remove(taskId);
-    }
+    auto it = m_tasks.find(taskId);
+    if (it != m_tasks.end())
+        cancelLocked(it);
 }
 
 void ThumbnailTaskManager::cancelByFilePath(const QString &filePath)
 {
     QMutexLocker locker(&m_mutex);
 
-    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
-        if (it->filePath == filePath) {
-            it->canceled = true;
-            m_pendingTasks.remove(it.key());
-        }
+    for (auto it = m_tasks.begin(); it != m_tasks.end();) {
+        if (it->filePath == filePath)
+            it = cancelLocked(it);
+        else
+            ++it;
     }
 }
 
-void ThumbnailTaskManager::cancelAll()
+void ThumbnailTaskManager::cancelByOwner(const QString &filePath, const void *owner)
 {
     QMutexLocker locker(&m_mutex);
 
-    for (auto it = m_tasks.begin(); it != m_tasks.end(); ++it) {
-        it->canceled = true;
+    for (auto it = m_tasks.begin(); it != m_tasks.end();) {
+        if (it->filePath == filePath && it->owners.remove(owner) && it->owners.isEmpty())
+            it = cancelLocked(it, false);
+        else
+            ++it;
     }
-    m_pendingTasks.clear();
+}
+
+void ThumbnailTaskManager::cancelAll()
+{
+    QMutexLocker locker(&m_mutex);
+
+    for (auto it = m_tasks.begin(); it != m_tasks.end();)
+        it = cancelLocked(it);
 }
 
 void ThumbnailTaskManager::setMaxThreadCount(int maxThreads)
@@ -129,49 +212,43 @@ void ThumbnailTaskManager::shutdown()
 {
     cancelAll();
 
-    {
-        QMutexLocker locker(&m_mutex);
-        m_tasks.clear();
-        m_taskQueue.clear();
-    }
-
     // 等待线程池完成所有任务
     m_threadPool->waitForDone();
 }
 
 // ========== ThumbnailWorker 实现 ==========
 
-ThumbnailWorker::ThumbnailWorker(const ThumbnailTask &task, QObject *receiver)
-    : m_task(task), m_receiver(receiver)
+ThumbnailWorker::ThumbnailWorker(const QString &taskId, const ThumbnailTask &task, QObject *receiver)
+    : m_taskId(taskId), m_task(task), m_receiver(receiver)
 {
 }
 
 void ThumbnailWorker::run()
 {
-    if (m_task.canceled) {
+    ThumbnailTaskManager *manager = ThumbnailTaskManager::instance();
+    manager->markStarted(m_taskId, m_task.canceled);
+
+    if (m_task.isCanceled()) {
+        manager->markFinished(m_taskId, m_task.canceled);
         return;
     }
 
-    // 检查缓存
-    QPixmap cached = ThumbnailCache::instance()->get(m_task.filePath, m_task.size);
-    if (!cached.isNull()) {
-        QMetaObject::invokeMethod(
-                m_receiver, [this, cached]() {
-                    ThumbnailTaskManager::instance()->thumbnailReady(m_task.filePath, cached);
-                },
-                Qt::QueuedConnection);
-        return;
+    // 检查缓存（含磁盘缓存）
+    const QString filePath = m_task.filePath;
+    QPixmap thumbnail = ThumbnailCache::instance()->get(filePath, m_task.size);
+    if (thumbnail.isNull()) {
+        // 使用 ThumbnailProvider 同步生成缩略图
+        thumbnail = ThumbnailProvider::instance()->getThumbnailSync(
+                filePath, m_task.mimetype, m_task.size);
     }
 
-    // 使用 ThumbnailProvider 同步生成缩略图
-    QPixmap thumbnail = ThumbnailProvider::instance()->getThumbnailSync(
-            m_task.filePath, m_task.mimetype, m_task.size);
+    manager->markFinished(m_taskId, m_task.canceled);
 
-    if (m_task.canceled) {
+    if (m_task.isCanceled()) {
         return;   // 任务已取消，不发送结果
     }
 
-    const QString &filePath = m_task.filePath;
+    // 工作对象执行完即被析构，回调中只能捕获值
     if (!thumbnail.isNull()) {
         QMetaObject::invokeMethod(
                 m_receiver, [filePath, thumbnail]() {
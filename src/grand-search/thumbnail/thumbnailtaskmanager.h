@@ -9,13 +9,15 @@
 #include <QMutex>
 #include <QObject>
 #include <QPixmap>
-#include <QQueue>
 #include <QRunnable>
 #include <QSet>
 #include <QSize>
 #include <QString>
 #include <QThreadPool>
 
+#include <atomic>
+#include <memory>
+
 namespace GrandSearch {
 
 // 前向声明
@@ -30,16 +32,24 @@ struct ThumbnailTask
     QString mimetype;   // MIME 类型
     ThumbnailSize size;   // 目标尺寸
     int priority;   // 优先级（数值越大优先级越高）
-    bool canceled;   // 是否已取消
+    std::shared_ptr<std::atomic_bool> canceled;   // 取消标记，与工作线程持有的副本共享
+    QSet<const void *> owners;   // 请求方集合，全部撤销后才真正取消任务
+    QRunnable *runnable;   // 尚在线程池队列中等待的工作对象，开始执行后置空
 
     ThumbnailTask()
-        : priority(0), canceled(false)
+        : priority(0), canceled(std::make_shared<std::atomic_bool>(false)), runnable(nullptr)
     {
     }
 
     ThumbnailTask(const QString &path, const QString &mime, const ThumbnailSize &s, int prio = 0)
-        : filePath(path), mimetype(mime), size(s), priority(prio), canceled(false)
+        : filePath(path), mimetype(mime), size(s), priority(prio),
+          canceled(std::make_shared<std::atomic_bool>(false)), runnable(nullptr)
+    {
+    }
+
+    bool isCanceled() const
     {
+        return canceled->load();
     }
 
     bool operator<(const ThumbnailTask &other) const
@@ -52,16 +62,29 @@ struct ThumbnailTask
  * @brief 缩略图任务管理器
  *
  * 使用线程池管理缩略图生成任务，支持：
- * - 任务优先级队列
- * - 任务去重
- * - 任务取消
+ * - 任务优先级队列（可见项高优先级，临近项预取）
+ * - 任务去重，重复提交时提升优先级
+ * - 任务取消（未开始的任务直接从线程池队列移除）
+ * - 任务表容量限制，完成或取消后立即移除
  * - 完成通知
  */
 class ThumbnailTaskManager : public QObject
 {
     Q_OBJECT
+    friend class ThumbnailWorker;
 
 public:
+    /**
+     * @brief 任务优先级
+     */
+    enum Priority {
+        PrefetchPriority = 0,   // 临近可视区域的预取任务
+        VisiblePriority = 10    // 可视区域内的任务
+    };
+
+    // 任务表最大容量（仅包含等待中和执行中的任务）
+    static constexpr int kMaxTaskCount = 128;
+
     /**
      * @brief 获取单例实例
      * @return ThumbnailTaskManager 实例指针
@@ -74,10 +97,13 @@ public:
      * @param mimetype MIME 类型
      * @param size 目标尺寸
      * @param priority 优先级（默认为 0）
-     * @return 任务 ID（用于取消任务）
+     * @param owner 请求方标识，用于 cancelByOwner 撤销请求
+     * @return 任务 ID（用于取消任务），任务表已满且无法腾出位置时返回空字符串
+     *
+     * 相同任务重复提交时合并请求方，若新优先级更高且任务尚未开始，则以新优先级重新排队。
      */
     QString submit(const QString &filePath, const QString &mimetype,
-                   const ThumbnailSize &size, int priority = 0);
+                   const ThumbnailSize &size, int priority = 0, const void *owner = nullptr);
 
     /**
      * @brief 取消指定任务
@@ -91,6 +117,15 @@ public:
      */
     void cancelByFilePath(const QString &filePath);
 
+    /**
+     * @brief 撤销请求方对指定文件的请求
+     * @param filePath 文件路径
+     * @param owner 请求方标识
+     *
+     * 仅当任务不再有其他请求方时才真正取消。
+     */
+    void cancelByOwner(const QString &filePath, const void *owner);
+
     /**
      * @brief 取消所有任务
      */
@@ -130,6 +165,13 @@ signals:
      */
     void thumbnailFailed(const QString &filePath);
 
+    /**
+     * @brief 任务未经请求方撤销而被取消（被淘汰、按文件或全部取消）时，向每个请求方发送，请求方据此清除请求记录
+     * @param filePath 文件路径
+     * @param owner 请求方标识，与 submit 时传入的一致
+     */
+    void thumbnailCanceled(const QString &filePath, const void *owner);
+
 private:
     explicit ThumbnailTaskManager(QObject *parent = nullptr);
     ~ThumbnailTaskManager() override;
@@ -146,13 +188,32 @@ private:
      */
     QString generateTaskId(const QString &filePath, const ThumbnailSize &size);
 
+    /**
+     * @brief 将任务放入线程池队列（调用方需持有锁）
+     */
+    void enqueueLocked(const QString &taskId, ThumbnailTask &task);
+
+    /**
+     * @brief 取消任务并从任务表移除（调用方需持有锁）
+     * @param notify 是否向各请求方异步发送 thumbnailCanceled，请求方自行撤销时无需通知
+     */
+    QHash<QString, ThumbnailTask>::iterator cancelLocked(QHash<QString, ThumbnailTask>::iterator it, bool notify = true);
+
+    /**
+     * @brief 任务表已满时淘汰一个优先级低于 priority 的排队任务（调用方需持有锁）
+     * @return 成功腾出位置返回 true
+     */
+    bool evictLocked(int priority);
+
+    // 由工作线程调用
+    void markStarted(const QString &taskId, const std::shared_ptr<std::atomic_bool> &canceled);
+    void markFinished(const QString &taskId, const std::shared_ptr<std::atomic_bool> &canceled);
+
 private:
     static ThumbnailTaskManager *s_instance;
 
     QThreadPool *m_threadPool;   // 线程池
-    QQueue<ThumbnailTask> m_taskQueue;   // 任务队列
-    QSet<QString> m_pendingTasks;   // 待处理任务 ID 集合（用于去重）
-    QHash<QString, ThumbnailTask> m_tasks;   // 任务 ID -> 任务映射
+    QHash<QString, ThumbnailTask> m_tasks;   // 任务 ID -> 等待中或执行中的任务
     QMutex m_mutex;   // 线程安全锁
 };
 
@@ -162,10 +223,11 @@ private:
 class ThumbnailWorker : public QRunnable
 {
 public:
-    ThumbnailWorker(const ThumbnailTask &task, QObject *receiver);
+    ThumbnailWorker(const QString &taskId, const ThumbnailTask &task, QObject *receiver);
     void run() override;
 
 private:
+    QString m_taskId;
     ThumbnailTask m_task;
     QObject *m_receiver;
 };
@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "appiconresolver.h"
+#include "utils.h"
+
+#include <DDesktopEntry>
+
+#include <QFileSystemWatcher>
+#include <QStandardPaths>
+#include <QFileInfo>
+#include <QTimer>
+#include <QMutexLocker>
+#include <QtConcurrent>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
+
+DCORE_USE_NAMESPACE
+
+namespace GrandSearch {
+
+// 文件变化后延迟清空缓存的时间（毫秒），安装应用时会连续产生多次变化
+static constexpr int kInvalidateDelay = 500;
+
+AppIconResolver::AppIconResolver(QObject *parent)
+    : QObject(parent),
+      m_watcher(new QFileSystemWatcher(this)),
+      m_invalidateTimer(new QTimer(this))
+{
+    m_invalidateTimer->setSingleShot(true);
+    m_invalidateTimer->setInterval(kInvalidateDelay);
+    connect(m_invalidateTimer, &QTimer::timeout, this, &AppIconResolver::invalidate);
+
+    connect(m_watcher, &QFileSystemWatcher::fileChanged, m_invalidateTimer, qOverload<>(&QTimer::start));
+    connect(m_watcher, &QFileSystemWatcher::directoryChanged, this, &AppIconResolver::onDirectoryChanged);
+
+    updateWatchedPaths();
+}
+
+AppIconResolver *AppIconResolver::instance()
+{
+    static AppIconResolver ins;
+    return &ins;
+}
+
+/**
+ * @brief AppIconResolver::defaultDesktopFile 获取 MIME 类型对应默认应用的 desktop 文件
+ */
+QString AppIconResolver::defaultDesktopFile(const QString &mimeType)
+{
+    quint64 generation = 0;
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_desktopFiles.constFind(mimeType);
+        if (it != m_desktopFiles.constEnd())
+            return it.value();
+        generation = m_generation;
+    }
+
+    const QString desktopFile = Utils::getDefaultAppDesktopFileByMimeType(mimeType);
+
+    QMutexLocker lk(&m_mutex);
+    if (generation == m_generation)
+        m_desktopFiles.insert(mimeType, desktopFile);
+    return desktopFile;
+}
+
+/**
+ * @brief AppIconResolver::iconName 获取 desktop 文件中的图标名称
+ */
+QString AppIconResolver::iconName(const QString &desktopFile)
+{
+    quint64 generation = 0;
+    {
+        QMutexLocker lk(&m_mutex);
+        auto it = m_iconNames.constFind(desktopFile);
+        if (it != m_iconNames.constEnd())
+            return it.value();
+        generation = m_generation;
+    }
+
+    QString icon;
+    if (!desktopFile.isEmpty() && QFileInfo::exists(desktopFile)) {
+        DDesktopEntry entry(desktopFile);
+        icon = entry.stringValue("Icon");
+    }
+
+    QMutexLocker lk(&m_mutex);
+    if (generation == m_generation)
+        m_iconNames.insert(desktopFile, icon);
+    return icon;
+}
+
+QString AppIconResolver::defaultAppIconName(const QString &mimeType)
+{
+    return iconName(defaultDesktopFile(mimeType));
+}
+
+void AppIconResolver::warmUp(const QStringList &mimeTypes)
+{
+    m_warmUpTypes = mimeTypes;
+    startWarmUp();
+}
+
+/**
+ * @brief AppIconResolver::invalidate 清空缓存，并重新监听及预热
+ */
+void AppIconResolver::invalidate()
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        m_desktopFiles.clear();
+        m_iconNames.clear();
+        ++m_generation;
+    }
+
+    qCDebug(logGrandSearch) << "Default application icon cache invalidated";
+
+    // 文件被替换写入后监听会失效，重新设置监听路径
+    updateWatchedPaths();
+    startWarmUp();
+    emit invalidated();
+}
+
+void AppIconResolver::updateWatchedPaths()
+{
+    QStringList files;
+    QStringList dirs;
+
+    // 用户及系统的默认应用配置，包括桌面环境专属的 <desktop>-mimeapps.list
+    m_listNames = QStringList { QStringLiteral("mimeapps.list") };
+    const QString currentDesktop = QString::fromLocal8Bit(qgetenv("XDG_CURRENT_DESKTOP"));
+    for (const QString &desktop : currentDesktop.split(':', Qt::SkipEmptyParts))
+        m_listNames << desktop.toLower() + QStringLiteral("-mimeapps.list");
+
+    m_configDirs.clear();
+    m_listFiles.clear();
+    for (const QString &dir : QStandardPaths::standardLocations(QStandardPaths::GenericConfigLocation)) {
+        if (!QFileInfo(dir).isDir())
+            continue;
+
+        // 配置文件的修改通过文件监听感知；目录仅用于感知配置文件的创建，
+        // 即使 mimeapps.list 已存在，仍可能新建优先级更高的 <desktop>-mimeapps.list
+        const QSet<QString> listFiles = existingListFiles(dir);
+        m_listFiles.unite(listFiles);
+        files << listFiles.values();
+        m_configDirs << dir;
+        dirs << dir;
+    }
+
+    // 应用的安装与卸载，以及 mimeinfo.cache 的更新
+    for (const QString &dir : QStandardPaths::standardLocations(QStandardPaths::ApplicationsLocation)) {
+        if (!QFileInfo(dir).isDir())
+            continue;
+
+        dirs << dir;
+        const QString path = dir + QStringLiteral("/mimeapps.list");
+        if (QFileInfo::exists(path))
+            files << path;
+    }
+
+    if (!m_watcher->files().isEmpty())
+        m_watcher->removePaths(m_watcher->files());
+    if (!m_watcher->directories().isEmpty())
+        m_watcher->removePaths(m_watcher->directories());
+
+    if (!files.isEmpty())
+        m_watcher->addPaths(files);
+    if (!dirs.isEmpty())
+        m_watcher->addPaths(dirs);
+}
+
+/**
+ * @brief AppIconResolver::onDirectoryChanged 监听目录发生变化
+ * 配置目录（如 ~/.config）中的文件频繁变化，仅在默认应用配置文件被创建或删除时清空缓存
+ */
+void AppIconResolver::onDirectoryChanged(const QString &dir)
+{
+    if (m_configDirs.contains(dir)) {
+        QSet<QString> watched;
+        for (const QString &name : m_listNames) {
+            const QString path = dir + '/' + name;
+            if (m_listFiles.contains(path))
+                watched.insert(path);
+        }
+
+        if (existingListFiles(dir) == watched)
+            return;
+
+        qCDebug(logGrandSearch) << "Default application list created or removed in:" << dir;
+    }
+
+    m_invalidateTimer->start();
+}
+
+QSet<QString> AppIconResolver::existingListFiles(const QString &dir) const
+{
+    QSet<QString> files;
+    for (const QString &name : m_listNames) {
+        const QString path = dir + '/' + name;
+        if (QFileInfo::exists(path))
+            files.insert(path);
+    }
+    return files;
+}
+
+void AppIconResolver::startWarmUp()
+{
+    if (m_warmUpTypes.isEmpty())
+        return;
+
+    const QStringList types = m_warmUpTypes;
+    QtConcurrent::run([this, types]() {
+        for (const QString &type : types)
+            defaultAppIconName(type);
+    });
+}
+
+}
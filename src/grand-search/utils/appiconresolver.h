@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef APPICONRESOLVER_H
+#define APPICONRESOLVER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSet>
+#include <QMutex>
+#include <QStringList>
+
+class QFileSystemWatcher;
+class QTimer;
+
+namespace GrandSearch {
+
+/**
+ * @brief 默认应用图标解析缓存
+ *
+ * 缓存 MIME 类型 -> 默认应用 desktop 文件 -> 图标名称 两级映射，避免每个结果都经由 GIO 查询默认应用并解析 desktop 文件。
+ * - 监听各 mimeapps.list 及应用目录，默认应用或应用安装情况改变时清空缓存；
+ *   配置目录仅用于感知 mimeapps.list 的创建与删除，其中其它文件的变化被忽略
+ * - 启动时在后台线程中预热常用 MIME 类型
+ * 需在主线程中首次调用 instance()。
+ */
+class AppIconResolver : public QObject
+{
+    Q_OBJECT
+public:
+    static AppIconResolver *instance();
+
+    QString defaultDesktopFile(const QString &mimeType);
+    QString iconName(const QString &desktopFile);
+    QString defaultAppIconName(const QString &mimeType);
+
+    /**
+     * @brief 在后台线程中解析给定 MIME 类型的默认应用及图标
+     * 缓存被清空后会以相同的列表重新预热
+     */
+    void warmUp(const QStringList &mimeTypes);
+    void invalidate();
+
+Q_SIGNALS:
+    void invalidated();
+
+private:
+    explicit AppIconResolver(QObject *parent = nullptr);
+    void updateWatchedPaths();
+    void onDirectoryChanged(const QString &dir);
+    QSet<QString> existingListFiles(const QString &dir) const;
+    void startWarmUp();
+
+    QFileSystemWatcher *m_watcher = nullptr;
+    QTimer *m_invalidateTimer = nullptr;   // 合并短时间内的多次文件变化
+    QStringList m_listNames;               // 默认应用配置文件名，包括桌面环境专属的配置
+    QStringList m_configDirs;              // 监听中的配置目录
+    QSet<QString> m_listFiles;             // 监听中已存在的配置文件
+
+    QMutex m_mutex;
+    QHash<QString, QString> m_desktopFiles;   // MIME 类型 -> desktop 文件
+    QHash<QString, QString> m_iconNames;      // desktop 文件 -> 图标名称
+    quint64 m_generation = 0;   // 每次清空缓存后递增，丢弃过期的后台解析结果
+    QStringList m_warmUpTypes;
+};
+
+}
+
+#endif // APPICONRESOLVER_H
@@ -8,19 +8,28 @@
 #include <dfm-search/dsearch_global.h>
 
 #include <QMutexLocker>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QThread>
 #include <QDebug>
 #include <QLoggingCategory>
 
+#include <algorithm>
+
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
 
 namespace GrandSearch {
 
-static const QString kPendingToken = QStringLiteral("__pending__");
+// 摘要缓存最大条目数
+static constexpr int kMaxSnippetCount = 1000;
+// 命中缓存后，在该时间内不再重复校验文件修改时间（毫秒）
+static constexpr qint64 kRecheckInterval = 5000;
 
 HighlightProvider::HighlightProvider(QObject *parent)
-    : QObject(parent)
+    : QObject(parent),
+      m_threadPool(new QThreadPool(this))
 {
-    // 在工作线程启动前设置回调，避免主线程/工作线程数据竞争
+    // 每个工作线程持有独立的 ContentRetriever
     m_fetchCallback = [](const QString &path, const QString &keyword, int searchType) -> QString {
         thread_local DFMSEARCH::ContentRetriever retriever;
         DFMSEARCH::HighlightOptions opt;
@@ -31,18 +40,19 @@ HighlightProvider::HighlightProvider(QObject *parent)
                                         opt);
     };
 
-    m_workerThread = new QThread(this);
-    m_worker = new QObject();
-    m_worker->moveToThread(m_workerThread);
-
-    connect(m_workerThread, &QThread::finished, m_worker, &QObject::deleteLater);
-    m_workerThread->start();
+    // 小规模线程池：摘要获取以 I/O 为主，少量并发即可显著降低可见行的等待时间
+    m_threadPool->setMaxThreadCount(qBound(2, QThread::idealThreadCount() / 2, 4));
+    m_snippetCache.setMaxCost(kMaxSnippetCount);
 }
 
 HighlightProvider::~HighlightProvider()
 {
-    m_workerThread->quit();
-    m_workerThread->wait(5000);
+    {
+        QMutexLocker lk(&m_requestMutex);
+        m_pendingRequests.clear();
+        m_activeTasks.clear();
+    }
+    m_threadPool->waitForDone(5000);
 }
 
 HighlightProvider *HighlightProvider::instance()
@@ -65,50 +75,57 @@ void HighlightProvider::requestHighlight(const QString &taskId, const QString &p
         return;
     }
 
-    // Step 1: 检查缓存
-    {
-        QMutexLocker lk(&m_cacheMutex);
-        auto &taskCache = m_cache[taskId];
-        auto it = taskCache.find(path);
-
-        if (it != taskCache.end()) {
-            const QString &cached = it.value();
-            if (cached != kPendingToken) {
-                if (cached.isEmpty())
-                    return;   // 已获取但无内容，避免无意义的 UI 更新
-
-                // 缓存命中，直接发射信号
-                lk.unlock();
-                Q_EMIT highlightReady(taskId, path, cached);
-                return;
-            }
-            // 标记为 pending，请求正在进行中，不重复提交
-            return;
+    HighlightRequest req { taskId, path, keyword, searchType, -1 };
+
+    // Step 1: 检查跨会话缓存，命中则立即通知，后台仅校验修改时间
+    SnippetEntry cached;
+    if (lookupCache(path, keyword, cached)) {
+        // 排队发送，避免在调用方填充数据的过程中重入
+        if (!cached.content.isEmpty()) {
+            const QString content = cached.content;
+            QMetaObject::invokeMethod(
+                    this, [this, taskId, path, content]() {
+                        Q_EMIT highlightReady(taskId, path, content);
+                    },
+                    Qt::QueuedConnection);
         }
 
-        // 标记为 pending
-        taskCache[path] = kPendingToken;
+        if (QDateTime::currentMSecsSinceEpoch() - cached.checkedAt < kRecheckInterval)
+            return;
+
+        req.cachedMTime = cached.mtime;
     }
 
     // Step 2: 加入请求队列
-    {
-        QMutexLocker lk(&m_requestMutex);
+    QMutexLocker lk(&m_requestMutex);
 
+    // 同一会话内的相同路径正在排队或处理中，不重复提交；高优先级请求将排队中的请求提前
+    auto &paths = m_activeTasks[taskId];
+    if (paths.contains(path)) {
         if (highPriority) {
-            m_pendingRequests.prepend({ taskId, path, keyword, searchType });
-        } else {
-            m_pendingRequests.append({ taskId, path, keyword, searchType });
+            auto it = std::find_if(m_pendingRequests.begin(), m_pendingRequests.end(),
+                                   [&taskId, &path](const HighlightRequest &pending) {
+                                       return pending.taskId == taskId && pending.path == path;
+                                   });
+            if (it != m_pendingRequests.end() && it != m_pendingRequests.begin())
+                m_pendingRequests.move(static_cast<int>(std::distance(m_pendingRequests.begin(), it)), 0);
         }
+        return;
+    }
+    paths.insert(path);
 
-        // 仅在 idle -> busy 时投递一次任务，避免重复唤醒 worker
-        int expected = 0;
-        if (m_processing.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
-            QMetaObject::invokeMethod(
-                    m_worker, [this]() {
-                        processNextRequest();
-                    },
-                    Qt::QueuedConnection);
-        }
+    if (highPriority) {
+        m_pendingRequests.prepend(req);
+    } else {
+        m_pendingRequests.append(req);
+    }
+
+    // 按需唤醒工作线程，不超过线程池上限
+    if (m_runningWorkers < m_threadPool->maxThreadCount()) {
+        ++m_runningWorkers;
+        m_threadPool->start([this]() {
+            processRequests();
+        });
     }
 }
 
@@ -116,25 +133,18 @@ void HighlightProvider::cancelTask(const QString &taskId)
 {
     qCDebug(logGrandSearch) << "HighlightProvider: canceling task for keyword:" << taskId;
 
-    // 从队列中移除所有该 taskId 的请求
-    {
-        QMutexLocker lk(&m_requestMutex);
-        m_pendingRequests.erase(
-                std::remove_if(m_pendingRequests.begin(), m_pendingRequests.end(),
-                               [&taskId](const HighlightRequest &req) {
-                                   return req.taskId == taskId;
-                               }),
-                m_pendingRequests.end());
-    }
-
-    // 清除缓存
-    {
-        QMutexLocker lk(&m_cacheMutex);
-        m_cache.remove(taskId);
-    }
+    // 从队列中移除所有该 taskId 的请求，缓存保留以供后续查询复用
+    QMutexLocker lk(&m_requestMutex);
+    m_pendingRequests.erase(
+            std::remove_if(m_pendingRequests.begin(), m_pendingRequests.end(),
+                           [&taskId](const HighlightRequest &req) {
+                               return req.taskId == taskId;
+                           }),
+            m_pendingRequests.end());
+    m_activeTasks.remove(taskId);
 }
 
-void HighlightProvider::processNextRequest()
+void HighlightProvider::processRequests()
 {
     while (true) {
         HighlightRequest req;
@@ -142,48 +152,41 @@ void HighlightProvider::processNextRequest()
         {
             QMutexLocker lk(&m_requestMutex);
             if (m_pendingRequests.isEmpty()) {
-                m_processing.store(0, std::memory_order_release);
-                // 双重检查：防止在 isEmpty 检查与 store 之间新增了请求
-                if (!m_pendingRequests.isEmpty()) {
-                    int expected = 0;
-                    if (m_processing.compare_exchange_strong(expected, 1, std::memory_order_acquire)) {
-                        continue;
-                    }
-                }
+                --m_runningWorkers;
                 return;
             }
             req = m_pendingRequests.takeFirst();
         }
 
-        // 检查该 taskId 是否已被取消
-        {
-            QMutexLocker lk(&m_cacheMutex);
-            if (!m_cache.contains(req.taskId)) {
-                continue;   // 会话已被取消，跳过
-            }
-        }
+        const qint64 mtime = fileMTime(req.path);
+        const qint64 now = QDateTime::currentMSecsSinceEpoch();
 
-        // 执行实际的 highlight 获取（同步阻塞 I/O，在工作线程中执行）
-        QString content;
-        if (m_fetchCallback) {
-            content = m_fetchCallback(req.path, req.keyword, req.searchType);
-            // 去除首尾的省略符号
-            if (content.startsWith("…"))
-                content = content.mid(1);
-            if (content.endsWith("…"))
-                content.chop(1);
+        // 缓存仍然有效，刷新校验时间即可
+        if (req.cachedMTime >= 0 && req.cachedMTime == mtime) {
+            touchCache(req.path, req.keyword, now);
+            finishRequest(req);
+            continue;
         }
 
-        // 存储到缓存（如果会话在 fetch 期间被取消，则跳过）
+        // 会话已被取消，跳过
         {
-            QMutexLocker lk(&m_cacheMutex);
-            if (!m_cache.contains(req.taskId)) {
-                continue;   // 会话在 fetch 期间被 cancel，跳过存储和通知
-            }
-            m_cache[req.taskId][req.path] = content;
+            QMutexLocker lk(&m_requestMutex);
+            if (!m_activeTasks.contains(req.taskId))
+                continue;
         }
 
-        if (content.isEmpty())
+        // 执行实际的 highlight 获取（同步阻塞 I/O，在工作线程中执行）
+        QString content = m_fetchCallback(req.path, req.keyword, req.searchType);
+        // 去除首尾的省略符号
+        if (content.startsWith("…"))
+            content = content.mid(1);
+        if (content.endsWith("…"))
+            content.chop(1);
+
+        storeCache(req.path, req.keyword, { mtime, now, content });
+
+        // 会话在 fetch 期间被 cancel，跳过通知
+        if (!finishRequest(req) || content.isEmpty())
             continue;
 
         // 通知主线程（跨线程信号自动 QueuedConnection）
@@ -191,4 +194,110 @@ void HighlightProvider::processNextRequest()
     }
 }
 
+bool HighlightProvider::lookupCache(const QString &path, const QString &keyword, SnippetEntry &entry)
+{
+    const QString normalized = normalizeKeyword(keyword);
+
+    QMutexLocker lk(&m_cacheMutex);
+    if (SnippetEntry *hit = m_snippetCache.object(cacheKey(path, normalized))) {
+        entry = *hit;
+        return true;
+    }
+
+    // 关键词细化：同一文件的已有摘要中仍包含新关键词时直接复用
+    auto it = m_pathKeywords.find(path);
+    if (it == m_pathKeywords.end())
+        return false;
+
+    QStringList &keywords = it.value();
+    for (auto kwIt = keywords.begin(); kwIt != keywords.end();) {
+        SnippetEntry *other = m_snippetCache.object(cacheKey(path, *kwIt));
+        if (!other) {
+            // 已被 LRU 淘汰
+            kwIt = keywords.erase(kwIt);
+            continue;
+        }
+
+        if (!other->content.isEmpty() && other->content.contains(keyword.trimmed(), Qt::CaseInsensitive)) {
+            entry = *other;
+            m_snippetCache.insert(cacheKey(path, normalized), new SnippetEntry(entry));
+            keywords.append(normalized);
+            return true;
+        }
+        ++kwIt;
+    }
+
+    if (keywords.isEmpty())
+        m_pathKeywords.erase(it);
+
+    return false;
+}
+
+void HighlightProvider::storeCache(const QString &path, const QString &keyword, const SnippetEntry &entry)
+{
+    const QString normalized = normalizeKeyword(keyword);
+    const QString key = cacheKey(path, normalized);
+
+    QMutexLocker lk(&m_cacheMutex);
+
+    // 文件已修改，同一路径下其他关键词的摘要一并失效
+    auto &keywords = m_pathKeywords[path];
+    for (const QString &kw : std::as_const(keywords)) {
+        SnippetEntry *other = m_snippetCache.object(cacheKey(path, kw));
+        if (other && other->mtime != entry.mtime)
+            m_snippetCache.remove(cacheKey(path, kw));
+    }
+
+    m_snippetCache.insert(key, new SnippetEntry(entry));
+    if (!keywords.contains(normalized))
+        keywords.append(normalized);
+
+    // 路径索引随缓存淘汰逐步失效，超过上限时整体清理一次
+    if (m_pathKeywords.size() > kMaxSnippetCount * 2) {
+        for (auto it = m_pathKeywords.begin(); it != m_pathKeywords.end();) {
+            const QString &p = it.key();
+            QStringList &kws = it.value();
+            kws.erase(std::remove_if(kws.begin(), kws.end(), [this, &p](const QString &kw) {
+                          return !m_snippetCache.contains(cacheKey(p, kw));
+                      }),
+                      kws.end());
+            it = kws.isEmpty() ? m_pathKeywords.erase(it) : std::next(it);
+        }
+    }
+}
+
+void HighlightProvider::touchCache(const QString &path, const QString &keyword, qint64 checkedAt)
+{
+    QMutexLocker lk(&m_cacheMutex);
+    if (SnippetEntry *hit = m_snippetCache.object(cacheKey(path, normalizeKeyword(keyword))))
+        hit->checkedAt = checkedAt;
+}
+
+bool HighlightProvider::finishRequest(const HighlightRequest &req)
+{
+    QMutexLocker lk(&m_requestMutex);
+    auto it = m_activeTasks.find(req.taskId);
+    if (it == m_activeTasks.end())
+        return false;
+
+    it->remove(req.path);
+    return true;
+}
+
+QString HighlightProvider::normalizeKeyword(const QString &keyword)
+{
+    return keyword.trimmed().toCaseFolded();
+}
+
+QString HighlightProvider::cacheKey(const QString &path, const QString &normalizedKeyword)
+{
+    return path + QChar(0) + normalizedKeyword;
+}
+
+qint64 HighlightProvider::fileMTime(const QString &path)
+{
+    QFileInfo info(path);
+    return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
+
 }   // namespace GrandSearch
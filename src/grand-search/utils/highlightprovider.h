@@ -6,24 +6,29 @@
 #define HIGHLIGHTPROVIDER_H
 
 #include <QObject>
-#include <QThread>
+#include <QThreadPool>
 #include <QMutex>
 #include <QHash>
+#include <QSet>
 #include <QList>
+#include <QCache>
 #include <functional>
-#include <atomic>
 
 namespace GrandSearch {
 
 /**
  * @brief 延迟高亮内容加载提供者
  *
- * 搜索结果展示时不同步获取高亮内容，而是通过此类在工作线程中异步获取。
+ * 搜索结果展示时不同步获取高亮内容，而是通过此类在工作线程池中异步获取。
  * 使用方式：
  * 1. 通过 setFetchCallback() 注入实际的 fetchHighlight 实现
  * 2. 通过 requestHighlight() 请求高亮内容
  * 3. 通过 highlightReady 信号获取异步结果
- * 4. 通过 cancelTask() 在搜索关键词改变时清理过期任务
+ * 4. 通过 cancelTask() 在搜索关键词改变时丢弃过期的待处理请求
+ *
+ * 获取到的摘要按（文件路径，修改时间，归一化关键词）缓存在有界 LRU 中，跨搜索会话复用：
+ * - 相同文件与关键词再次请求时直接命中，后台仅校验修改时间
+ * - 关键词细化（如继续输入）时，若新关键词仍出现在已缓存的摘要中则直接复用
  *
  * 参考自 dde-file-manager 的 dfmbase::HighlightProvider
  */
@@ -40,7 +45,7 @@ public:
 
     /**
      * @brief 注入实际的 fetchHighlight 实现
-     * 回调函数将在工作线程中执行（同步阻塞 I/O）
+     * 回调函数将在工作线程中并发执行（同步阻塞 I/O），需保证线程安全
      */
     void setFetchCallback(FetchHighlightCallback cb);
 
@@ -57,8 +62,8 @@ public:
                           bool highPriority = false);
 
     /**
-     * @brief 取消指定搜索会话的所有待处理请求并清除缓存
-     * 在搜索关键词改变时调用，丢弃所有已过期的高亮任务
+     * @brief 取消指定搜索会话的所有待处理请求
+     * 在搜索关键词改变时调用，丢弃所有已过期的高亮任务；已获取的摘要保留在缓存中供后续复用
      */
     void cancelTask(const QString &taskId);
 
@@ -71,37 +76,52 @@ Q_SIGNALS:
      */
     void highlightReady(const QString &taskId, const QString &path, const QString &content);
 
-private Q_SLOTS:
-    void processNextRequest();
-
 private:
     struct HighlightRequest
     {
         QString taskId;
         QString path;
         QString keyword;
-        int searchType;
+        int searchType = 0;
+        qint64 cachedMTime = -1;   // >= 0 表示已命中缓存，仅需校验修改时间
+    };
+
+    struct SnippetEntry
+    {
+        qint64 mtime = -1;
+        qint64 checkedAt = 0;   // 上次校验修改时间的时刻
+        QString content;
     };
 
     explicit HighlightProvider(QObject *parent = nullptr);
     ~HighlightProvider() override;
 
+    void processRequests();
+    bool lookupCache(const QString &path, const QString &keyword, SnippetEntry &entry);
+    void storeCache(const QString &path, const QString &keyword, const SnippetEntry &entry);
+    void touchCache(const QString &path, const QString &keyword, qint64 checkedAt);
+    bool finishRequest(const HighlightRequest &req);
+
+    static QString normalizeKeyword(const QString &keyword);
+    static QString cacheKey(const QString &path, const QString &normalizedKeyword);
+    static qint64 fileMTime(const QString &path);
+
     FetchHighlightCallback m_fetchCallback;
-    QThread *m_workerThread = nullptr;
-    QObject *m_worker = nullptr;
+    QThreadPool *m_threadPool = nullptr;
 
+    // 请求队列，可见区域项位于队列头部
     mutable QMutex m_requestMutex;
     QList<HighlightRequest> m_pendingRequests;
+    // 活跃会话：taskId -> 排队或处理中的路径（去重），不存在表示会话已取消
+    QHash<QString, QSet<QString>> m_activeTasks;
+    int m_runningWorkers = 0;
 
-    std::atomic<int> m_processing { 0 };
-
-    // 缓存：QHash<taskId(keyword), QHash<path, content>>
-    // 不存在 = 未请求
-    // "__pending__" = 请求中（去重哨兵）
-    // 空 QString = 已获取但无高亮内容
-    // 非空 = 已获取且有高亮内容
-    QHash<QString, QHash<QString, QString>> m_cache;
+    // 跨会话摘要缓存：key 为路径 + 归一化关键词，value 中记录文件修改时间
+    // 空 content 表示已获取但无高亮内容
     QMutex m_cacheMutex;
+    QCache<QString, SnippetEntry> m_snippetCache;
+    // 路径 -> 已缓存的归一化关键词，用于关键词细化时复用摘要
+    QHash<QString, QStringList> m_pathKeywords;
 };
 
 }   // namespace GrandSearch
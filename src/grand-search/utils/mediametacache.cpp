@@ -0,0 +1,243 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mediametacache.h"
+#include "global/searchconfigdefine.h"
+
+#include <QBuffer>
+#include <QCoreApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+namespace GrandSearch {
+
+// 记录文件格式标识与版本，格式变化时递增版本，旧记录视为未命中
+static constexpr quint32 kMagic = 0x4d4d4331;   // "MMC1"
+static constexpr quint32 kVersion = 1;
+
+// 内存缓存容量：16MB，按预览帧像素数据计算
+static constexpr int kMaxMemoryCacheBytes = 16 * 1024 * 1024;
+// 磁盘缓存的最大记录数与总字节数，超出任一上限后删除最早写入的记录
+static constexpr int kMaxDiskEntries = 2000;
+static constexpr qint64 kMaxDiskBytes = 64 * 1024 * 1024;
+// 每写入多少条记录检查一次磁盘缓存大小
+static constexpr int kPruneInterval = 64;
+
+MediaMetaCache::MediaMetaCache()
+{
+    m_cacheDir = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).value(0)
+            + "/deepin/" GRANDSEARCH_NAME "/media";
+    m_memoryCache.setMaxCost(kMaxMemoryCacheBytes);
+
+    // 首次访问可能发生在工作线程，对象始终归属主线程
+    if (qApp && thread() != qApp->thread())
+        moveToThread(qApp->thread());
+}
+
+MediaMetaCache *MediaMetaCache::instance()
+{
+    // 局部静态变量的初始化是线程安全的，解码线程并发首次访问时只会构造一次
+    static MediaMetaCache ins;
+    return &ins;
+}
+
+bool MediaMetaCache::find(const QString &file, Entry &entry)
+{
+    qint64 size = -1;
+    qint64 mtime = -1;
+    if (!fileStamp(file, size, mtime))
+        return false;
+
+    {
+        QMutexLocker lk(&m_mutex);
+        if (CachedEntry *cached = m_memoryCache.object(file)) {
+            if (cached->size == size && cached->mtime == mtime) {
+                entry = cached->entry;
+                return true;
+            }
+            m_memoryCache.remove(file);
+        }
+    }
+
+    Entry disk;
+    if (!readDisk(file, size, mtime, disk))
+        return false;
+
+    CachedEntry *cached = new CachedEntry { size, mtime, disk };
+    {
+        QMutexLocker lk(&m_mutex);
+        m_memoryCache.insert(file, cached, qMax(1, static_cast<int>(disk.frame.sizeInBytes())));
+    }
+
+    entry = disk;
+    return true;
+}
+
+void MediaMetaCache::insert(const QString &file, const Entry &entry)
+{
+    qint64 size = -1;
+    qint64 mtime = -1;
+    if (!fileStamp(file, size, mtime))
+        return;
+
+    bool needPrune = false;
+    {
+        QMutexLocker lk(&m_mutex);
+        m_memoryCache.insert(file, new CachedEntry { size, mtime, entry },
+                             qMax(1, static_cast<int>(entry.frame.sizeInBytes())));
+        needPrune = (++m_writeCount % kPruneInterval) == 0;
+    }
+
+    writeDisk(file, size, mtime, entry);
+
+    if (needPrune)
+        prune();
+}
+
+void MediaMetaCache::remove(const QString &file)
+{
+    {
+        QMutexLocker lk(&m_mutex);
+        m_memoryCache.remove(file);
+    }
+
+    QFile::remove(cacheFilePath(file));
+}
+
+QVariantHash MediaMetaCache::cachedEntry(const QString &file)
+{
+    Entry entry;
+    if (!find(file, entry))
+        return {};
+
+    return { { "info", entry.info }, { "frame", entry.frame } };
+}
+
+void MediaMetaCache::storeEntry(const QString &file, const QVariantHash &info, const QImage &frame)
+{
+    insert(file, Entry { info, frame });
+}
+
+QString MediaMetaCache::cacheFilePath(const QString &file) const
+{
+    const QByteArray key = QCryptographicHash::hash(file.toUtf8(), QCryptographicHash::Md5).toHex();
+    return m_cacheDir + "/" + QString::fromLatin1(key);
+}
+
+void MediaMetaCache::clearMemoryCache()
+{
+    QMutexLocker lk(&m_mutex);
+    m_memoryCache.clear();
+}
+
+void MediaMetaCache::setCacheDir(const QString &dir)
+{
+    m_cacheDir = dir;
+    clearMemoryCache();
+}
+
+bool MediaMetaCache::fileStamp(const QString &file, qint64 &size, qint64 &mtime)
+{
+    if (file.isEmpty())
+        return false;
+
+    QFileInfo info(file);
+    if (!info.isFile())
+        return false;
+
+    size = info.size();
+    mtime = info.lastModified().toMSecsSinceEpoch();
+    return true;
+}
+
+bool MediaMetaCache::readDisk(const QString &file, qint64 size, qint64 mtime, Entry &entry) const
+{
+    QFile cache(cacheFilePath(file));
+    if (!cache.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&cache);
+    in.setVersion(QDataStream::Qt_5_11);
+
+    // 先读取记录头，路径、大小或修改时间不一致时不再读取预览帧
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString path;
+    qint64 cachedSize = -1;
+    qint64 cachedMTime = -1;
+    in >> magic >> version;
+    if (magic != kMagic || version != kVersion)
+        return false;
+
+    in >> path >> cachedSize >> cachedMTime;
+    if (in.status() != QDataStream::Ok || path != file
+            || cachedSize != size || cachedMTime != mtime)
+        return false;
+
+    QVariantHash info;
+    QByteArray frameData;
+    in >> info >> frameData;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    QImage frame;
+    if (!frameData.isEmpty() && !frame.loadFromData(frameData, "PNG"))
+        return false;
+
+    entry.info = info;
+    entry.frame = frame;
+    return true;
+}
+
+bool MediaMetaCache::writeDisk(const QString &file, qint64 size, qint64 mtime, const Entry &entry) const
+{
+    if (!QDir().mkpath(m_cacheDir))
+        return false;
+
+    QByteArray frameData;
+    if (!entry.frame.isNull()) {
+        QBuffer buffer(&frameData);
+        buffer.open(QIODevice::WriteOnly);
+        entry.frame.save(&buffer, "PNG");
+    }
+
+    // 先写临时文件再替换，避免其他线程读到写了一半的记录
+    QSaveFile cache(cacheFilePath(file));
+    if (!cache.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&cache);
+    out.setVersion(QDataStream::Qt_5_11);
+    out << kMagic << kVersion << file << size << mtime << entry.info << frameData;
+
+    if (out.status() != QDataStream::Ok) {
+        cache.cancelWriting();
+        return false;
+    }
+
+    return cache.commit();
+}
+
+void MediaMetaCache::prune()
+{
+    QDir dir(m_cacheDir);
+    const QFileInfoList entries = dir.entryInfoList(QDir::Files | QDir::NoDotAndDotDot, QDir::Time);
+
+    // 按修改时间从新到旧排列，保留记录数与总字节数均不超出上限的较新记录，
+    // 视频记录包含预览帧，仅限制记录数时磁盘占用可能很大
+    qint64 bytes = 0;
+    for (int i = 0; i < entries.size(); ++i) {
+        bytes += entries.at(i).size();
+        if (i >= kMaxDiskEntries || bytes > kMaxDiskBytes)
+            QFile::remove(entries.at(i).absoluteFilePath());
+    }
+}
+
+}   // namespace GrandSearch
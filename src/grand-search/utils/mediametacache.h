@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MEDIAMETACACHE_H
+#define MEDIAMETACACHE_H
+
+#include <QCache>
+#include <QImage>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include <QVariantHash>
+
+namespace GrandSearch {
+
+/**
+ * @brief 音视频文件解码结果的持久化缓存
+ *
+ * 以 (路径, 文件大小, 修改时间) 为键，保存时长、尺寸、标签等元数据及预览帧，
+ * 由音视频预览插件与缩略图模块共用，再次预览同一文件时无需重新解码。
+ * 缓存只编译在宿主中，预览插件经由 PluginProxy::mediaMetaCache 取得唯一实例。
+ * - 内存缓存：最近使用的条目，容量按预览帧字节数计算
+ * - 磁盘缓存：~/.cache/deepin/dde-grand-search/media/，每个文件一条记录，
+ *   记录数或总字节数超出上限时删除最早写入的记录
+ * 文件大小或修改时间变化后记录失效。涉及磁盘 I/O，不应在 GUI 线程调用。
+ */
+class MediaMetaCache : public QObject
+{
+    Q_OBJECT
+public:
+    struct Entry
+    {
+        QVariantHash info;   // 元数据，键与值的含义由写入方定义
+        QImage frame;        // 预览帧，可为空
+    };
+
+    static MediaMetaCache *instance();
+
+    /**
+     * @brief 查找文件的缓存记录
+     * @param file 文件路径
+     * @param entry 输出缓存的记录
+     * @return 存在且未失效时返回 true
+     */
+    bool find(const QString &file, Entry &entry);
+
+    /**
+     * @brief 写入文件的解码结果，文件不存在时忽略
+     */
+    void insert(const QString &file, const Entry &entry);
+    void remove(const QString &file);
+
+    /**
+     * @brief 查找文件的缓存记录，供预览插件通过宿主代理在工作线程中以 Qt::DirectConnection 调用
+     * @param file 文件路径
+     * @return 未命中时返回空，命中时以 "info" 保存元数据、"frame" 保存预览帧
+     */
+    Q_INVOKABLE QVariantHash cachedEntry(const QString &file);
+
+    /**
+     * @brief 写入文件的解码结果，供预览插件通过宿主代理调用
+     */
+    Q_INVOKABLE void storeEntry(const QString &file, const QVariantHash &info, const QImage &frame);
+
+    QString cacheFilePath(const QString &file) const;
+    void clearMemoryCache();
+
+    /**
+     * @brief 替换磁盘缓存目录并清空内存缓存
+     * 目录不加锁读取，只能在没有其他线程使用缓存时调用，如单元测试中
+     */
+    void setCacheDir(const QString &dir);
+
+private:
+    MediaMetaCache();
+    ~MediaMetaCache() override = default;
+    Q_DISABLE_COPY(MediaMetaCache)
+
+    struct CachedEntry
+    {
+        qint64 size = -1;
+        qint64 mtime = -1;
+        Entry entry;
+    };
+
+    static bool fileStamp(const QString &file, qint64 &size, qint64 &mtime);
+    bool readDisk(const QString &file, qint64 size, qint64 mtime, Entry &entry) const;
+    bool writeDisk(const QString &file, qint64 size, qint64 mtime, const Entry &entry) const;
+    void prune();
+
+    QString m_cacheDir;
+    QMutex m_mutex;   // 仅保护内存缓存，不在持锁期间进行磁盘 I/O
+    QCache<QString, CachedEntry> m_memoryCache;
+    int m_writeCount = 0;   // 累计写入次数，每隔一定次数清理一次磁盘缓存
+};
+
+}   // namespace GrandSearch
+
+#endif   // MEDIAMETACACHE_H
@@ -0,0 +1,108 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "mimetyperesolver.h"
+#include "utils.h"
+
+#include <QThreadPool>
+#include <QMutexLocker>
+#include <QFileInfo>
+#include <QLoggingCategory>
+
+Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
+
+namespace GrandSearch {
+
+// 内容探测结果缓存的最大条目数
+static constexpr int kMaxCacheCount = 2048;
+
+MimeTypeResolver::MimeTypeResolver(QObject *parent)
+    : QObject(parent),
+      m_threadPool(new QThreadPool(this))
+{
+    // 内容探测以 I/O 为主，单线程即可，避免在慢速磁盘上并发读取
+    m_threadPool->setMaxThreadCount(1);
+    m_cache.setMaxCost(kMaxCacheCount);
+}
+
+MimeTypeResolver::~MimeTypeResolver()
+{
+    m_threadPool->clear();
+    m_threadPool->waitForDone(1000);
+}
+
+MimeTypeResolver *MimeTypeResolver::instance()
+{
+    static MimeTypeResolver ins;
+    return &ins;
+}
+
+QString MimeTypeResolver::mimeType(const QString &path, const QString &hint, bool *resolved)
+{
+    if (resolved)
+        *resolved = true;
+
+    if (!hint.isEmpty() || path.isEmpty())
+        return hint;
+
+    // 包含文件名后缀，仅凭后缀确定类型，不读取文件
+    if (!QFileInfo(path).suffix().isEmpty())
+        return m_mimeDb.mimeTypeForFile(path, QMimeDatabase::MatchExtension).name();
+
+    QString cached;
+    if (lookup(path, cached))
+        return cached;
+
+    if (resolved)
+        *resolved = false;
+
+    {
+        QMutexLocker lk(&m_mutex);
+        if (!m_pending.contains(path)) {
+            m_pending.insert(path);
+            m_threadPool->start([this, path]() {
+                const QString type = Utils::getFileMimetype(path);
+                store(path, type);
+                QMetaObject::invokeMethod(this, [this, path, type]() {
+                    emit mimeTypeResolved(path, type);
+                }, Qt::QueuedConnection);
+            });
+        }
+    }
+
+    // 占位类型：仅按文件名匹配
+    return m_mimeDb.mimeTypeForFile(path, QMimeDatabase::MatchExtension).name();
+}
+
+QString MimeTypeResolver::resolveNow(const QString &path, const QString &hint)
+{
+    bool resolved = false;
+    const QString type = mimeType(path, hint, &resolved);
+    if (resolved)
+        return type;
+
+    qCDebug(logGrandSearch) << "Resolving MIME type synchronously:" << path;
+    const QString sniffed = Utils::getFileMimetype(path);
+    store(path, sniffed);
+    return sniffed;
+}
+
+bool MimeTypeResolver::lookup(const QString &path, QString &mimeType)
+{
+    QMutexLocker lk(&m_mutex);
+    if (QString *cached = m_cache.object(path)) {
+        mimeType = *cached;
+        return true;
+    }
+    return false;
+}
+
+void MimeTypeResolver::store(const QString &path, const QString &mimeType)
+{
+    QMutexLocker lk(&m_mutex);
+    m_pending.remove(path);
+    m_cache.insert(path, new QString(mimeType));
+}
+
+}
@@ -0,0 +1,62 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#ifndef MIMETYPERESOLVER_H
+#define MIMETYPERESOLVER_H
+
+#include <QObject>
+#include <QCache>
+#include <QMutex>
+#include <QSet>
+#include <QMimeDatabase>
+
+class QThreadPool;
+
+namespace GrandSearch {
+
+/**
+ * @brief 文件 MIME 类型的异步解析
+ *
+ * 带后缀的文件仅凭文件名即可确定类型，直接返回；无后缀的文件需读取文件内容，
+ * 此时先返回按文件名得到的占位类型，在工作线程中完成内容探测后通过 mimeTypeResolved 信号通知。
+ * 界面线程中的调用不会因读取文件而阻塞。
+ */
+class MimeTypeResolver : public QObject
+{
+    Q_OBJECT
+public:
+    static MimeTypeResolver *instance();
+
+    /**
+     * @brief 获取文件的 MIME 类型
+     * @param path 文件路径
+     * @param hint 搜索结果中已知的类型，非空时直接返回
+     * @param resolved 输出是否为最终结果，false 表示返回的是占位类型且已发起后台探测
+     */
+    QString mimeType(const QString &path, const QString &hint = QString(), bool *resolved = nullptr);
+
+    // 同步获取最终类型，仅用于必须依赖准确类型的用户操作（如打开文件）
+    QString resolveNow(const QString &path, const QString &hint = QString());
+
+Q_SIGNALS:
+    void mimeTypeResolved(const QString &path, const QString &mimeType);
+
+private:
+    explicit MimeTypeResolver(QObject *parent = nullptr);
+    ~MimeTypeResolver() override;
+
+    bool lookup(const QString &path, QString &mimeType);
+    void store(const QString &path, const QString &mimeType);
+
+    QMimeDatabase m_mimeDb;
+    QThreadPool *m_threadPool = nullptr;
+
+    QMutex m_mutex;
+    QCache<QString, QString> m_cache;   // 已完成内容探测的路径 -> 类型
+    QSet<QString> m_pending;            // 正在探测的路径
+};
+
+}
+
+#endif // MIMETYPERESOLVER_H
@@ -10,6 +10,8 @@ extern "C" {
 #include <gio/gdesktopappinfo.h>
 
 #include "utils.h"
+#include "appiconresolver.h"
+#include "mimetyperesolver.h"
 
 #include "global/builtinsearch.h"
 #include "global/searchhelper.h"
@@ -37,6 +39,8 @@ extern "C" {
 #include <QApplication>
 #include <QLoggingCategory>
 
+#include <vector>
+
 Q_DECLARE_LOGGING_CATEGORY(logGrandSearch)
 
 DCORE_USE_NAMESPACE
@@ -51,6 +55,10 @@ static const int ModifyDateType = 2;
 static const int ReadDateType = 3;
 
 static const double TimesWeight = 0.5;
+static const double MaxRecordTimes = 20;
+
+static const char *const ControlCenterDesktopFile = "/usr/share/applications/dde-control-center.desktop";
+static const char *const DefaultBrowserMimeType = "x-scheme-handler/http";
 
 class DCollator : public QCollator
 {
@@ -62,22 +70,133 @@ public:
     }
 };
 
-QMap<QString, QString> Utils::m_appIconNameMap;
 QMimeDatabase Utils::m_mimeDb;
 
+namespace {
+
+// 首字符分类，数值越大排序越靠后，与 compareByString 中逐级判断的结果一致
+enum LeadingCharRank {
+    OtherRank = 0,
+    HanziRank,
+    LatinRank,
+    OtherLangRank,
+    NumberRank,
+    SymbolRank
+};
+
+inline int leadingCharRank(QChar ch)
+{
+    const ushort uc = ch.unicode();
+    switch (uc) {
+    case 0x3002: case 0xff1b: case 0xff0c: case 0xff1a: case 0x201c: case 0x201d:
+    case 0xff08: case 0xff09: case 0x3001: case 0xff1f: case 0x300a: case 0x300b:
+        return SymbolRank;
+    default:
+        break;
+    }
+    if (ispunct(ch.toLatin1()))
+        return SymbolRank;
+
+    if (uc >= '0' && uc <= '9')
+        return NumberRank;
+
+    const QChar::Script script = ch.script();
+    if (script >= QChar::Script_Inherited
+            && script <= QChar::Script_ZanabazarSquare
+            && script != QChar::Script_Latin
+            && script != QChar::Script_Han)
+        return OtherLangRank;
+
+    if ((uc >= 'a' && uc <= 'z') || (uc >= 'A' && uc <= 'Z'))
+        return LatinRank;
+
+    if (uc >= 0x4e00 && uc <= 0x9fa5)
+        return HanziRank;
+
+    return OtherRank;
+}
+
+// 排序时每项只计算一次的排序键：首字符分类与整串的排序规则键
+struct NameSortKey
+{
+    NameSortKey(const QString &str, const QCollator &collator)
+        : name(str)
+        , rank(str.isEmpty() ? OtherRank : leadingCharRank(str.at(0)))
+        , collationKey(collator.sortKey(str))
+    {
+    }
+
+    QString name;
+    int rank;
+    QCollatorSortKey collationKey;
+};
+
+}
+
 bool Utils::sort(MatchedItems &list, Qt::SortOrder order /* = Qt::AscendingOrder*/)
 {
     QElapsedTimer time;
     time.start();
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-    qStableSort(list.begin(), list.end(), [order](const MatchedItem &node1, const MatchedItem &node2) {
-        return compareByString(node1.name, node2.name, order);
-    });
+
+    thread_local static DCollator sortCollator;
+
+    // 预先为每一项生成排序键，比较时不再重复做字符分类与排序规则转换
+    std::vector<NameSortKey> keys;
+    keys.reserve(static_cast<size_t>(list.size()));
+    for (const MatchedItem &item : list)
+        keys.emplace_back(item.name, sortCollator);
+
+    std::vector<int> indexes(keys.size());
+    for (size_t i = 0; i < indexes.size(); ++i)
+        indexes[i] = static_cast<int>(i);
+
+    const bool desc = order == Qt::DescendingOrder;
+    std::stable_sort(indexes.begin(), indexes.end(), [&keys, desc](int left, int right) {
+        const NameSortKey &key1 = keys[static_cast<size_t>(left)];
+        const NameSortKey &key2 = keys[static_cast<size_t>(right)];
+        const QString &str1 = key1.name;
+        const QString &str2 = key2.name;
+
+        // 与 compareByString 相同，以第一个不同的字符为准进行分类比较
+        const int nMinLength = qMin(str1.size(), str2.size());
+        int nMidIndex = -1;
+        for (int i = 0; i < nMinLength; i++) {
+            if (str1[i] != str2[i]) {
+                nMidIndex = i;
+                break;
+            }
+        }
+
+        int rank1 = key1.rank;
+        int rank2 = key2.rank;
+        if (nMidIndex > 0) {
+            rank1 = leadingCharRank(str1.at(nMidIndex));
+            rank2 = leadingCharRank(str2.at(nMidIndex));
+        }
+
+        if (rank1 != rank2)
+            return desc ? rank1 > rank2 : rank1 < rank2;
+
+        int result = 0;
+        if (nMidIndex > 0) {
+            // 存在公共前缀时排序规则需作用于剩余部分，无法复用整串的排序键
+#if QT_VERSION >= QT_VERSION_CHECK(5, 13, 0)
+            result = sortCollator.compare(QStringView(str1).mid(nMidIndex), QStringView(str2).mid(nMidIndex));
 #else
-    std::stable_sort(list.begin(), list.end(), [order](const MatchedItem &node1, const MatchedItem &node2) {
-        return compareByString(node1.name, node2.name, order);
-    });
+            result = sortCollator.compare(str1.mid(nMidIndex), str2.mid(nMidIndex));
 #endif
+        } else {
+            result = key1.collationKey.compare(key2.collationKey);
+        }
+
+        return (desc ^ (result < 0)) == 0x01;
+    });
+
+    MatchedItems sorted;
+    sorted.reserve(list.size());
+    for (int index : indexes)
+        sorted.append(list.at(index));
+    list.swap(sorted);
 
     qCDebug(logGrandSearch) << "Sorting matched items completed - Time:" << time.elapsed() << "ms";
     return true;
@@ -241,19 +360,13 @@ bool Utils::sortByWeight(MatchedItemMap &map, Qt::SortOrder order)
  */
 bool Utils::compareByWeight(const MatchedItem &node1, const MatchedItem &node2, Qt::SortOrder order)
 {
-    bool hasWeight1 = node1.extra.toHash().contains(GRANDSEARCH_PROPERTY_ITEM_WEIGHT);
-    bool hasWeight2 = node2.extra.toHash().contains(GRANDSEARCH_PROPERTY_ITEM_WEIGHT);
-
-    if (hasWeight1 && hasWeight2) {
+    if (node1.hasWeight && node2.hasWeight) {
         // 两项均有权重，则对比权重
-        double weight1 = node1.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
-        double weight2 = node2.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
-
-        return order == Qt::DescendingOrder ? weight1 > weight2 : weight1 < weight2;
-    } else if (hasWeight1) {
+        return order == Qt::DescendingOrder ? node1.weight > node2.weight : node1.weight < node2.weight;
+    } else if (node1.hasWeight) {
 
         return order == Qt::DescendingOrder;
-    } else if (hasWeight2) {
+    } else if (node2.hasWeight) {
 
         return order != Qt::DescendingOrder;
     } else {
@@ -283,30 +396,24 @@ void Utils::updateItemsWeight(MatchedItemMap &map, const QString &content)
             if (!setWeightMethod(item))
                 continue;
 
-            // 计算权重
-            double weight = 0;
-            {
-                const QVariantHash &extData = item.extra.toHash();
-                const QString &method = extData.value(GRANDSEARCH_PROPERTY_WEIGHT_METHOD).toString();
-                // 已经设置权重基础数值
-                if (extData.contains(GRANDSEARCH_PROPERTY_ITEM_WEIGHT))
-                    weight = extData.value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT).toDouble();
-
-                if (method == GRANDSEARCH_PROPERTY_WEIGHT_METHOD_LOCALFILE) {
-                    weight += calcFileWeight(item.item, item.name, keys);
-                } else if (method == GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP) {
-                    weight += calcAppWeight(item, keys);
-                } else if (method == GRANDSEARCH_PROPERTY_WEIGHT_METHOD_SETTING) {
-                    weight += calcSettingWeight(item, keys);
-                } else {
-                    continue;
-                }
+            // 计算权重，已经设置的权重作为基础数值
+            double weight = item.hasWeight ? item.weight : 0;
+            switch (item.weightMethod) {
+            case MatchedItem::LocalFileWeightMethod:
+                weight += calcFileWeight(item, keys);
+                break;
+            case MatchedItem::AppWeightMethod:
+                weight += calcAppWeight(item, keys);
+                break;
+            case MatchedItem::SettingWeightMethod:
+                weight += calcSettingWeight(item, keys);
+                break;
+            default:
+                continue;
             }
 
-            QVariant &extra = item.extra;
-            QVariantHash originalValue = extra.toHash();
-            originalValue.insert(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, weight);
-            extra = QVariant::fromValue(originalValue);
+            item.weight = weight;
+            item.hasWeight = true;
         }
     }
 }
@@ -318,70 +425,59 @@ void Utils::updateItemsWeight(MatchedItemMap &map, const QString &content)
  */
 bool Utils::setWeightMethod(MatchedItem &item)
 {
-    QVariantHash ext = item.extra.toHash();
-
     // 已经设置了计算方法
-    if (ext.contains(GRANDSEARCH_PROPERTY_WEIGHT_METHOD))
+    if (item.weightMethod != MatchedItem::NoWeightMethod)
         return true;
 
     const QString &search = item.searcher;
     if (search == GRANDSEARCH_CLASS_FILE_DEEPIN || search == GRANDSEARCH_CLASS_OCR_TEXT
         || search == GRANDSEARCH_CLASS_FILE_FULLTEXT || search == GRANDSEARCH_CLASS_FILE_SEMANTIC) {
-        ext.insert(GRANDSEARCH_PROPERTY_WEIGHT_METHOD,
-                   GRANDSEARCH_PROPERTY_WEIGHT_METHOD_LOCALFILE);
+        item.weightMethod = MatchedItem::LocalFileWeightMethod;
     } else if (search == GRANDSEARCH_CLASS_APP_DESKTOP) {
-        ext.insert(GRANDSEARCH_PROPERTY_WEIGHT_METHOD,
-                   GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP);
+        item.weightMethod = MatchedItem::AppWeightMethod;
     } else if (search == GRANDSEARCH_CLASS_SETTING_CONTROLCENTER) {
-        ext.insert(GRANDSEARCH_PROPERTY_WEIGHT_METHOD,
-                   GRANDSEARCH_PROPERTY_WEIGHT_METHOD_SETTING);
+        item.weightMethod = MatchedItem::SettingWeightMethod;
     } else {
         // 不支持计算权重
         return false;
     }
 
-    item.extra = QVariant::fromValue(ext);
-
     return true;
 }
 
 /**
  * @brief Utils::calcFileWeight 计算泛文件类目的权重
- * @param path 文件路径
- * @param name 文件名
+ * @param item 搜索结果，文件时间取自扩展信息
  * @param keys 输入关键字列表
  * @return 文件权重
  */
-double Utils::calcFileWeight(const QString &path, const QString &name, const QStringList &keys)
+double Utils::calcFileWeight(const MatchedItem &item, const QStringList &keys)
 {
     double weight = 0;
     for (const QString &key : keys) {
-        if (name.contains(key)) {
+        if (item.name.contains(key)) {
             weight += 43;
             break;
         }
     }
 
-    QFileInfo fileInfo(path);
-
-    const QDateTime &currentDateTime = QDateTime::currentDateTime();
-#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
-    const QDateTime &createDateTime = fileInfo.birthTime();
-#else
-    const QDateTime &createDateTime = fileInfo.created();
-#endif
-    const QDateTime &lastModifyTime = CommonTools::getFileModifiedTime(path);
-    const QDateTime &lastReadTime = CommonTools::getFileAccessTime(path);
+    // 文件时间由后端随结果提供，此处不访问文件系统
+    const QVariantList times = item.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES).toList();
+    if (times.size() != 3) {
+        qCDebug(logGrandSearch) << "No file times in result, skip date weight - Item:" << item.item;
+        return weight;
+    }
 
-    qint64 createDayDiff = calcDateDiff(createDateTime, currentDateTime);
-    qint64 lastModifyDayDiff = calcDateDiff(lastModifyTime, currentDateTime);
-    qint64 lastReadDayDiff = calcDateDiff(lastReadTime, currentDateTime);
+    const qint64 currentSecs = QDateTime::currentSecsSinceEpoch();
+    static const int dateTypes[] = { CreateDateType, ModifyDateType, ReadDateType };
+    for (int i = 0; i < 3; ++i) {
+        const qint64 secs = times.at(i).toLongLong();
+        if (secs <= 0)
+            continue;
 
-    int createDayWeight = calcWeightByDateDiff(createDayDiff, CreateDateType);
-    int lastModifyDayWeight = calcWeightByDateDiff(lastModifyDayDiff, ModifyDateType);
-    int lastReadDayWeight = calcWeightByDateDiff(lastReadDayDiff, ReadDateType);
+        weight += calcWeightByDateDiff(calcDateDiff(secs, currentSecs), dateTypes[i]);
+    }
 
-    weight += createDayWeight + lastModifyDayWeight + lastReadDayWeight;
     return weight;
 }
 
@@ -397,6 +493,12 @@ qint64 Utils::calcDateDiff(const QDateTime &date1, const QDateTime &date2)
     return date1.secsTo(date2) / day;
 }
 
+qint64 Utils::calcDateDiff(qint64 secs1, qint64 secs2)
+{
+    static const qint64 day = 24 * 60 * 60;
+    return (secs2 - secs1) / day;
+}
+
 /**
  * @brief Utils::calcWeightByDateDiff 根据天数计算权重
  * @param diff 间隔天数
@@ -533,8 +635,8 @@ void Utils::packageBestMatch(MatchedItemMap &map, int maxQuantity)
                 continue;
 
             if (!tempBestList.isEmpty()) {
-                double weight1 = tempBestList.first().first.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
-                double weight2 = item->extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
+                double weight1 = tempBestList.first().first.weight;
+                double weight2 = item->weight;
                 // 最佳匹配权重最高项高于组别第一项超过21
                 if (weight1 - weight2 >= WeightDiffLimit) {
                     break;
@@ -546,7 +648,7 @@ void Utils::packageBestMatch(MatchedItemMap &map, int maxQuantity)
                     auto it = tempBestList.begin();
                     for (; it != tempBestList.end(); ++it) {
                         // 寻找插入位置
-                        double weightBest = it->first.extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 0).toDouble();
+                        double weightBest = it->first.weight;
                         if (weight2 > weightBest) {
                             tempBestList.insert(it, qMakePair(*item, group));
                             break;
@@ -602,17 +704,9 @@ void Utils::packageBestMatch(MatchedItemMap &map, int maxQuantity)
 
 double Utils::calcRecordWeight(const MatchedItem &item)
 {
-    auto recordHash = AccessRecord::instance()->getRecord();
-
-    double weight = 0.0;
-    if (recordHash.contains(item.searcher)) {
-        auto itemHash = recordHash[item.searcher];
-        if (itemHash.contains(item.item)) {
-            weight += itemHash[item.item] * TimesWeight;
-        }
-    }
-
-    return weight;
+    // 访问热度按指数衰减，上限与原先七天内点击次数的上限一致
+    const double frecency = AccessRecord::instance()->frecency(item.searcher, item.item);
+    return qMin(frecency, MaxRecordTimes) * TimesWeight;
 }
 
 bool Utils::isResetSearcher(QString searcher)
@@ -640,36 +734,15 @@ QString Utils::appIconName(const MatchedItem &item)
         return item.icon;
     } else if (item.searcher == GRANDSEARCH_CLASS_WEB_STATICTEXT) {
         // 默认浏览器图标
-        auto defaultDesktopFile = defaultBrowser();
-        if (!defaultDesktopFile.isEmpty()) {
-            DDesktopEntry entry(defaultDesktopFile);
-            strAppIconName = entry.stringValue("Icon");
-        }
+        strAppIconName = AppIconResolver::instance()->iconName(defaultBrowser());
     } else if (item.searcher == GRANDSEARCH_CLASS_SETTING_CONTROLCENTER) {
-        auto defaultDesktopFile = "/usr/share/applications/dde-control-center.desktop";
-        if (QFile::exists(defaultDesktopFile)) {
-            DDesktopEntry entry(defaultDesktopFile);
-            strAppIconName = entry.stringValue("Icon");
-        } else {
-            qWarning() << defaultDesktopFile << "lost.";
-        }
-
+        strAppIconName = AppIconResolver::instance()->iconName(ControlCenterDesktopFile);
         if (strAppIconName.isEmpty())
             strAppIconName = "preferences-system";
     } else {
-        // 搜索结果为文件，查询该文件对应默认打开应用图标的名称
-        QString mimetype = item.type;
-        if (mimetype.isEmpty())
-            mimetype = getFileMimetype(item.item);
-
-        QString defaultDesktopFile = getDefaultAppDesktopFileByMimeType(mimetype);
-        if (m_appIconNameMap.find(defaultDesktopFile) == m_appIconNameMap.end()) {
-            DDesktopEntry entry(defaultDesktopFile);
-            strAppIconName = entry.stringValue("Icon");
-            m_appIconNameMap[defaultDesktopFile] = strAppIconName;
-        } else {
-            strAppIconName = m_appIconNameMap[defaultDesktopFile];
-        }
+        // 搜索结果为文件，查询该文件对应默认打开应用图标的名称，类型未探测完成时使用占位类型
+        const QString mimetype = MimeTypeResolver::instance()->mimeType(item.item, item.type);
+        strAppIconName = AppIconResolver::instance()->defaultAppIconName(mimetype);
     }
 
     return strAppIconName;
@@ -850,10 +923,8 @@ bool Utils::openFile(const MatchedItem &item)
     qCDebug(logGrandSearch) << "Opening file:" << filePath;
     bool result = false;
 
-    // 获取mimetype
-    QString mimetype = item.type;
-    if (mimetype.isEmpty())
-        mimetype = getFileMimetype(item.item);
+    // 获取mimetype，打开文件需要准确的类型
+    const QString mimetype = MimeTypeResolver::instance()->resolveNow(item.item, item.type);
 
     qCDebug(logGrandSearch) << "File mimetype determined:" << mimetype;
 
@@ -1031,7 +1102,8 @@ QIcon Utils::defaultIcon(const MatchedItem &item)
              || item.searcher == GRANDSEARCH_CLASS_FILE_FULLTEXT
              || item.searcher == GRANDSEARCH_CLASS_OCR_TEXT
              || item.searcher == GRANDSEARCH_CLASS_FILE_SEMANTIC) {
-        return QIcon::fromTheme(m_mimeDb.mimeTypeForFile(item.item).genericIconName());
+        const QString mimetype = MimeTypeResolver::instance()->mimeType(item.item, item.type);
+        return QIcon::fromTheme(m_mimeDb.mimeTypeForName(mimetype).genericIconName());
     } else if (item.searcher == GRANDSEARCH_CLASS_WEB_STATICTEXT) {
         // 使用默认浏览器的图标
         QString iconName = appIconName(item);
@@ -1044,11 +1116,34 @@ QIcon Utils::defaultIcon(const MatchedItem &item)
     return QIcon();
 }
 
+/**
+ * @brief Utils::warmUpAppIcons 后台预先解析常见文件类型的默认应用图标
+ */
+void Utils::warmUpAppIcons()
+{
+    static const QStringList commonMimeTypes {
+        DefaultBrowserMimeType,
+        "inode/directory",
+        "text/plain",
+        "text/html",
+        "application/pdf",
+        "application/zip",
+        "application/msword",
+        "application/vnd.openxmlformats-officedocument.wordprocessingml.document",
+        "application/vnd.openxmlformats-officedocument.spreadsheetml.sheet",
+        "application/vnd.openxmlformats-officedocument.presentationml.presentation",
+        "image/png",
+        "image/jpeg",
+        "video/mp4",
+        "audio/mpeg"
+    };
+
+    AppIconResolver::instance()->warmUp(commonMimeTypes);
+}
+
 QString Utils::defaultBrowser()
 {
-    static QString mimetype = "x-scheme-handler/http";
-    QString defaultDesktopFile = getDefaultAppDesktopFileByMimeType(mimetype);
-    return defaultDesktopFile;
+    return AppIconResolver::instance()->defaultDesktopFile(DefaultBrowserMimeType);
 }
 
 bool Utils::isLevelItem(const MatchedItem &item, int &level)
@@ -16,6 +16,7 @@ class Utils
 {
 public:
     // 排序算法 用于搜索结果排序 规则为：中文 > 英文 > 其他语言 > 标点符号
+    // 每项预先计算排序键后再排序，结果与逐对调用 compareByString 一致
     static bool sort(MatchedItems &list, Qt::SortOrder order = Qt::AscendingOrder);
 
     static bool compareByString(QString str1, QString str2, Qt::SortOrder order = Qt::AscendingOrder);
@@ -44,8 +45,9 @@ public:
     static bool setWeightMethod(MatchedItem &item);
 
     // 计算文件类的权重
-    static double calcFileWeight(const QString &path, const QString &name, const QStringList &keys);
+    static double calcFileWeight(const MatchedItem &item, const QStringList &keys);
     static qint64 calcDateDiff(const QDateTime &date1, const QDateTime &date2);
+    static qint64 calcDateDiff(qint64 secs1, qint64 secs2);
     static double calcWeightByDateDiff(const qint64 &diff, const int &type);
 
     // 计算应用和设置的权重
@@ -98,6 +100,9 @@ public:
 
     // 默认浏览器的desktop文件
     static QString defaultBrowser();
+    // 后台预热常见文件类型的默认应用图标
+    static void warmUpAppIcons();
+
     /*!
      * \brief isLevelItem 判断item是否属于分层项，并输出具体的层级
      * \param item 待判断的搜索结果项
@@ -121,7 +126,6 @@ public:
                               const QStringList &actions, const QVariantMap &hints);
 
 private:
-    static QMap<QString, QString> m_appIconNameMap;// 存放应用desktop文件对应的图标名称，用于搜索框应用图标刷新
     static QMimeDatabase m_mimeDb;
 };
 
@@ -11,6 +11,8 @@
 #include <QFileInfo>
 #include <QRect>
 #include <QDateTime>
+#include <QtConcurrent>
+#include <QThreadPool>
 #include <QLoggingCategory>
 
 extern "C"
@@ -23,23 +25,38 @@ Q_LOGGING_CATEGORY(logAudioPreview, "org.deepin.dde.grandsearch.plugin.audio")
 GRANDSEARCH_USE_NAMESPACE
 using namespace GrandSearch::audio_preview;
 
+namespace {
+static const QString kKeyArtist = "Artist";
+static const QString kKeyAlbum = "Album";
+static const QString kKeyDuration = "Duration";
+
+static const int kArtistIndex = 0;
+static const int kAlbumIndex = 1;
+static const int kDurationIndex = 2;
+}
+
 AudioPreviewPlugin::AudioPreviewPlugin(QObject *parent)
     : QObject (parent)
     , PreviewPlugin()
+    , m_prefetchPool(new QThreadPool(this))
 {
+    m_prefetchPool->setMaxThreadCount(1);
     qCDebug(logAudioPreview) << "AudioPreviewPlugin created";
 }
 
 AudioPreviewPlugin::~AudioPreviewPlugin()
 {
     qCDebug(logAudioPreview) << "AudioPreviewPlugin destroyed";
+    cancelDecode();
+    prefetch({});
     if (m_audioView)
         m_audioView->deleteLater();
 }
 
 void AudioPreviewPlugin::init(QObject *proxyInter)
 {
-    Q_UNUSED(proxyInter)
+    m_proxy = proxyInter;
+    m_metaCache = requestMediaMetaCache(m_proxy);
     qCDebug(logAudioPreview) << "Initializing AudioPreviewPlugin";
     if (!m_audioView) {
         m_audioView = new AudioView();
@@ -58,12 +75,14 @@ bool AudioPreviewPlugin::previewItem(const ItemInfo &item)
     qCDebug(logAudioPreview) << "Previewing audio file - Path:" << path;
 
     m_audioView->setItemInfo(item);
+    m_detailInfos.clear();
 
-    AudioFileInfo afi;
-    AudioFileInfo::AudioMetaData amd = afi.openAudioFile(path);
-
-    qCDebug(logAudioPreview) << "Audio metadata - Artist:" << amd.artist
-                             << "Album:" << amd.album << "Duration:" << amd.duration;
+    // 元数据在后台读取，先以占位内容显示，读取完成后通过代理更新详情
+    cancelDecode();
+    m_decode.reset(new AudioDecodeBridge);
+    m_decode->decoding = true;
+    connect(m_decode.get(), &AudioDecodeBridge::sigUpdateInfo, this, &AudioPreviewPlugin::updateInfo);
+    QtConcurrent::run(&AudioDecodeBridge::decode, m_decode, m_metaCache, path);
 
     // 歌手 尾部截断
     DetailTagInfo tagInfos;
@@ -71,7 +90,7 @@ bool AudioPreviewPlugin::previewItem(const ItemInfo &item)
     tagInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideNone));
 
     DetailContentInfo contentInfos;
-    contentInfos.insert(DetailInfoProperty::Text, QVariant(amd.artist.isEmpty() ? "--" : amd.artist));
+    contentInfos.insert(DetailInfoProperty::Text, QVariant(QString("--")));
     contentInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideRight));
 
     DetailInfo detailInfo = qMakePair(tagInfos, contentInfos);
@@ -83,32 +102,19 @@ bool AudioPreviewPlugin::previewItem(const ItemInfo &item)
     tagInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideNone));
 
     contentInfos.clear();
-    contentInfos.insert(DetailInfoProperty::Text, QVariant(amd.album.isEmpty() ? "--" : amd.album));
+    contentInfos.insert(DetailInfoProperty::Text, QVariant(QString("--")));
     contentInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideRight));
 
     detailInfo = qMakePair(tagInfos, contentInfos);
     m_detailInfos.push_back(detailInfo);
 
     // 时长
-    if (amd.duration.isEmpty()) {
-        AVFormatContext *avFmormat = avformat_alloc_context();
-        avformat_open_input(&avFmormat, path.toStdString().c_str(), nullptr, nullptr);
-        if (avFmormat) {
-            avformat_find_stream_info(avFmormat, nullptr);
-            qint64 dura = avFmormat->duration / (qint64)AV_TIME_BASE;
-            if (dura >= 0)
-                amd.duration = CommonTools::durationString(dura);
-        }
-        avformat_close_input(&avFmormat);
-        avformat_free_context(avFmormat);
-    }
-
     tagInfos.clear();
     tagInfos.insert(DetailInfoProperty::Text, QVariant(tr("Duration:")));
     tagInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideNone));
 
     contentInfos.clear();
-    contentInfos.insert(DetailInfoProperty::Text, QVariant(amd.duration.isEmpty() ? "--" : amd.duration));
+    contentInfos.insert(DetailInfoProperty::Text, QVariant(QString("--")));
     contentInfos.insert(DetailInfoProperty::ElideMode, QVariant::fromValue(Qt::ElideRight));
 
     detailInfo = qMakePair(tagInfos, contentInfos);
@@ -168,9 +174,59 @@ ItemInfo AudioPreviewPlugin::item() const
 bool AudioPreviewPlugin::stopPreview()
 {
     qCDebug(logAudioPreview) << "Stopping audio preview";
+    cancelDecode();
     return true;
 }
 
+void AudioPreviewPlugin::cancelDecode()
+{
+    if (m_decode.isNull())
+        return;
+
+    m_decode->decoding = false;
+    disconnect(m_decode.get(), nullptr, this, nullptr);
+    m_decode.reset();
+}
+
+bool AudioPreviewPlugin::prefetch(const QStringList &files)
+{
+    // 新的预取替换尚未完成的预取
+    if (!m_prefetch.isNull())
+        m_prefetch->decoding = false;
+    m_prefetchPool->clear();
+    m_prefetch.reset();
+
+    if (files.isEmpty())
+        return true;
+
+    qCDebug(logAudioPreview) << "Prefetching audio files:" << files;
+    m_prefetch.reset(new AudioDecodeBridge);
+    m_prefetch->decoding = true;
+    QtConcurrent::run(m_prefetchPool, &AudioDecodeBridge::prefetch, m_prefetch, m_metaCache, files);
+    return true;
+}
+
+void AudioPreviewPlugin::updateInfo(const QVariantHash &info)
+{
+    bool updateDetail = false;
+    auto updateContent = [&](const QString &key, int index) {
+        if (!info.contains(key) || m_detailInfos.size() <= index)
+            return;
+
+        const QString text = info.value(key).toString();
+        m_detailInfos[index].second.insert(DetailInfoProperty::Text, QVariant(text.isEmpty() ? QString("--") : text));
+        updateDetail = true;
+    };
+
+    updateContent(kKeyArtist, kArtistIndex);
+    updateContent(kKeyAlbum, kAlbumIndex);
+    updateContent(kKeyDuration, kDurationIndex);
+
+    //使用代理更新详情
+    if (updateDetail && m_proxy)
+        requestUpdateDetailInfo(m_proxy, this);
+}
+
 QWidget *AudioPreviewPlugin::contentWidget() const
 {
     return m_audioView;
@@ -190,3 +246,81 @@ bool AudioPreviewPlugin::showToolBar() const
 {
     return true;
 }
+
+void AudioDecodeBridge::decode(QSharedPointer<AudioDecodeBridge> self, QObject *cache, const QString &file)
+{
+    if (!self->decoding)
+        return;
+
+    // 缓存命中时不再读取文件
+    QVariantHash cached;
+    QImage frame;
+    if (requestCachedMediaMeta(cache, file, cached, frame)) {
+        qCDebug(logAudioPreview) << "Audio metadata loaded from cache - Path:" << file;
+        if (self->decoding)
+            emit self->sigUpdateInfo(cached);
+        return;
+    }
+
+    AudioFileInfo afi;
+    AudioFileInfo::AudioMetaData amd = afi.openAudioFile(file);
+
+    qCDebug(logAudioPreview) << "Audio metadata - Artist:" << amd.artist
+                             << "Album:" << amd.album << "Duration:" << amd.duration;
+
+    if (!self->decoding)
+        return;
+
+    QVariantHash info;
+    info.insert(kKeyArtist, amd.artist);
+    info.insert(kKeyAlbum, amd.album);
+    if (!amd.duration.isEmpty())
+        info.insert(kKeyDuration, amd.duration);
+
+    // 先更新标签信息，时长需要额外解析文件
+    emit self->sigUpdateInfo(info);
+    if (amd.duration.isEmpty()) {
+        const QString duration = readDuration(file);
+        if (!self->decoding)
+            return;
+
+        if (!duration.isEmpty()) {
+            QVariantHash durationInfo;
+            durationInfo.insert(kKeyDuration, duration);
+            emit self->sigUpdateInfo(durationInfo);
+            info.insert(kKeyDuration, duration);
+        }
+    }
+
+    requestStoreMediaMeta(cache, file, info, QImage());
+}
+
+void AudioDecodeBridge::prefetch(QSharedPointer<AudioDecodeBridge> self, QObject *cache, const QStringList &files)
+{
+    // 没有宿主缓存时预取的结果无处保存
+    if (!cache)
+        return;
+
+    // decode 会先查询缓存，已缓存的文件不再读取
+    for (const QString &file : files) {
+        if (!self->decoding)
+            return;
+        decode(self, cache, file);
+    }
+}
+
+QString AudioDecodeBridge::readDuration(const QString &file)
+{
+    QString duration;
+    AVFormatContext *avFmormat = avformat_alloc_context();
+    avformat_open_input(&avFmormat, file.toStdString().c_str(), nullptr, nullptr);
+    if (avFmormat) {
+        avformat_find_stream_info(avFmormat, nullptr);
+        qint64 dura = avFmormat->duration / (qint64)AV_TIME_BASE;
+        if (dura >= 0)
+            duration = CommonTools::durationString(dura);
+    }
+    avformat_close_input(&avFmormat);
+    avformat_free_context(avFmormat);
+    return duration;
+}
@@ -7,9 +7,30 @@
 
 #include "previewplugin.h"
 
+#include <QSharedPointer>
+#include <QVariantHash>
+
+class QThreadPool;
+
 namespace GrandSearch {
 namespace audio_preview {
 
+class AudioDecodeBridge : public QObject
+{
+    Q_OBJECT
+public:
+    // 在工作线程中读取音频元数据，分阶段发送已获取的信息；self 停止后不再发送
+    static void decode(QSharedPointer<AudioDecodeBridge> self, QObject *cache, const QString &file);
+    // 标签中缺少时长时通过 ffmpeg 读取
+    static QString readDuration(const QString &file);
+    // 依次读取文件元数据写入缓存，不连接信号时仅用于预取
+    static void prefetch(QSharedPointer<AudioDecodeBridge> self, QObject *cache, const QStringList &files);
+signals:
+    void sigUpdateInfo(const QVariantHash &info);
+public:
+    volatile bool decoding = false;
+};
+
 class AudioView;
 class AudioPreviewPlugin : public QObject, public PreviewPlugin
 {
@@ -25,10 +46,20 @@ public:
     DetailInfoList getAttributeDetailInfo() const Q_DECL_OVERRIDE;
     QWidget *toolBarWidget() const Q_DECL_OVERRIDE;
     bool showToolBar() const Q_DECL_OVERRIDE;
+    Q_INVOKABLE bool prefetch(const QStringList &files);
+protected slots:
+    void updateInfo(const QVariantHash &info);
+private:
+    void cancelDecode();
 private:
     ItemInfo m_item;
     DetailInfoList m_detailInfos;
     AudioView *m_audioView = nullptr;
+    QObject *m_proxy = nullptr;
+    QObject *m_metaCache = nullptr;   // 宿主的音视频元数据缓存
+    QSharedPointer<AudioDecodeBridge> m_decode;
+    QSharedPointer<AudioDecodeBridge> m_prefetch;
+    QThreadPool *m_prefetchPool = nullptr;   // 预取单线程执行，不与预览争抢 CPU
 };
 
 }}
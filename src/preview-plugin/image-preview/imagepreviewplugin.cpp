@@ -16,6 +16,10 @@ Q_LOGGING_CATEGORY(logImagePreview, "org.deepin.dde.grandsearch.plugin.image")
 GRANDSEARCH_USE_NAMESPACE
 using namespace GrandSearch::image_preview;
 
+namespace {
+static const int kDimensionIndex = 0;
+}
+
 ImagePreviewPlugin::ImagePreviewPlugin(QObject *parent)
     : QObject (parent)
     , PreviewPlugin()
@@ -34,7 +38,7 @@ ImagePreviewPlugin::~ImagePreviewPlugin()
 
 void ImagePreviewPlugin::init(QObject *proxyInter)
 {
-    Q_UNUSED(proxyInter)
+    m_proxy = proxyInter;
     qCDebug(logImagePreview) << "ImagePreviewPlugin initialized";
 }
 
@@ -56,6 +60,9 @@ bool ImagePreviewPlugin::previewItem(const ItemInfo &item)
                              << "Keywords count:" << keywords.size();
     if (!m_imageView) {
         m_imageView = new ImageView();
+        m_imageView->setThumbnailCache(requestThumbnailCache(m_proxy));
+        // 图片在后台解码，得到尺寸后更新详情
+        connect(m_imageView, &ImageView::sourceSizeChanged, this, &ImagePreviewPlugin::onSourceSizeChanged);
         qCDebug(logImagePreview) << "ImageView created";
     }
 
@@ -64,14 +71,14 @@ bool ImagePreviewPlugin::previewItem(const ItemInfo &item)
     // Set matched context if available - will show context instead of filename
     m_imageView->setMatchedContext(m_matchedContext, keywords);
 
+    m_detailInfos.clear();
+
     // 尺寸
     auto dimension = m_imageView->sourceSize();
     QString dimensionStr("--");
     if (dimension.isValid()) {
         dimensionStr = QString("%1*%2").arg(dimension.width()).arg(dimension.height());
         qCDebug(logImagePreview) << "Image dimensions:" << dimensionStr;
-    } else {
-        qCWarning(logImagePreview) << "Unable to determine image dimensions";
     }
 
     DetailTagInfo tagInfos;
@@ -147,6 +154,19 @@ bool ImagePreviewPlugin::previewItem(const ItemInfo &item)
     return true;
 }
 
+void ImagePreviewPlugin::onSourceSizeChanged(const QSize &size)
+{
+    if (!size.isValid() || m_detailInfos.size() <= kDimensionIndex)
+        return;
+
+    DetailContentInfo &contentInfos = m_detailInfos[kDimensionIndex].second;
+    contentInfos.insert(DetailInfoProperty::Text, QVariant(QString("%1*%2").arg(size.width()).arg(size.height())));
+
+    //使用代理更新详情
+    if (m_proxy)
+        requestUpdateDetailInfo(m_proxy, this);
+}
+
 ItemInfo ImagePreviewPlugin::item() const
 {
     return m_item;
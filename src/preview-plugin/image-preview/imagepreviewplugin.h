@@ -25,9 +25,12 @@ public:
     DetailInfoList getAttributeDetailInfo() const Q_DECL_OVERRIDE;
     QWidget *toolBarWidget() const Q_DECL_OVERRIDE;
     bool showToolBar() const Q_DECL_OVERRIDE;
+private slots:
+    void onSourceSizeChanged(const QSize &size);
 private:
     ItemInfo m_item;
     ImageView *m_imageView = nullptr;
+    QObject *m_proxy = nullptr;
     DetailInfoList m_detailInfos;
     QString m_matchedContext;
 };
@@ -6,6 +6,7 @@
 #include "imageview.h"
 #include "global/commontools.h"
 #include "global/widgets/highlightlabel.h"
+#include "previewproxyinterface.h"
 
 #include <DFontSizeManager>
 #include <DGuiApplicationHelper>
@@ -19,6 +20,7 @@
 #include <QImageReader>
 #include <QBitmap>
 #include <QPainterPath>
+#include <QMimeDatabase>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logImagePreview)
@@ -41,6 +43,7 @@ ImageView::ImageView(QWidget *parent)
 
 ImageView::~ImageView()
 {
+    cancelDecode();
     if (m_movie)
         m_movie->stop();
 }
@@ -52,6 +55,7 @@ QSize ImageView::sourceSize()
 
 bool ImageView::stopPreview()
 {
+    cancelDecode();
     if (m_movie)
         m_movie->stop();
 
@@ -60,6 +64,16 @@ bool ImageView::stopPreview()
 
 void ImageView::loadImage(const QString &file, const QString &type, const QStringList &keywords)
 {
+    // 视图在同类文件间复用，先释放上一张动图
+    if (m_movie) {
+        m_movie->stop();
+        m_movie->deleteLater();
+        m_movie = nullptr;
+    }
+    m_isMovie = false;
+    m_image = QImage();
+    m_sourceSize = QSize();
+
     m_imageFile = file;
     m_formats = type.toLocal8Bit();
 
@@ -75,56 +89,53 @@ void ImageView::loadImage(const QString &file, const QString &type, const QStrin
     else
         m_titleLabel->setToolTip("");
 
-    if (!fileInfo.isReadable() || !canPreview()) {
-        qCWarning(logImagePreview) << "Cannot preview image - File not readable or unsupported format:" << m_imageFile;
-        showErrorPage();
-        return;
-    }
+    // 解码在工作线程中进行，界面线程的耗时与图片大小无关；解码完成前不显示上一张图片
+    cancelDecode();
+    m_imageLabel->clear();
 
-    if (m_formats == QByteArrayLiteral("gif")) {
-        qCDebug(logImagePreview) << "Loading GIF animation:" << m_imageFile;
-        m_isMovie = true;
-        m_movie = new QMovie(this);
-        m_movie->setFileName(m_imageFile);
-        m_movie->start();    // 启动后才能获取到正确的frameRect
+    m_decode.reset(new ImageDecodeBridge);
+    m_decode->decoding = true;
+    connect(m_decode.get(), &ImageDecodeBridge::sigDecoded, this, &ImageView::onImageDecoded);
+    connect(m_decode.get(), &ImageDecodeBridge::sigFailed, this, &ImageView::showErrorPage);
+    QtConcurrent::run(&ImageDecodeBridge::decode, m_decode, m_thumbnailCache, m_imageFile,
+                      QSize(IMAGEWIDTH, IMAGEHEIGHT), devicePixelRatioF());
+}
 
-        connect(m_movie, &QMovie::error, this, &ImageView::showErrorPage);
+void ImageView::cancelDecode()
+{
+    if (m_decode.isNull())
+        return;
 
-        m_sourceSize = m_movie->frameRect().size();
-        m_movie->stop();
-    } else {
-        qCDebug(logImagePreview) << "Loading static image:" << m_imageFile;
-        m_isMovie = false;
-        bool success = m_image.load(m_imageFile, m_formats);
-        if (!success) {
-            qCWarning(logImagePreview) << "Failed to load image:" << m_imageFile;
-            showErrorPage();
-            return;
-        }
-        m_sourceSize = m_image.size();
-    }
+    m_decode->decoding = false;
+    disconnect(m_decode.get(), nullptr, this, nullptr);
+    m_decode.reset();
+}
+
+void ImageView::onImageDecoded(const QImage &image, const QSize &sourceSize, const QByteArray &format)
+{
+    m_decode.reset();
+    m_formats = format;
+    m_sourceSize = sourceSize.isValid() ? sourceSize : image.size();
 
     // 宽高等比缩放，满足宽和高哪个定格，就以哪个为准调整另一个做等比
-    QSize showSize = m_sourceSize;
-    qreal wZoom = qreal(IMAGEWIDTH) / showSize.width();
-    qreal hZoom = qreal(IMAGEHEIGHT) / showSize.height();
-    qreal zoom = wZoom > hZoom ? hZoom : wZoom;
-    // 原始尺寸小于缩略图区域尺寸，不做拉伸
-    if (zoom > 1)
-        zoom = 1;
-    int w = int(showSize.width() * zoom);
-    int h = int(showSize.height() * zoom);
-    m_imageLabel->setFixedSize(w, h);
+    const QSize showSize = ImageDecodeBridge::displaySize(m_sourceSize, QSize(IMAGEWIDTH, IMAGEHEIGHT));
+    m_imageLabel->setFixedSize(showSize);
 
-    if (m_isMovie) {
-        m_movie->setScaledSize(QSize(w, h));
+    if (format == QByteArrayLiteral("gif")) {
+        qCDebug(logImagePreview) << "Loading GIF animation:" << m_imageFile;
+        m_isMovie = true;
+        m_movie = new QMovie(m_imageFile, format, this);
+        m_movie->setScaledSize(showSize);
+        connect(m_movie, &QMovie::error, this, &ImageView::showErrorPage);
         connect(m_movie, &QMovie::frameChanged, this, &ImageView::onMovieFrameChanged);
         m_movie->start();
     } else {
-        QPixmap roundPixmap = getRoundPixmap(QPixmap::fromImage(m_image).scaled(w, h));
+        m_image = image;
+        QPixmap roundPixmap = getRoundPixmap(QPixmap::fromImage(m_image));
         m_imageLabel->setPixmap(roundPixmap);
     }
 
+    emit sourceSizeChanged(m_sourceSize);
 }
 
 void ImageView::setMatchedContext(const QString &context, const QStringList &keywords)
@@ -142,6 +153,11 @@ void ImageView::setMatchedContext(const QString &context, const QStringList &key
     }
 }
 
+void ImageView::setThumbnailCache(QObject *cache)
+{
+    m_thumbnailCache = cache;
+}
+
 void ImageView::initUI()
 {
     setFixedHeight(150);
@@ -199,33 +215,15 @@ void ImageView::initConnect()
 
 }
 
-bool ImageView::canPreview()
-{
-    QByteArray f = QImageReader::imageFormat(m_imageFile);
-
-    if (f.isEmpty()) {
-        QMimeDatabase mimeDatabase;
-        const QMimeType &mt = mimeDatabase.mimeTypeForFile(m_imageFile, QMimeDatabase::MatchContent);
-
-        f = mt.preferredSuffix().toLatin1();
-
-        if (f.isEmpty()) {
-            m_formats.clear();
-            return false;
-        }
-    }
-
-    m_formats = f;
-
-    return QImageReader::supportedImageFormats().contains(f);
-}
-
 QPixmap ImageView::getRoundPixmap(const QPixmap &pixmap)
 {
     int w = m_imageLabel->width();
     int h = m_imageLabel->height();
 
-    QPixmap roundPixmap(w, h);
+    // 按设备像素比绘制，高分屏下不损失解码得到的清晰度
+    const qreal ratio = devicePixelRatioF();
+    QPixmap roundPixmap(QSize(w, h) * ratio);
+    roundPixmap.setDevicePixelRatio(ratio);
     roundPixmap.fill(Qt::transparent);
     QPainter painter(&roundPixmap);
     painter.setRenderHints(QPainter::Antialiasing, true);           // 抗锯齿
@@ -261,3 +259,111 @@ void ImageView::showErrorPage()
     auto errorPixmap = getRoundPixmap(QPixmap::fromImage(errorImg));
     m_imageLabel->setPixmap(errorPixmap);
 }
+
+void ImageDecodeBridge::decode(QSharedPointer<ImageDecodeBridge> self, QObject *cache, const QString &file, const QSize &maxSize, qreal ratio)
+{
+    if (!self->decoding)
+        return;
+
+    const QByteArray format = QFileInfo(file).isReadable() ? imageFormat(file) : QByteArray();
+    if (format.isEmpty()) {
+        qCWarning(logImagePreview) << "Cannot preview image - File not readable or unsupported format:" << file;
+        emit self->sigFailed();
+        return;
+    }
+
+    QImageReader reader(file, format);
+    const QSize sourceSize = reader.size();
+
+    // 动图需逐帧播放，由界面线程创建 QMovie
+    if (format == QByteArrayLiteral("gif")) {
+        if (self->decoding)
+            emit self->sigDecoded(QImage(), sourceSize, format);
+        return;
+    }
+
+    QImage image;
+    if (sourceSize.isValid()) {
+        const QSize targetSize = displaySize(sourceSize, maxSize) * ratio;
+        image = cachedThumbnail(cache, file, targetSize);
+
+        if (image.isNull()) {
+            if (targetSize.width() < sourceSize.width() || targetSize.height() < sourceSize.height())
+                reader.setScaledSize(displaySize(sourceSize, targetSize));
+            image = reader.read();
+        }
+    } else {
+        // 无法预先获取尺寸的格式，完整解码后缩放
+        image = reader.read();
+        if (!image.isNull()) {
+            const QSize targetSize = displaySize(image.size(), maxSize) * ratio;
+            if (targetSize != image.size())
+                image = image.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+        }
+    }
+
+    if (!self->decoding)
+        return;
+
+    if (image.isNull()) {
+        qCWarning(logImagePreview) << "Failed to load image:" << file << reader.errorString();
+        emit self->sigFailed();
+        return;
+    }
+
+    emit self->sigDecoded(image, sourceSize, format);
+}
+
+QByteArray ImageDecodeBridge::imageFormat(const QString &file)
+{
+    QByteArray f = QImageReader::imageFormat(file);
+
+    if (f.isEmpty()) {
+        QMimeDatabase mimeDatabase;
+        const QMimeType &mt = mimeDatabase.mimeTypeForFile(file, QMimeDatabase::MatchContent);
+
+        f = mt.preferredSuffix().toLatin1();
+    }
+
+    if (f.isEmpty() || !QImageReader::supportedImageFormats().contains(f))
+        return QByteArray();
+
+    return f;
+}
+
+QSize ImageDecodeBridge::displaySize(const QSize &sourceSize, const QSize &maxSize)
+{
+    if (sourceSize.isEmpty())
+        return maxSize;
+
+    qreal wZoom = qreal(maxSize.width()) / sourceSize.width();
+    qreal hZoom = qreal(maxSize.height()) / sourceSize.height();
+    qreal zoom = wZoom > hZoom ? hZoom : wZoom;
+    // 原始尺寸小于显示区域尺寸，不做拉伸
+    if (zoom > 1)
+        zoom = 1;
+
+    return QSize(qMax(1, int(sourceSize.width() * zoom)), qMax(1, int(sourceSize.height() * zoom)));
+}
+
+QImage ImageDecodeBridge::cachedThumbnail(QObject *cache, const QString &file, const QSize &targetSize)
+{
+    if (!cache)
+        return QImage();
+
+    // 列表中生成的缩略图足够大时直接缩放使用，避免再次解码原图
+    // 依次对应 XDG 缩略图的 normal、large、x-large 目录
+    const int side = qMax(targetSize.width(), targetSize.height());
+    for (int edge : { 256, 512, 1024 }) {
+        if (edge < side)
+            continue;
+
+        const QImage thumbnail = requestCachedThumbnail(cache, file, edge);
+        if (thumbnail.isNull() || thumbnail.width() < targetSize.width() || thumbnail.height() < targetSize.height())
+            continue;
+
+        return thumbnail.scaled(targetSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+
+    return QImage();
+}
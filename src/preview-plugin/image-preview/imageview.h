@@ -10,12 +10,38 @@
 #include <QByteArray>
 #include <QMovie>
 #include <QVBoxLayout>
+#include <QSharedPointer>
 
 class HighlightLabel;
 
 namespace GrandSearch {
 namespace image_preview {
 
+class ImageDecodeBridge : public QObject
+{
+    Q_OBJECT
+public:
+    /**
+     * @brief 在工作线程中按显示尺寸解码图片
+     * 优先复用宿主缩略图缓存中足够大的缩略图，否则通过 QImageReader::setScaledSize 直接解码到目标尺寸。
+     * 动图只读取尺寸，由界面线程中的 QMovie 播放。self 停止后丢弃结果。
+     * @param cache 宿主的缩略图缓存，为空时不查缓存
+     * @param maxSize 显示区域尺寸
+     * @param ratio 设备像素比
+     */
+    static void decode(QSharedPointer<ImageDecodeBridge> self, QObject *cache, const QString &file, const QSize &maxSize, qreal ratio);
+    // 确定文件可预览的图片格式，不支持时返回空
+    static QByteArray imageFormat(const QString &file);
+    // 在显示区域内等比缩放后的尺寸，不放大
+    static QSize displaySize(const QSize &sourceSize, const QSize &maxSize);
+    static QImage cachedThumbnail(QObject *cache, const QString &file, const QSize &targetSize);
+signals:
+    void sigDecoded(const QImage &image, const QSize &sourceSize, const QByteArray &format);
+    void sigFailed();
+public:
+    volatile bool decoding = false;
+};
+
 class ImageView : public Dtk::Widget::DWidget
 {
     Q_OBJECT
@@ -28,15 +54,19 @@ public:
 
     void loadImage(const QString &file, const QString &type, const QStringList &keywords = QStringList());
     void setMatchedContext(const QString &context, const QStringList &keywords = QStringList());
+    void setThumbnailCache(QObject *cache);
+signals:
+    void sourceSizeChanged(const QSize &size);
 private:
     void initUI();
     void initConnect();
 
-    bool canPreview();
+    void cancelDecode();
 
     QPixmap getRoundPixmap(const QPixmap &pixmap);
 
 private slots:
+    void onImageDecoded(const QImage &image, const QSize &sourceSize, const QByteArray &format);
     void onMovieFrameChanged(int frameNumber);
     void showErrorPage();
 
@@ -48,6 +78,8 @@ private:
     QImage m_image;                     // 图片
     QMovie *m_movie = nullptr;          // gif图片
     bool m_isMovie = false;             // 是否是gif图片
+    QSharedPointer<ImageDecodeBridge> m_decode;     // 当前图片的后台解码
+    QObject *m_thumbnailCache = nullptr;            // 宿主的缩略图缓存
 
     QSize m_sourceSize;                 // 资源尺寸
     QLabel *m_imageLabel;               // 显示图片
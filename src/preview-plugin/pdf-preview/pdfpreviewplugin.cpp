@@ -7,29 +7,40 @@
 #include "pdfview.h"
 
 #include <QFileInfo>
+#include <QThreadPool>
+#include <QtConcurrent>
 #include <QLoggingCategory>
 
 Q_LOGGING_CATEGORY(logPdfPreview, "org.deepin.dde.grandsearch.plugin.pdf")
 GRANDSEARCH_USE_NAMESPACE
 using namespace GrandSearch::pdf_preview;
 
+// 预取的文档大小上限，过大的文档仅在实际预览时解析
+static constexpr qint64 kMaxPrefetchFileSize = 50 * 1024 * 1024;
+
 PDFPreviewPlugin::PDFPreviewPlugin(QObject *parent)
     : QObject (parent)
     , PreviewPlugin()
+    , m_prefetchPool(new QThreadPool(this))
 {
+    m_prefetchPool->setMaxThreadCount(1);
     qCDebug(logPdfPreview) << "PDFPreviewPlugin created";
 }
 
 PDFPreviewPlugin::~PDFPreviewPlugin()
 {
     qCDebug(logPdfPreview) << "PDFPreviewPlugin destroyed";
+    // 预取任务访问本对象的成员，需在析构前结束
+    prefetch({});
+    m_prefetchPool->waitForDone();
     if (m_pdfView)
         m_pdfView->deleteLater();
 }
 
 void PDFPreviewPlugin::init(QObject *proxyInter)
 {
-    Q_UNUSED(proxyInter)
+    m_proxy = proxyInter;
+    m_thumbnailCache = requestThumbnailCache(proxyInter);
     qCDebug(logPdfPreview) << "PDFPreviewPlugin initialized";
 }
 
@@ -50,8 +61,11 @@ bool PDFPreviewPlugin::previewItem(const ItemInfo &item)
     }
 
     if (!m_pdfView) {
-        m_pdfView = new PDFView(path);
+        m_pdfView = new PDFView(path, m_proxy);
         qCDebug(logPdfPreview) << "PDFView created";
+    } else if (path != m_item.value(PREVIEW_ITEMINFO_ITEM) || !m_pdfView->isLoaded()) {
+        // 插件界面在 PDF 文件间复用，切换到新文档；上次加载被取消时重新加载
+        m_pdfView->loadFile(path);
     }
 
     m_item = item;
@@ -72,6 +86,8 @@ QWidget *PDFPreviewPlugin::contentWidget() const
 bool PDFPreviewPlugin::stopPreview()
 {
     qCDebug(logPdfPreview) << "Stopping PDF preview";
+    if (m_pdfView)
+        m_pdfView->cancelLoad();
     return true;
 }
 
@@ -89,3 +105,30 @@ bool PDFPreviewPlugin::showToolBar() const
 {
     return true;
 }
+
+bool PDFPreviewPlugin::prefetch(const QStringList &files)
+{
+    // 新的预取替换尚未完成的预取
+    const quint64 generation = ++m_prefetchGeneration;
+    m_prefetchPool->clear();
+
+    // 渲染宽度取决于预览视图，尚未创建视图时不预取
+    if (files.isEmpty() || !m_pdfView)
+        return files.isEmpty();
+
+    qCDebug(logPdfPreview) << "Prefetching PDF files:" << files;
+    const int width = m_pdfView->firstPageWidth();
+    QObject *cache = m_thumbnailCache;
+    QtConcurrent::run(m_prefetchPool, [this, cache, files, width, generation]() {
+        for (const QString &file : files) {
+            if (generation != m_prefetchGeneration)
+                return;
+
+            if (QFileInfo(file).size() > kMaxPrefetchFileSize)
+                continue;
+
+            PDFView::loadFirstPage(cache, file, width);
+        }
+    });
+    return true;
+}
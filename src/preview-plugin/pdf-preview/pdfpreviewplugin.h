@@ -9,6 +9,10 @@
 
 #include "previewplugin.h"
 
+#include <QAtomicInteger>
+
+class QThreadPool;
+
 namespace GrandSearch {
 namespace pdf_preview {
 
@@ -27,9 +31,14 @@ public:
     DetailInfoList getAttributeDetailInfo() const Q_DECL_OVERRIDE;
     QWidget *toolBarWidget() const Q_DECL_OVERRIDE;
     bool showToolBar() const Q_DECL_OVERRIDE;
+    Q_INVOKABLE bool prefetch(const QStringList &files);
 private:
     ItemInfo m_item;
     PDFView *m_pdfView = nullptr;
+    QObject *m_proxy = nullptr;
+    QObject *m_thumbnailCache = nullptr;            // 宿主的缩略图缓存，与列表缩略图共用
+    QThreadPool *m_prefetchPool = nullptr;          // 预取单线程执行，不与预览争抢 CPU
+    QAtomicInteger<quint64> m_prefetchGeneration;   // 每次预取请求递增，丢弃过期的预取
 };
 
 }}
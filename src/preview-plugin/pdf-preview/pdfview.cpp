@@ -5,7 +5,7 @@
 #include "pdfpreview_global.h"
 #include "pdfview.h"
 #include "global/commontools.h"
-#include "grand-search/gui/exhibition/preview/generalwidget/aitoolbar.h"
+#include "previewproxyinterface.h"
 
 #include <dpdfpage.h>
 
@@ -15,10 +15,6 @@
 #include <QPainter>
 #include <QLabel>
 #include <QPainterPath>
-#include <QApplication>
-#include <QScreen>
-#include <QDBusInterface>
-#include <QDBusReply>
 #include <QLoggingCategory>
 
 Q_DECLARE_LOGGING_CATEGORY(logPdfPreview)
@@ -26,22 +22,18 @@ Q_DECLARE_LOGGING_CATEGORY(logPdfPreview)
 GRANDSEARCH_USE_NAMESPACE
 using namespace GrandSearch::pdf_preview;
 
-#define PAGE_FIXED_SIZE   (PDFView::checkUosAiInstalled() ? QSize(360, 350) : QSize(360, 386))
+// AI 工具栏由宿主显示，按宿主的 UOS AI 安装状态留出工具栏空间
+#define PAGE_FIXED_SIZE   (requestUosAiInstalled(m_proxy) ? QSize(360, 350) : QSize(360, 386))
 
-bool PDFView::checkUosAiInstalled() {
-    QDBusInterface iface("org.freedesktop.DBus", "/org/freedesktop/DBus", "org.freedesktop.DBus");
-    QDBusReply<QStringList> reply = iface.call("ListActivatableNames");
-    if (reply.isValid()) {
-        if (reply.value().contains("com.deepin.copilot")) {
-            return true;
-        }
-    }
-
-    return false;
-}
+// 首页缓存的尺寸等级，与宿主缩略图缓存的 XDG 目录对应
+static constexpr int kNormalEdge = 256;
+static constexpr int kLargeEdge = 512;
+static constexpr int kXLargeEdge = 1024;
 
-PDFView::PDFView(const QString &file, QWidget *parent)
+PDFView::PDFView(const QString &file, QObject *proxy, QWidget *parent)
     : QWidget(parent)
+    , m_proxy(proxy)
+    , m_thumbnailCache(requestThumbnailCache(proxy))
 {
     initDoc(file);
     initUI();
@@ -50,17 +42,40 @@ PDFView::PDFView(const QString &file, QWidget *parent)
 
 PDFView::~PDFView()
 {
-    if (!m_isLoadFinished)
-        m_future.waitForFinished();
+    cancelLoad();
+    for (QFuture<void> &future : m_futures)
+        future.waitForFinished();
 }
 
 void PDFView::initDoc(const QString &file)
 {
-    m_doc.reset(new DPdfDoc(file));
-    if (!m_doc || m_doc->status() != DPdfDoc::SUCCESS) {
-        qCWarning(logPdfPreview) << "Failed to load PDF document - Path:" << file << "Status:" << (m_doc ? m_doc->status() : -1);
-        m_isBadDoc = true;
-    }
+    // 文档在工作线程中打开，首页缓存命中时无需打开文档
+    m_file = file;
+    m_isLoaded = false;
+}
+
+void PDFView::loadFile(const QString &file)
+{
+    cancelLoad();
+    initDoc(file);
+
+    // 恢复上一文档调整过的尺寸
+    this->setFixedSize(PAGE_FIXED_SIZE);
+    m_pageLabel->setMinimumSize(0, 0);
+    m_pageLabel->setMaximumSize(QWIDGETSIZE_MAX, QWIDGETSIZE_MAX);
+    m_pageLabel->clear();
+
+    syncLoadFirstPage();
+}
+
+void PDFView::cancelLoad()
+{
+    ++m_generation;
+}
+
+bool PDFView::isLoaded() const
+{
+    return m_isLoaded;
 }
 
 void PDFView::initUI()
@@ -77,39 +92,43 @@ void PDFView::initUI()
     layout->addWidget(m_pageLabel);
     //layout->addStretch();
 
-    if (m_isBadDoc) {
-        showErrorPage();
-        return;
-    }
     syncLoadFirstPage();
 }
 
 void PDFView::initConnections()
 {
     connect(this, &PDFView::pageUpdate, this, &PDFView::onPageUpdated);
-    connect(this, &PDFView::parseFailed, this, &PDFView::showErrorPage);
+    connect(this, &PDFView::parseFailed, this, &PDFView::onParseFailed);
 }
 
 QPixmap PDFView::scaleAndRound(const QImage &img)
 {
+    // 按设备像素比生成图片，高分屏下不模糊
+    const qreal ratio = devicePixelRatioF();
+    const int width = qRound(m_pageLabel->width() * ratio);
+    const int maxHeight = qRound(PAGE_FIXED_SIZE.height() * ratio);
+
     auto pixmap = QPixmap::fromImage(img);
     // 缩放
-    pixmap = pixmap.scaledToWidth(m_pageLabel->width(), Qt::SmoothTransformation);
+    pixmap = pixmap.scaledToWidth(width, Qt::SmoothTransformation);
 
-    QPixmap destImage(m_pageLabel->width(), std::min(pixmap.height(), PAGE_FIXED_SIZE.height()));
+    QPixmap destImage(width, std::min(pixmap.height(), maxHeight));
     destImage.fill(Qt::transparent);
-    QPainter painter(&destImage);
-    // 抗锯齿
-    painter.setRenderHints(QPainter::Antialiasing, true);
-    // 图片平滑处理
-    painter.setRenderHints(QPainter::SmoothPixmapTransform, true);
-    // 将图片裁剪为圆角
-    QPainterPath path;
-    QRect rect(0, 0, destImage.width(), destImage.height());
-    path.addRoundedRect(rect, 8, 8);
-    painter.setClipPath(path);
-    painter.drawPixmap(0, 0, destImage.width(), destImage.height(), pixmap);
+    {
+        QPainter painter(&destImage);
+        // 抗锯齿
+        painter.setRenderHints(QPainter::Antialiasing, true);
+        // 图片平滑处理
+        painter.setRenderHints(QPainter::SmoothPixmapTransform, true);
+        // 将图片裁剪为圆角
+        QPainterPath path;
+        QRect rect(0, 0, destImage.width(), destImage.height());
+        path.addRoundedRect(rect, 8 * ratio, 8 * ratio);
+        painter.setClipPath(path);
+        painter.drawPixmap(0, 0, destImage.width(), destImage.height(), pixmap);
+    }
 
+    destImage.setDevicePixelRatio(ratio);
     return destImage;
 }
 
@@ -124,14 +143,28 @@ void PDFView::showErrorPage()
     m_pageLabel->setPixmap(errPixmap);
 }
 
-void PDFView::onPageUpdated(QImage img)
+void PDFView::onParseFailed(quint64 generation)
 {
+    if (generation != m_generation)
+        return;
+
+    m_isLoaded = true;
+    showErrorPage();
+}
+
+void PDFView::onPageUpdated(QImage img, quint64 generation)
+{
+    if (generation != m_generation)
+        return;
+
+    m_isLoaded = true;
     auto pixmap = scaleAndRound(img);
     m_pageLabel->setPixmap(pixmap);
 
     // AI工具栏要紧贴预览画面
-    if (pixmap.height() < PAGE_FIXED_SIZE.height()) {
-        this->setFixedHeight((PAGE_FIXED_SIZE.height() - pixmap.height()) / 2 + pixmap.height());
+    const int pageHeight = qRound(pixmap.height() / pixmap.devicePixelRatio());
+    if (pageHeight < PAGE_FIXED_SIZE.height()) {
+        this->setFixedHeight((PAGE_FIXED_SIZE.height() - pageHeight) / 2 + pageHeight);
     } else {
         this->setFixedHeight(PAGE_FIXED_SIZE.height());
     }
@@ -139,29 +172,115 @@ void PDFView::onPageUpdated(QImage img)
 
 void PDFView::syncLoadFirstPage()
 {
-    m_future = QtConcurrent::run([=] {
-        if (m_doc->pageCount() > 0) {
-            qreal docXRes = 72;
-            qreal docYRes = 72;
-            QScreen *srn = QApplication::screens().value(0);
-            if (nullptr != srn) {
-                docXRes = srn->physicalDotsPerInchX();
-                docYRes = srn->physicalDotsPerInchY();
-            }
-
-            DPdfPage *page = m_doc->page(0, docXRes, docYRes);
-            if (!page || !page->isValid()) {
-                emit parseFailed();
-                m_isLoadFinished = true;
-                return;
-            }
-
-            QSizeF size = page->sizeF();
-            QImage img = page->image(static_cast<int>(size.width()), static_cast<int>(size.height()));
-
-            emit pageUpdate(img);
-        }
-
-        m_isLoadFinished = true;
-    });
+    // 清理已结束的任务
+    for (auto it = m_futures.begin(); it != m_futures.end();) {
+        if (it->isFinished())
+            it = m_futures.erase(it);
+        else
+            ++it;
+    }
+
+    const QString file = m_file;
+    QObject *cache = m_thumbnailCache;
+    const quint64 generation = m_generation;
+    const int width = firstPageWidth();
+    m_futures.append(QtConcurrent::run([this, cache, file, width, generation] {
+        // 已切换文档或停止预览
+        if (generation != m_generation)
+            return;
+
+        bool failed = false;
+        QImage img = loadFirstPage(cache, file, width, &failed);
+        if (failed)
+            emit parseFailed(generation);
+        else if (!img.isNull())
+            emit pageUpdate(img, generation);
+    }));
+}
+
+int PDFView::pageWidth() const
+{
+    // 页面标签的宽度，视图尚未显示时标签未完成布局，按视图宽度减去边距计算
+    int margin = 0;
+    if (layout())
+        margin = layout()->contentsMargins().left() + layout()->contentsMargins().right();
+    return width() - margin;
+}
+
+int PDFView::firstPageWidth() const
+{
+    return qRound(pageWidth() * devicePixelRatioF());
+}
+
+QImage PDFView::loadFirstPage(QObject *cache, const QString &file, int width, bool *failed)
+{
+    if (failed)
+        *failed = false;
+
+    // 优先使用缓存的首页，命中时不打开文档
+    QImage img = cachedFirstPage(cache, file, width);
+    if (!img.isNull())
+        return img;
+
+    DPdfDoc doc(file);
+    if (doc.status() != DPdfDoc::SUCCESS) {
+        qCWarning(logPdfPreview) << "Failed to load PDF document - Path:" << file << "Status:" << doc.status();
+        if (failed)
+            *failed = true;
+        return QImage();
+    }
+
+    if (doc.pageCount() <= 0)
+        return QImage();
+
+    DPdfPage *page = doc.page(0);
+    if (page && page->isValid())
+        img = renderFirstPage(cache, page, file, width);
+
+    if (img.isNull() && failed)
+        *failed = true;
+    return img;
+}
+
+QImage PDFView::cachedFirstPage(QObject *cache, const QString &file, int width)
+{
+    if (!cache)
+        return QImage();
+
+    // 依次对应 XDG 缩略图的 normal、large、x-large 目录
+    for (int edge : { kNormalEdge, kLargeEdge, kXLargeEdge }) {
+        if (edge < width && edge != kXLargeEdge)
+            continue;
+
+        // 超长页面在最大尺寸等级下也可能窄于目标宽度，此时仍使用缓存
+        const QImage img = requestCachedThumbnail(cache, file, edge);
+        if (!img.isNull() && (img.width() >= width || edge == kXLargeEdge))
+            return img;
+    }
+
+    return QImage();
+}
+
+QImage PDFView::renderFirstPage(QObject *cache, DPdfPage *page, const QString &file, int width)
+{
+    const QSizeF pageSize = page->sizeF();
+    if (pageSize.isEmpty())
+        return QImage();
+
+    // 按能容纳目标宽度的最小尺寸等级渲染，而非按屏幕 DPI 渲染整页，
+    // 结果写入缩略图缓存，列表中的 PDF 缩略图可直接使用
+    int level = kXLargeEdge;
+    QSize renderSize;
+    for (int edge : { kNormalEdge, kLargeEdge, kXLargeEdge }) {
+        level = edge;
+        renderSize = pageSize.scaled(QSizeF(edge, edge), Qt::KeepAspectRatio).toSize();
+        if (renderSize.width() >= width)
+            break;
+    }
+
+    QImage img = page->image(renderSize.width(), renderSize.height());
+    if (!img.isNull())
+        requestStoreThumbnail(cache, file, level, img);
+
+    return img;
 }
@@ -9,6 +9,7 @@
 
 #include <QWidget>
 #include <QFuture>
+#include <QAtomicInteger>
 
 #include <dpdfdoc.h>
 
@@ -21,31 +22,49 @@ class PDFView : public QWidget
 {
     Q_OBJECT
 public:
-    static bool checkUosAiInstalled();
-
-    explicit PDFView(const QString &file, QWidget *parent = nullptr);
+    // proxy 为宿主的插件代理，提供缩略图缓存和 AI 工具栏状态
+    explicit PDFView(const QString &file, QObject *proxy = nullptr, QWidget *parent = nullptr);
     ~PDFView() Q_DECL_OVERRIDE;
 
     void initDoc(const QString &file);
+    // 切换预览的文档，视图在多个文档间复用
+    void loadFile(const QString &file);
+    // 放弃尚未完成的首页加载
+    void cancelLoad();
+    // 首页或错误页已显示
+    bool isLoaded() const;
     void initUI();
     void initConnections();
     QPixmap scaleAndRound(const QImage &img);
+
+    // 首页渲染的目标物理像素宽度
+    int firstPageWidth() const;
+    // 读取缓存的首页，未命中时打开文档渲染并写入缓存；failed 输出文档是否无法解析
+    static QImage loadFirstPage(QObject *cache, const QString &file, int width, bool *failed = nullptr);
+    // 读取缓存的首页，width 为目标物理像素宽度
+    static QImage cachedFirstPage(QObject *cache, const QString &file, int width);
+    // 按目标宽度渲染首页并写入缓存
+    static QImage renderFirstPage(QObject *cache, DPdfPage *page, const QString &file, int width);
 public slots:
-    void onPageUpdated(QImage img);
+    void onPageUpdated(QImage img, quint64 generation);
+    void onParseFailed(quint64 generation);
     void showErrorPage();
 signals:
-    void pageUpdate(const QImage &img);
-    void parseFailed();
+    void pageUpdate(const QImage &img, quint64 generation);
+    void parseFailed(quint64 generation);
 
 private:
     void syncLoadFirstPage();
+    int pageWidth() const;
 
 private:
     QLabel *m_pageLabel = nullptr;
-    bool m_isBadDoc = false;
-    bool m_isLoadFinished = false;
-    QSharedPointer<DPdfDoc> m_doc = nullptr;
-    QFuture<void> m_future;
+    bool m_isLoaded = false;
+    QString m_file;
+    QObject *m_proxy = nullptr;            // 宿主的插件代理
+    QObject *m_thumbnailCache = nullptr;   // 宿主的缩略图缓存，为空时每次都打开文档渲染
+    QList<QFuture<void>> m_futures;   // 尚未结束的首页加载任务
+    QAtomicInteger<quint64> m_generation;   // 每次切换文档或取消加载时递增，丢弃过期的加载结果
     QImage m_pageImg;
 };
 
@@ -10,6 +10,7 @@
 #include <QFileInfo>
 #include <QDateTime>
 #include <QtConcurrent>
+#include <QThreadPool>
 #include <QPainterPath>
 #include <QLoggingCategory>
 
@@ -36,6 +37,10 @@ static const int kDimensionIndex = 0;
 static const int kDurationIndex = 3;
 
 static const QString kKeyThumbnailer = "Thumbnailer";
+
+// 缓存中的元数据键
+static const QString kKeyCacheDuration = "Duration";
+static const QString kKeyCacheDimension = "Dimension";
 }
 
 using namespace GrandSearch;
@@ -43,7 +48,9 @@ using namespace GrandSearch;
 VideoPreviewPlugin::VideoPreviewPlugin(QObject *parent)
     : QObject(parent)
     , PreviewPlugin()
+    , m_prefetchPool(new QThreadPool(this))
 {
+    m_prefetchPool->setMaxThreadCount(1);
     qCDebug(logVideoPreview) << "VideoPreviewPlugin created";
 }
 
@@ -51,6 +58,7 @@ VideoPreviewPlugin::~VideoPreviewPlugin()
 {
     qCDebug(logVideoPreview) << "VideoPreviewPlugin destroyed";
     stopPreview();
+    prefetch({});
     delete m_view;
 }
 
@@ -58,6 +66,7 @@ void VideoPreviewPlugin::init(QObject *proxyInter)
 {
     qCDebug(logVideoPreview) << "Initializing VideoPreviewPlugin";
     m_proxy = proxyInter;
+    m_metaCache = requestMediaMetaCache(m_proxy);
     if (!m_view) {
         m_view = new VideoView();
         m_view->initUI();
@@ -77,12 +86,19 @@ bool VideoPreviewPlugin::previewItem(const ItemInfo &item)
 
     //开启线程解析
 #ifdef PREVIEW_ASYNC_DECODE
+    // 插件界面在同类文件间复用，丢弃上一项尚未完成的解析结果
+    if (!m_decode.isNull()) {
+        m_decode->decoding = false;
+        disconnect(m_decode.get(), nullptr, this, nullptr);
+    }
+    m_view->setThumbnail(QPixmap());
+
     m_decode.reset(new DecodeBridge);
     m_decode->decoding = true;
     connect(m_decode.get(), &DecodeBridge::sigUpdateInfo, this, &VideoPreviewPlugin::updateInfo);
-    QtConcurrent::run(&DecodeBridge::decode, m_decode, path);
+    QtConcurrent::run(&DecodeBridge::decode, m_decode, m_metaCache, path);
 #else
-    QFuture<QVariantHash> future = QtConcurrent::run(&DecodeBridge::decode, nullptr, path);
+    QFuture<QVariantHash> future = QtConcurrent::run(&DecodeBridge::decode, nullptr, m_metaCache, path);
 #endif
 
     //初始化静态属性
@@ -208,6 +224,24 @@ DetailInfoList VideoPreviewPlugin::getAttributeDetailInfo() const
     return m_infos;
 }
 
+bool VideoPreviewPlugin::prefetch(const QStringList &files)
+{
+    // 新的预取替换尚未完成的预取
+    if (!m_prefetch.isNull())
+        m_prefetch->decoding = false;
+    m_prefetchPool->clear();
+    m_prefetch.reset();
+
+    if (files.isEmpty())
+        return true;
+
+    qCDebug(logVideoPreview) << "Prefetching video files:" << files;
+    m_prefetch.reset(new DecodeBridge);
+    m_prefetch->decoding = true;
+    QtConcurrent::run(m_prefetchPool, &DecodeBridge::prefetch, m_prefetch, m_metaCache, files);
+    return true;
+}
+
 void VideoPreviewPlugin::updateInfo(const QVariantHash &hash, bool needUpdate)
 {
     bool updateDetail = false;
@@ -257,13 +291,55 @@ void VideoPreviewPlugin::updateInfo(const QVariantHash &hash, bool needUpdate)
         requestUpdateDetailInfo(m_proxy, this);
 }
 
-QVariantHash DecodeBridge::decode(QSharedPointer<DecodeBridge> self, const QString &file)
+QVariantHash DecodeBridge::decode(QSharedPointer<DecodeBridge> self, QObject *cache, const QString &file)
 {
     if (!self.isNull() && !self->decoding)
         return {};
 
+    // 优先使用缓存的解析结果，未命中时解码并写入缓存
+    QVariantHash meta;
+    QImage frame;
+    if (requestCachedMediaMeta(cache, file, meta, frame)) {
+        qCDebug(logVideoPreview) << "Video metadata loaded from cache - Path:" << file;
+    } else {
+        if (!DecodeBridge::readMeta(self, file, meta, frame))
+            return {};
+
+        requestStoreMediaMeta(cache, file, meta, frame);
+    }
+
+    //检查一次是否中断
+    if (!self.isNull() && !self->decoding)
+        return {};
+
     QVariantHash info;
+    if (meta.contains(kKeyCacheDuration))
+        info.insert(kLabelDuration, meta.value(kKeyCacheDuration));
+    if (meta.contains(kKeyCacheDimension))
+        info.insert(kLabelDimension, meta.value(kKeyCacheDimension));
+
+    QImage img = frame;
+    if (img.isNull()) {
+        // 预览失败
+        QImage errorImg(":/icons/image_damaged.svg");
+        errorImg = errorImg.scaled(46, 46);
+        img = CommonTools::creatErrorImage({192, 108}, errorImg);
+    }
+
+    //缩放与圆角处理
+    QPixmap pixmap = DecodeBridge::scaleAndRound(img, VideoView::maxThumbnailSize());
+    info.insert(kKeyThumbnailer, QVariant::fromValue(pixmap));
+
+    if (!self.isNull()) {
+        self->decoding = false;
+        emit self->sigUpdateInfo(info, true);
+    }
 
+    return info;
+}
+
+bool DecodeBridge::readMeta(QSharedPointer<DecodeBridge> self, const QString &file, QVariantHash &meta, QImage &frame)
+{
     //获取分辨率和时长
     AVFormatContext *avCtx = nullptr;
     qint64 duration = 0;
@@ -275,8 +351,8 @@ QVariantHash DecodeBridge::decode(QSharedPointer<DecodeBridge> self, const QStri
                 AVStream *videoStream = avCtx->streams[videoRet];
                 AVCodecParameters *codecpar = videoStream->codecpar;
                 duration = avCtx->duration / (qint64)AV_TIME_BASE;
-                info.insert(kLabelDuration, QVariant::fromValue(duration));
-                info.insert(kLabelDimension, QSize(codecpar->width, codecpar->height));
+                meta.insert(kKeyCacheDuration, QVariant::fromValue(duration));
+                meta.insert(kKeyCacheDimension, QSize(codecpar->width, codecpar->height));
             } else {
                 qCWarning(logVideoPreview) << "Failed to find video stream - Error code:" << videoRet << "File:" << file;
             }
@@ -289,56 +365,53 @@ QVariantHash DecodeBridge::decode(QSharedPointer<DecodeBridge> self, const QStri
 
     //检查一次是否停止
     if (!self.isNull() && !self->decoding)
-        return {};
+        return false;
 
-    //时长大于0才获取预览图
+    //时长大于0才获取预览图，预览图为空时显示损坏图标
     if (duration > 0) {
         //获取预览图
         video_thumbnailer *thumbnailer = video_thumbnailer_create();
         //缩略图最大size
-         auto maxSize = VideoView::maxThumbnailSize();
-         thumbnailer->thumbnail_size = qMax(maxSize.width(), maxSize.height());
+        auto maxSize = VideoView::maxThumbnailSize();
+        thumbnailer->thumbnail_size = qMax(maxSize.width(), maxSize.height());
 
         //第一秒
         thumbnailer->seek_time = const_cast<char *>("00:00:01");
 
         image_data *imageData = video_thumbnailer_create_image_data();
         if (video_thumbnailer_generate_thumbnail_to_buffer(thumbnailer, stdStr.c_str(), imageData) == 0) {
-            QImage img = QImage::fromData(imageData->image_data_ptr,
-                                          static_cast<int>(imageData->image_data_size), "png");
-            //缩放与圆角处理
-            QPixmap pixmap = DecodeBridge::scaleAndRound(img, maxSize);
-            info.insert(kKeyThumbnailer, QVariant::fromValue(pixmap));
+            frame = QImage::fromData(imageData->image_data_ptr,
+                                           static_cast<int>(imageData->image_data_size), "png");
         } else {
             // 预览失败
             qCWarning(logVideoPreview) << "Failed to generate video thumbnail - File:" << file;
-            QImage errorImg(":/icons/image_damaged.svg");
-            errorImg = errorImg.scaled(46, 46);
-            auto img = CommonTools::creatErrorImage({192, 108}, errorImg);
-            QPixmap pixmap = DecodeBridge::scaleAndRound(img, maxSize);
-            info.insert(kKeyThumbnailer, QVariant::fromValue(pixmap));
         }
         video_thumbnailer_destroy_image_data(imageData);
         video_thumbnailer_destroy(thumbnailer);
-    } else {
-        // 预览失败
-        QImage errorImg(":/icons/image_damaged.svg");
-        errorImg = errorImg.scaled(46, 46);
-        auto img = CommonTools::creatErrorImage({192, 108}, errorImg);
-        QPixmap pixmap = DecodeBridge::scaleAndRound(img, VideoView::maxThumbnailSize());
-        info.insert(kKeyThumbnailer, QVariant::fromValue(pixmap));
     }
 
-    //检查一次是否中断
-    if (!self.isNull() && !self->decoding)
-        return {};
+    //检查一次是否中断，中断的结果不完整，不写入缓存
+    return self.isNull() || self->decoding;
+}
 
-    if (!self.isNull()) {
-        self->decoding = false;
-        emit self->sigUpdateInfo(info, true);
-    }
+void DecodeBridge::prefetch(QSharedPointer<DecodeBridge> self, QObject *cache, const QStringList &files)
+{
+    // 没有宿主缓存时预取的结果无处保存
+    if (!cache)
+        return;
 
-    return info;
+    for (const QString &file : files) {
+        if (!self->decoding)
+            return;
+
+        QVariantHash meta;
+        QImage frame;
+        if (requestCachedMediaMeta(cache, file, meta, frame))
+            continue;
+
+        if (DecodeBridge::readMeta(self, file, meta, frame))
+            requestStoreMediaMeta(cache, file, meta, frame);
+    }
 }
 
 QPixmap DecodeBridge::scaleAndRound(const QImage &img, const QSize &size)
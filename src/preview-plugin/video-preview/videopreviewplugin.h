@@ -10,6 +10,8 @@
 #include <QFuture>
 #include <QSharedPointer>
 
+class QThreadPool;
+
 namespace GrandSearch {
 namespace video_preview {
 
@@ -19,7 +21,11 @@ class DecodeBridge : public QObject
 public:
     DecodeBridge();
     ~DecodeBridge();
-    static QVariantHash decode(QSharedPointer<DecodeBridge> self, const QString &file);
+    static QVariantHash decode(QSharedPointer<DecodeBridge> self, QObject *cache, const QString &file);
+    // 解析时长、尺寸并生成预览帧，被中断时返回 false
+    static bool readMeta(QSharedPointer<DecodeBridge> self, const QString &file, QVariantHash &meta, QImage &frame);
+    // 依次解析未缓存的文件并写入缓存，不发送结果
+    static void prefetch(QSharedPointer<DecodeBridge> self, QObject *cache, const QStringList &files);
     static QPixmap scaleAndRound(const QImage &img, const QSize &size);
 signals:
     void sigUpdateInfo(const QVariantHash &, bool needUpdate);
@@ -42,6 +48,7 @@ public:
     QWidget *toolBarWidget() const Q_DECL_OVERRIDE;
     bool showToolBar() const Q_DECL_OVERRIDE;
     DetailInfoList getAttributeDetailInfo() const Q_DECL_OVERRIDE;
+    Q_INVOKABLE bool prefetch(const QStringList &files);
 protected slots:
     void updateInfo(const QVariantHash &, bool needUpdate);
 protected:
@@ -49,7 +56,10 @@ protected:
     DetailInfoList m_infos;
     VideoView *m_view = nullptr;
     QObject *m_proxy = nullptr;
+    QObject *m_metaCache = nullptr;   // 宿主的音视频元数据缓存
     QSharedPointer<DecodeBridge> m_decode;
+    QSharedPointer<DecodeBridge> m_prefetch;
+    QThreadPool *m_prefetchPool = nullptr;   // 预取单线程执行，不与预览争抢 CPU
 };
 
 }}
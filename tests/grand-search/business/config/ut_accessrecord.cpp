@@ -13,6 +13,9 @@
 #include <stub.h>
 
 #include <QJsonObject>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
 #include <QIODevice>
 #include <QFile>
 #include <QtCore/qfiledevice.h>
@@ -32,161 +35,79 @@ TEST(AccessRecordTest, init)
     delete accessRecord;
 }
 
-TEST(AccessRecordTest, startParseRecord)
-{
-    auto recordPath = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).first();
-    AccessRecord::instance()->m_recordPath = recordPath
-            + "/" + QApplication::organizationName()
-            + "/" + GRANDSEARCH_NAME
-            +"/" + "accessrecord.json";
-    QFileInfo file(recordPath);
-    QFile file1(recordPath);
-    file1.remove();
-    AccessRecord::instance()->startParseRecord();
-    bool result = file.exists();
-    EXPECT_TRUE(result);
-}
-
 TEST(AccessRecordTest, updateRecord)
 {
+    AccessRecord accessRecord;
+
     GrandSearch::MatchedItem item;
     item.searcher = "test";
     item.item = "test1";
-    qint64 time = 1;
-
-    AccessRecord::instance()->m_recordObj.insert("version", "1.0");
-
-    // 原记录中不包含该searcher
-    QJsonObject recordObjNew;
-    QJsonObject itemObj;
-    QJsonArray array = {1};
-    itemObj.insert("test1", array);
-    recordObjNew.insert("test", itemObj);
-    recordObjNew.insert("version", "1.0");
-
-    AccessRecord::instance()->updateRecord(item, time);
-    EXPECT_EQ(AccessRecord::instance()->m_recordObj, recordObjNew);
-
-    // 原记录中包含该searcher但不包含该item
-    item.item = "test2";
-    itemObj.insert("test2", array);
-    recordObjNew.insert("test", itemObj);
-    AccessRecord::instance()->updateRecord(item, time);
-    EXPECT_EQ(AccessRecord::instance()->m_recordObj, recordObjNew);
-
-    // 原记录中包含该searcher并包含该item
-    time = 2;
-    array = {1, 2};
-    itemObj.insert("test2", array);
-    recordObjNew.insert("test", itemObj);
-    AccessRecord::instance()->updateRecord(item, time);
-    EXPECT_EQ(AccessRecord::instance()->m_recordObj, recordObjNew);
+    const qint64 time = QDateTime::currentSecsSinceEpoch();
+
+    // 解析完成前的点击先缓存
+    accessRecord.updateRecord(item, time);
+    EXPECT_EQ(accessRecord.m_earlyRecords.size(), 1);
+    EXPECT_DOUBLE_EQ(accessRecord.frecency("test", "test1"), 0);
+
+    emit accessRecord.sigParseFinished(FrecencyStore(), AccessRecord::QPrivateSignal());
+    EXPECT_TRUE(accessRecord.m_finished);
+    EXPECT_TRUE(accessRecord.m_earlyRecords.isEmpty());
+    EXPECT_NEAR(accessRecord.frecency("test", "test1"), 1, 0.01);
+
+    accessRecord.updateRecord(item, time);
+    EXPECT_NEAR(accessRecord.frecency("test", "test1"), 2, 0.01);
+    EXPECT_DOUBLE_EQ(accessRecord.frecency("test", "test2"), 0);
 }
 
 TEST(AccessRecordTest, sync)
 {
+    QTemporaryDir dir;
     AccessRecord accessRecord;
-    accessRecord.m_finished = true;
-    accessRecord.m_recordPath = "./test";
-    QFile file(accessRecord.m_recordPath);
-    file.open(QFile::Truncate);
-    file.close();
+    accessRecord.m_recordPath = dir.filePath("accessrecord.log");
 
-    accessRecord.m_recordObj.insert("aaa", "1");
+    GrandSearch::MatchedItem item;
+    item.searcher = "test";
+    item.item = "test1";
+    const qint64 time = QDateTime::currentSecsSinceEpoch();
+
+    // 解析未完成时不回写
+    accessRecord.updateRecord(item, time);
     accessRecord.sync();
-    file.open(QFile::ReadOnly);
-    QByteArray array = file.readAll();
-    file.close();
-    QJsonDocument doc(QJsonDocument::fromJson(array));
-    QJsonObject obj = doc.object();
-    EXPECT_EQ(obj, accessRecord.m_recordObj);
+    EXPECT_FALSE(QFile::exists(accessRecord.m_recordPath));
 
+    accessRecord.m_finished = true;
+    accessRecord.updateRecord(item, time);
+    accessRecord.sync();
+
+    FrecencyStore store;
+    ASSERT_TRUE(store.load(accessRecord.m_recordPath, time));
+    EXPECT_NEAR(store.score("test", "test1", time), 1, 0.01);
 }
 
 TEST(AccessRecordTest, parseRecord)
 {
-    // 对parseJson打桩，文件存在解析数据
-    bool parse = false;
-    stub_ext::StubExt stu;
-    stu.set_lamda(&AccessRecord::parseJson, [&]() {
-        parse = true;
-    });
-
-    // 文件不存在
-    QFile tempFile(AccessRecord::instance()->m_recordPath);
-    tempFile.remove();
-
-    AccessRecord::parseRecord(AccessRecord::instance()->m_recordPath);
-
-    auto recordPath = QStandardPaths::standardLocations(QStandardPaths::GenericCacheLocation).first();
-    AccessRecord::instance()->m_recordPath = recordPath
-            + "/" + QApplication::organizationName()
-            + "/" + GRANDSEARCH_NAME
-            +"/" + "accessrecord.json";
-    QFileInfo file(recordPath);
-    bool result = file.exists();
-    EXPECT_TRUE(result);
-    EXPECT_TRUE(parse);
-}
+    QTemporaryDir dir;
+    const QString logPath = dir.filePath("accessrecord.log");
+    const QString legacyPath = dir.filePath("accessrecord.json");
 
-TEST(AccessRecordTest, parseJson)
-{
-    // 文件打开成功解析json成功
+    // 旧版记录：过期的点击衰减后被丢弃
+    const qint64 currentTimeT = QDateTime::currentSecsSinceEpoch();
     QJsonObject searcher;
     QJsonObject item;
-    QJsonArray time;
-    time.append(1647743325);
-    const qint64 currentTimeT = QDateTime::currentDateTime().toSecsSinceEpoch();
-    time.append(currentTimeT);
-    item.insert("test1", time);
+    item.insert("test1", QJsonArray { double(currentTimeT), double(currentTimeT) });
+    item.insert("test2", QJsonArray { 1647743325 });
     searcher.insert("a", item);
-    time.removeLast();
-    item.insert("test1", time);
-    item.insert("test2", time);
-    searcher.insert("b", item);
-    time.removeLast();
-    for (int i = 0; i < 21; ++i) {
-        time.append(currentTimeT);
-    }
-    time.append(1647743200);
-    item.insert("test3", time);
-    searcher.insert("c", item);
     searcher.insert("version", "1.0");
-    QJsonDocument doc(searcher);
-    QByteArray data = doc.toJson();
-
-    // 对读取文件进行打桩
-    stub_ext::StubExt stu;
-    stu.set_lamda(&QFile::readAll, [&]() {
-        return data;
-    });
-
-    AccessRecord::parseJson(AccessRecord::instance()->m_recordPath);
-
-    QJsonObject searcherNew;
-    QJsonObject itemNew;
-    QJsonArray timeNew;
-    timeNew.append(currentTimeT);
-    itemNew.insert("test1", timeNew);
-    searcherNew.insert("a", itemNew);
-    timeNew.removeLast();
-    for (int i = 0; i < 21; ++i) {
-        timeNew.append(currentTimeT);
-    }
-    QJsonObject itemAnotherNew;
-    itemAnotherNew.insert("test3", timeNew);
-    searcherNew.insert("c", itemAnotherNew);
-    searcherNew.insert("version", "1.0");
-
-    QHash<QString, QHash<QString, int>> searcherHash;
-    QHash<QString, int> itemHash;
-    itemHash.insert("test1", 1);
-    searcherHash.insert("a", itemHash);
-    itemHash.clear();
-    itemHash.insert("test3", 20);
-    searcherHash.insert("c", itemHash);
-
-    AccessRecord::parseJson(AccessRecord::instance()->m_recordPath);
-    EXPECT_EQ(searcherNew, AccessRecord::instance()->m_recordObj);
-    EXPECT_EQ(searcherHash, AccessRecord::instance()->m_recordHash);
+    QFile legacyFile(legacyPath);
+    ASSERT_TRUE(legacyFile.open(QFile::WriteOnly));
+    legacyFile.write(QJsonDocument(searcher).toJson());
+    legacyFile.close();
+
+    AccessRecord::parseRecord(logPath, legacyPath);
+
+    EXPECT_TRUE(QFile::exists(logPath));
+    const FrecencyStore &store = AccessRecord::instance()->store();
+    EXPECT_NEAR(store.score("a", "test1", currentTimeT), 2, 0.01);
+    EXPECT_EQ(store.find("a", "test2"), nullptr);
+    EXPECT_EQ(store.count(), 1);
 }
@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "business/config/accessrecord/frecencystore.h"
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include <cmath>
+
+using namespace GrandSearch;
+
+TEST(FrecencyStoreTest, decay)
+{
+    FrecencyStore store;
+    const qint64 now = 1700000000;
+
+    store.touch("s", "a", now);
+    store.touch("s", "a", now);
+    EXPECT_DOUBLE_EQ(store.score("s", "a", now), 2);
+
+    // 经过一个平均寿命后衰减为 1/e
+    EXPECT_NEAR(store.score("s", "a", now + FrecencyStore::MeanLifetime), 2 / M_E, 1e-9);
+    EXPECT_DOUBLE_EQ(store.score("s", "b", now), 0);
+    EXPECT_EQ(store.find("t", "a"), nullptr);
+}
+
+TEST(FrecencyStoreTest, appendAndCompact)
+{
+    QTemporaryDir dir;
+    const QString logPath = dir.filePath("frecency.log");
+    const qint64 now = 1700000000;
+
+    FrecencyStore store;
+    for (int i = 0; i < 100; ++i)
+        store.touch("s", "a", now);
+    store.touch("s", "b", now);
+    ASSERT_TRUE(store.flush(logPath));
+    EXPECT_TRUE(store.needsCompaction());
+
+    FrecencyStore loaded;
+    ASSERT_TRUE(loaded.load(logPath, now));
+    EXPECT_DOUBLE_EQ(loaded.score("s", "a", now), 100);
+    EXPECT_DOUBLE_EQ(loaded.score("s", "b", now), 1);
+    EXPECT_TRUE(loaded.needsCompaction());
+
+    const qint64 logSize = QFileInfo(logPath).size();
+    ASSERT_TRUE(loaded.compact(logPath, now));
+    EXPECT_LT(QFileInfo(logPath).size(), logSize);
+    EXPECT_FALSE(loaded.needsCompaction());
+
+    FrecencyStore compacted;
+    ASSERT_TRUE(compacted.load(logPath, now));
+    EXPECT_EQ(compacted.count(), 2);
+    EXPECT_DOUBLE_EQ(compacted.score("s", "a", now), 100);
+}
+
+TEST(FrecencyStoreTest, damagedTail)
+{
+    QTemporaryDir dir;
+    const QString logPath = dir.filePath("frecency.log");
+    const qint64 now = 1700000000;
+
+    FrecencyStore store;
+    store.touch("s", "a", now);
+    ASSERT_TRUE(store.flush(logPath));
+
+    // 模拟写入中断留下的残缺记录
+    QFile file(logPath);
+    ASSERT_TRUE(file.open(QFile::WriteOnly | QFile::Append));
+    file.write("broken");
+    file.close();
+
+    FrecencyStore loaded;
+    ASSERT_TRUE(loaded.load(logPath, now));
+    EXPECT_DOUBLE_EQ(loaded.score("s", "a", now), 1);
+    EXPECT_TRUE(loaded.needsCompaction());
+}
@@ -7,6 +7,9 @@
 #include <gtest/gtest.h>
 
 #include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QDBusMessage>
+#include <QDBusPendingReply>
 
 #define private public
 #define protected public
@@ -14,14 +17,59 @@
 #include "business/matchresult/matchcontroller_p.h"
 #include "utils/utils.h"
 #include "global/matcheditem.h"
+#include "global/builtinsearch.h"
 
 #include "interfaces/daemongrandsearchinterface.h"
 
 using namespace testing;
 using namespace GrandSearch;
 
+namespace {
+
+// 延迟统计读写临时目录，不使用用户的 ~/.cache
+class LatencyFileStub
+{
+public:
+    LatencyFileStub()
+    {
+        stu.set_lamda(&MatchControllerPrivate::defaultLatencyFilePath, [this]() {
+            return dir.filePath("searcherlatency.json");
+        });
+    }
+
+    QTemporaryDir dir;
+    stub_ext::StubExt stu;
+};
+
+QDBusPendingReply<QByteArray> matchedReply(const MatchedItemMap &items)
+{
+    QByteArray bytes;
+    QDataStream stream(&bytes, QIODevice::WriteOnly);
+    stream << items;
+
+    QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                      "org.freedesktop.DBus", "Ping");
+    return QDBusPendingReply<QByteArray>(msg.createReply(QVariant::fromValue(bytes)));
+}
+
+MatchedItemMap matchedItems(const QStringList &searchers)
+{
+    MatchedItemMap items;
+    for (const QString &searcher : searchers) {
+        MatchedItem item;
+        item.item = "/tmp/" + searcher;
+        item.name = searcher;
+        item.searcher = searcher;
+        items[GRANDSEARCH_GROUP_FILE].append(item);
+    }
+    return items;
+}
+
+}
+
 TEST(MatchController, constructor)
 {
+    LatencyFileStub latencyFile;
     MatchController *matchController = new MatchController;
     ASSERT_TRUE(matchController);
     ASSERT_TRUE(matchController->d_p);
@@ -30,6 +78,7 @@ TEST(MatchController, constructor)
 
 TEST(MatchController, onMissionIdChanged)
 {
+    LatencyFileStub latencyFile;
     MatchController matchController;
 
     QString id("aaaa");
@@ -43,6 +92,7 @@ TEST(MatchController, onMissionIdChanged)
 
 TEST(MatchControllerPrivate, constructor)
 {
+    LatencyFileStub latencyFile;
     bool isCall = false;
     stub_ext::StubExt stu;
     stu.set_lamda(ADDR(MatchControllerPrivate, initConnect), [&](){
@@ -57,6 +107,7 @@ TEST(MatchControllerPrivate, constructor)
 
 TEST(MatchControllerPrivate, initConnect)
 {
+    LatencyFileStub latencyFile;
     MatchController matchController;
     matchController.d_p->initConnect();
 
@@ -92,6 +143,7 @@ TEST(MatchControllerPrivate, initConnect)
 
 TEST(MatchControllerPrivate, onMatched)
 {
+    LatencyFileStub latencyFile;
     stub_ext::StubExt stu;
     stu.set_lamda(&DaemonGrandSearchInterface::MatchedBuffer, [](){
         QDBusPendingReply<QByteArray> reply;;
@@ -151,6 +203,7 @@ TEST(MatchControllerPrivate, onMatched)
 
 TEST(MatchControllerPrivate, onSearchCompleted)
 {
+    LatencyFileStub latencyFile;
     bool reciveSig = false;
     MatchController matchController;
     QObject::connect(&matchController, &MatchController::searchCompleted, qApp, [&](){
@@ -174,3 +227,186 @@ TEST(MatchControllerPrivate, onSearchCompleted)
     EXPECT_TRUE(reciveSig);
     EXPECT_TRUE(calledSend);
 }
+
+TEST(MatchControllerPrivate, latencyFilePath)
+{
+    LatencyFileStub latencyFile;
+    const QString path = latencyFile.dir.filePath("searcherlatency.json");
+    {
+        MatchController matchController;
+        EXPECT_EQ(matchController.d_p->latencyFilePath(), path);
+        matchController.d_p->m_latency.addSample(GRANDSEARCH_CLASS_APP_DESKTOP, 10);
+    }
+
+    // 析构时保存到指定路径
+    EXPECT_TRUE(QFile::exists(path));
+}
+
+TEST(MatchControllerPrivate, commitReportedOnCompleted)
+{
+    LatencyFileStub latencyFile;
+    stub_ext::StubExt stu;
+    MatchedItemMap ut_items = matchedItems({GRANDSEARCH_CLASS_APP_DESKTOP});
+    stu.set_lamda(&DaemonGrandSearchInterface::MatchedBuffer, [&]() {
+        return matchedReply(ut_items);
+    });
+    stu.set_lamda(ADDR(Utils, updateItemsWeight), []() {
+    });
+
+    MatchController matchController;
+    MatchControllerPrivate *d = matchController.d_p.data();
+
+    // 中途被替换的任务不计入延迟统计
+    matchController.onMissionChanged("mission1", "a");
+    d->onMatched("mission1");
+    EXPECT_TRUE(d->m_pendingSamples.contains(GRANDSEARCH_CLASS_APP_DESKTOP));
+    EXPECT_FALSE(d->m_latency.m_histograms.contains(GRANDSEARCH_CLASS_APP_DESKTOP));
+
+    matchController.onMissionChanged("mission2", "ab");
+    EXPECT_TRUE(d->m_pendingSamples.isEmpty());
+
+    // 完成的任务计入延迟和上报比例
+    ut_items = matchedItems({GRANDSEARCH_CLASS_APP_DESKTOP, GRANDSEARCH_CLASS_FILE_DEEPIN});
+    d->onMatched("mission2");
+    EXPECT_FALSE(d->m_latency.m_histograms.contains(GRANDSEARCH_CLASS_APP_DESKTOP));
+
+    d->onSearchCompleted("mission2");
+    EXPECT_TRUE(d->m_pendingSamples.isEmpty());
+    EXPECT_TRUE(d->m_latency.m_histograms.contains(GRANDSEARCH_CLASS_APP_DESKTOP));
+    EXPECT_TRUE(d->m_latency.m_histograms.contains(GRANDSEARCH_CLASS_FILE_DEEPIN));
+    EXPECT_DOUBLE_EQ(d->m_latency.reportRate(GRANDSEARCH_CLASS_APP_DESKTOP), 1);
+}
+
+TEST(MatchControllerPrivate, releaseOnSources)
+{
+    LatencyFileStub latencyFile;
+    stub_ext::StubExt stu;
+    MatchedItemMap ut_items;
+    stu.set_lamda(&DaemonGrandSearchInterface::MatchedBuffer, [&]() {
+        return matchedReply(ut_items);
+    });
+    stu.set_lamda(ADDR(Utils, updateItemsWeight), []() {
+    });
+
+    QStringList ut_expected;
+    stu.set_lamda(&SearcherLatency::chooseWait, [&](SearcherLatency *, const QStringList &, int, QStringList *expected) {
+        if (expected)
+            *expected = ut_expected;
+        return 300;
+    });
+
+    QStringList ut_reasons;
+    stu.set_lamda(&SearcherLatency::addDecision, [&](SearcherLatency *, int, qint64, const QString &reason) {
+        ut_reasons << reason;
+    });
+
+    MatchController matchController;
+    MatchControllerPrivate *d = matchController.d_p.data();
+    QSignalSpy spy(&matchController, &MatchController::matchedResult);
+
+    // 首批数据已包含全部预期的搜索项，立即发送
+    ut_expected = QStringList({GRANDSEARCH_CLASS_APP_DESKTOP});
+    ut_items = matchedItems({GRANDSEARCH_CLASS_APP_DESKTOP});
+    matchController.onMissionChanged("mission1", "a");
+    d->onMatched("mission1");
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_FALSE(d->m_waitTimer->isActive());
+    EXPECT_EQ(ut_reasons, QStringList({"sources"}));
+
+    // 预期的搜索项在等待期间陆续上报，全部上报后提前发送
+    ut_expected = QStringList({GRANDSEARCH_CLASS_APP_DESKTOP, GRANDSEARCH_CLASS_FILE_DEEPIN});
+    matchController.onMissionChanged("mission2", "ab");
+    d->onMatched("mission2");
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_TRUE(d->m_waitTimer->isActive());
+
+    ut_items = matchedItems({GRANDSEARCH_CLASS_FILE_DEEPIN});
+    d->onMatched("mission2");
+    EXPECT_EQ(spy.count(), 2);
+    EXPECT_FALSE(d->m_waitTimer->isActive());
+    EXPECT_EQ(ut_reasons, QStringList({"sources", "sources"}));
+}
+
+TEST(MatchControllerPrivate, waitCompensation)
+{
+    LatencyFileStub latencyFile;
+    stub_ext::StubExt stu;
+    stu.set_lamda(&DaemonGrandSearchInterface::MatchedBuffer, [&]() {
+        return matchedReply(matchedItems({GRANDSEARCH_CLASS_APP_DESKTOP}));
+    });
+    stu.set_lamda(ADDR(Utils, updateItemsWeight), []() {
+    });
+    stu.set_lamda(&SearcherLatency::chooseWait, [](SearcherLatency *, const QStringList &, int, QStringList *expected) {
+        if (expected)
+            *expected = QStringList({GRANDSEARCH_CLASS_APP_DESKTOP, GRANDSEARCH_CLASS_FILE_DEEPIN});
+        return 300;
+    });
+
+    qint64 ut_elapsed = 200;
+    stu.set_lamda(&QElapsedTimer::elapsed, [&]() {
+        return ut_elapsed;
+    });
+
+    MatchController matchController;
+    MatchControllerPrivate *d = matchController.d_p.data();
+
+    // 等待时间从任务开始计算，扣除首批数据到达前已经过的时间
+    matchController.onMissionChanged("mission1", "a");
+    d->onMatched("mission1");
+    EXPECT_TRUE(d->m_waitTimer->isActive());
+    EXPECT_EQ(d->m_waitTimer->interval(), 100);
+
+    // 已超过等待时间，不再等待
+    ut_elapsed = 400;
+    matchController.onMissionChanged("mission2", "ab");
+    d->onMatched("mission2");
+    EXPECT_EQ(d->m_waitTimer->interval(), 0);
+    d->m_waitTimer->stop();
+}
+
+TEST(MatchControllerPrivate, releaseOnTimeoutAndCompleted)
+{
+    LatencyFileStub latencyFile;
+    stub_ext::StubExt stu;
+    stu.set_lamda(&DaemonGrandSearchInterface::MatchedBuffer, [&]() {
+        return matchedReply(matchedItems({GRANDSEARCH_CLASS_APP_DESKTOP}));
+    });
+    stu.set_lamda(ADDR(Utils, updateItemsWeight), []() {
+    });
+    stu.set_lamda(&SearcherLatency::chooseWait, [](SearcherLatency *, const QStringList &, int, QStringList *expected) {
+        if (expected)
+            *expected = QStringList({GRANDSEARCH_CLASS_APP_DESKTOP, GRANDSEARCH_CLASS_FILE_DEEPIN});
+        return 300;
+    });
+
+    QStringList ut_reasons;
+    stu.set_lamda(&SearcherLatency::addDecision, [&](SearcherLatency *, int, qint64, const QString &reason) {
+        ut_reasons << reason;
+    });
+
+    MatchController matchController;
+    MatchControllerPrivate *d = matchController.d_p.data();
+    QSignalSpy spy(&matchController, &MatchController::matchedResult);
+
+    // 预期的搜索项未全部上报，超时后发送
+    matchController.onMissionChanged("mission1", "a");
+    d->onMatched("mission1");
+    EXPECT_TRUE(d->m_waitTimer->isActive());
+    d->m_waitTimer->stop();
+    d->onWaitTimeout();
+    EXPECT_EQ(spy.count(), 1);
+    EXPECT_EQ(ut_reasons, QStringList({"timeout"}));
+
+    // 等待期间搜索结束，立即发送
+    matchController.onMissionChanged("mission2", "ab");
+    d->onMatched("mission2");
+    EXPECT_TRUE(d->m_waitTimer->isActive());
+    d->onSearchCompleted("mission2");
+    EXPECT_FALSE(d->m_waitTimer->isActive());
+    EXPECT_EQ(spy.count(), 2);
+    EXPECT_EQ(ut_reasons, QStringList({"timeout", "completed"}));
+
+    // 每个任务只记录一次发送时机
+    d->onWaitTimeout();
+    EXPECT_EQ(ut_reasons, QStringList({"timeout", "completed"}));
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "business/matchresult/searcherlatency.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+
+using namespace testing;
+using namespace GrandSearch;
+
+TEST(SearcherLatency, quantile)
+{
+    SearcherLatency latency;
+    EXPECT_EQ(latency.quantile("a", 0.9), -1);
+
+    latency.addSample("a", 10);
+    latency.addSample("a", 60);
+    EXPECT_EQ(latency.quantile("a", 0.9), -1);
+
+    for (int i = 0; i < 8; ++i)
+        latency.addSample("a", 60);
+    latency.addSample("a", 900);
+
+    EXPECT_EQ(latency.quantile("a", 0.5), 75);
+    EXPECT_EQ(latency.quantile("a", 0.99), 1000);
+}
+
+TEST(SearcherLatency, chooseWait)
+{
+    SearcherLatency latency;
+    QStringList expected;
+
+    // 没有统计时使用固定等待时间
+    EXPECT_EQ(latency.chooseWait({ "a", "b" }, 500, &expected), 500);
+    EXPECT_TRUE(expected.isEmpty());
+
+    for (int i = 0; i < 5; ++i) {
+        latency.addSample("a", 40);
+        latency.addSample("b", 180);
+        latency.finishMission({ "a", "b" });
+    }
+
+    EXPECT_EQ(latency.chooseWait({ "a", "b" }, 500, &expected), 220);
+    EXPECT_EQ(expected, QStringList({ "a", "b" }));
+    EXPECT_EQ(latency.chooseWait({ "a", "b" }, 100), 100);
+
+    // 很少上报结果的搜索项不再参与等待
+    for (int i = 0; i < 30; ++i) {
+        latency.addSample("a", 40);
+        latency.finishMission({ "a" });
+    }
+
+    EXPECT_EQ(latency.chooseWait({ "a", "b" }, 500, &expected), 70);
+    EXPECT_EQ(expected, QStringList { "a" });
+}
+
+TEST(SearcherLatency, saveAndLoad)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("latency/searcherlatency.json");
+
+    SearcherLatency latency;
+    for (int i = 0; i < 5; ++i)
+        latency.addSample("a", 120);
+    latency.finishMission({ "a" });
+    latency.addDecision(170, 130, "sources");
+    EXPECT_TRUE(latency.isDirty());
+    EXPECT_TRUE(latency.save(path));
+    EXPECT_FALSE(latency.isDirty());
+
+    SearcherLatency loaded;
+    EXPECT_TRUE(loaded.load(path));
+    EXPECT_EQ(loaded.quantile("a", 0.9), 150);
+    EXPECT_DOUBLE_EQ(loaded.reportRate("a"), 1);
+}
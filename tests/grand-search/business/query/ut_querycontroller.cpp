@@ -8,6 +8,7 @@
 #include <gtest/gtest.h>
 
 #include <QDBusPendingReply>
+#include <QDBusMessage>
 
 #define private public
 #define protected public
@@ -126,3 +127,77 @@ TEST(QueryControllerPrivate, onSearchCompleted)
     queryController.d_p->onSearchCompleted(missionId);
     EXPECT_FALSE(queryController.d_p->m_keepAliveTimer->isActive());
 }
+
+TEST(QueryControllerPrivate, debounceDelay)
+{
+    // 停顿后的首次输入立即搜索，短文本保留防抖
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("abcd", -1, 80), 0);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("ab", -1, 80), 150);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay(".", -1, 80), 650);
+
+    // 后端响应快于按键间隔时立即搜索，否则等到输入停顿
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("abcd", 120, 80), 0);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("abcd", 120, 200), 180);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("abcd", 120, -1), 180);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("abcd", 400, 600), 300);
+    EXPECT_EQ(QueryControllerPrivate::debounceDelay("ab", 60, 200), 150);
+}
+
+TEST(QueryControllerPrivate, recordDaemonLatency)
+{
+    QueryController queryController;
+
+    queryController.d_p->m_missionId = "testId";
+    queryController.d_p->m_waitingResponse = true;
+    queryController.d_p->m_searchTimer.start();
+    queryController.d_p->onMatched("otherId");
+    EXPECT_TRUE(queryController.d_p->m_waitingResponse);
+
+    queryController.d_p->onMatched("testId");
+    EXPECT_FALSE(queryController.d_p->m_waitingResponse);
+    EXPECT_GE(queryController.d_p->m_daemonLatency, 0);
+}
+
+TEST(QueryControllerPrivate, recordSupersededLatency)
+{
+    QueryController queryController;
+    QueryControllerPrivate *d = queryController.d_p.data();
+
+    stub_ext::StubExt stu;
+    stu.set_lamda(ADDR(DaemonGrandSearchInterface, Search), [](){
+        QDBusMessage msg = QDBusMessage::createMethodCall("org.freedesktop.DBus", "/org/freedesktop/DBus",
+                                                          "org.freedesktop.DBus", "Ping");
+        return QDBusPendingReply<bool>(msg.createReply(QVariant::fromValue(true)));
+    });
+
+    qint64 ut_elapsed = 400;
+    stu.set_lamda(&QElapsedTimer::elapsed, [&](){
+        return ut_elapsed;
+    });
+
+    // 尚无统计时，被替换的搜索不提供有效的延迟
+    d->m_pendingSearchText = "a";
+    d->performSearch();
+    EXPECT_TRUE(d->m_waitingResponse);
+    d->m_pendingSearchText = "ab";
+    d->performSearch();
+    EXPECT_DOUBLE_EQ(d->m_daemonLatency, -1);
+
+    // 被替换前已超过平均延迟，以已过去的时间作为下界计入
+    d->m_daemonLatency = 100;
+    d->m_pendingSearchText = "abc";
+    d->performSearch();
+    EXPECT_DOUBLE_EQ(d->m_daemonLatency, 100 * 0.7 + 400 * 0.3);
+    EXPECT_TRUE(d->m_waitingResponse);
+
+    // 未超过平均延迟时不拉低统计
+    ut_elapsed = 50;
+    d->m_pendingSearchText = "abcd";
+    d->performSearch();
+    EXPECT_DOUBLE_EQ(d->m_daemonLatency, 100 * 0.7 + 400 * 0.3);
+
+    // 已响应的搜索按实际延迟计入
+    d->onMatched(d->m_missionId);
+    EXPECT_FALSE(d->m_waitingResponse);
+    EXPECT_DOUBLE_EQ(d->m_daemonLatency, (100 * 0.7 + 400 * 0.3) * 0.7 + 50 * 0.3);
+}
@@ -13,6 +13,7 @@
 #include <QPaintEvent>
 #include <QEvent>
 #include <QWidget>
+#include <QSignalSpy>
 
 using namespace testing;
 using namespace GrandSearch;
@@ -56,3 +57,41 @@ TEST(GrandSearchListModelTest, flags)
     flags = m.flags(index);
     EXPECT_TRUE(flags.testFlag(Qt::ItemIsDragEnabled));
 }
+
+TEST(GrandSearchListModelTest, indexesForPath)
+{
+    GrandSearchListModel m(0, 1);
+    m.appendRow(new QStandardItem);
+    m.appendRow(new QStandardItem);
+    m.setItemPath(m.index(0, 0), "/tmp/a");
+    m.setItemPath(m.index(1, 0), "/tmp/b");
+
+    // 插入行后索引随之移动
+    m.insertRow(0, new QStandardItem);
+    auto indexes = m.indexesForPath("/tmp/b");
+    ASSERT_EQ(indexes.size(), 1);
+    EXPECT_EQ(indexes.first().row(), 2);
+
+    // 删除行后不再返回
+    m.removeRow(1);
+    EXPECT_TRUE(m.indexesForPath("/tmp/a").isEmpty());
+
+    m.clear();
+    EXPECT_TRUE(m.indexesForPath("/tmp/b").isEmpty());
+}
+
+TEST(GrandSearchListModelTest, batchUpdate)
+{
+    GrandSearchListModel m(4, 1);
+    QSignalSpy spy(&m, &QAbstractItemModel::dataChanged);
+
+    m.beginBatchUpdate();
+    m.setData(m.index(1, 0), 1, Qt::UserRole);
+    m.setData(m.index(3, 0), 3, Qt::UserRole);
+    EXPECT_EQ(spy.count(), 0);
+    m.endBatchUpdate();
+
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().at(0).value<QModelIndex>().row(), 1);
+    EXPECT_EQ(spy.first().at(1).value<QModelIndex>().row(), 3);
+}
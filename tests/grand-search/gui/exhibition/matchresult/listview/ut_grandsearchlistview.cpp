@@ -413,3 +413,77 @@ TEST(GrandSearchListViewTest, levelItemLastRow)
     allCount = w.levelItemLastRow(GRANDSEARCH_PROPERTY_ITEM_LEVEL_SECOND);
     EXPECT_EQ(allCount, 2);
 }
+
+TEST(GrandSearchListViewTest, updateThumbnailRequests)
+{
+    GrandSearchListView w;
+
+    MatchedItem item;
+    item.item = "/tmp/test.png";
+    item.type = "image/png";
+    w.setMatchedItems({ item });
+
+    // 不可见的列表不发起请求，并撤销已有请求
+    w.m_thumbnailRequests.insert("/tmp/old.png", 0);
+    w.updateThumbnailRequests();
+    EXPECT_TRUE(w.m_thumbnailRequests.isEmpty());
+
+    w.m_thumbnailRequests.insert("/tmp/old.png", 0);
+    w.clear();
+    EXPECT_TRUE(w.m_thumbnailRequests.isEmpty());
+}
+
+TEST(GrandSearchListViewTest, onThumbnailFailed)
+{
+    GrandSearchListView w;
+
+    // 失败和被取消的请求不再占用记录，失败的文件本次搜索中不再请求
+    w.m_thumbnailRequests.insert("/tmp/a.png", 0);
+    w.m_thumbnailRequests.insert("/tmp/b.png", 0);
+    w.onThumbnailFailed("/tmp/a.png");
+
+    // 其他请求方的任务被取消时保留本视图的请求记录
+    GrandSearchListView other;
+    w.onThumbnailCanceled("/tmp/b.png", &other);
+    EXPECT_TRUE(w.m_thumbnailRequests.contains("/tmp/b.png"));
+    w.onThumbnailCanceled("/tmp/b.png", nullptr);
+    EXPECT_TRUE(w.m_thumbnailRequests.contains("/tmp/b.png"));
+
+    w.onThumbnailCanceled("/tmp/b.png", &w);
+    EXPECT_TRUE(w.m_thumbnailRequests.isEmpty());
+    EXPECT_TRUE(w.m_failedThumbnails.contains("/tmp/a.png"));
+    EXPECT_FALSE(w.m_failedThumbnails.contains("/tmp/b.png"));
+
+    // 其他请求方的失败不影响本视图
+    w.onThumbnailFailed("/tmp/c.png");
+    EXPECT_FALSE(w.m_failedThumbnails.contains("/tmp/c.png"));
+
+    w.clear();
+    EXPECT_TRUE(w.m_failedThumbnails.isEmpty());
+}
+
+TEST(GrandSearchListViewTest, onMimeTypeResolved)
+{
+    GrandSearchListView w;
+
+    MatchedItem item;
+    item.item = "/tmp/noSuffixFile";
+    w.setMatchedItems({ item });
+    w.m_thumbnailTimer->stop();
+
+    stub_ext::StubExt stu;
+    bool ut_call_setData = false;
+    stu.set_lamda(ADDR(GrandSearchListView, setData), [&](){
+        ut_call_setData = true;
+    });
+    bool ut_call_setItemIcon = false;
+    stu.set_lamda(ADDR(GrandSearchListView, setItemIcon), [&](){
+        ut_call_setItemIcon = true;
+    });
+
+    // 类型探测完成后只刷新图标并重新调度缩略图，不重新请求高亮内容
+    w.onMimeTypeResolved(item.item);
+    EXPECT_TRUE(ut_call_setItemIcon);
+    EXPECT_FALSE(ut_call_setData);
+    EXPECT_TRUE(w.m_thumbnailTimer->isActive());
+}
@@ -319,3 +319,37 @@ TEST(GroupWidgettTest, paintEvent)
     w.paintEvent(&event);
     EXPECT_TRUE(ut_call);
 }
+
+TEST(GroupWidgettTest, deduplicateByPath)
+{
+    GroupWidget w;
+
+    auto makeItem = [](const QString &path, double weight) {
+        MatchedItem item;
+        item.item = path;
+        item.hasWeight = true;
+        item.weight = weight;
+        return item;
+    };
+
+    MatchedItems items;
+    for (int i = 0; i < 8; ++i)
+        items << makeItem(QString("/tmp/%1").arg(i), i);
+    w.appendMatchedItems(items, GRANDSEARCH_GROUP_FILE);
+
+    // 低权重的重复项被丢弃，高权重的重复项原地更新
+    w.appendMatchedItems({ makeItem("/tmp/1", 0), makeItem("/tmp/7", 20), makeItem("/tmp/8", 1) },
+                         GRANDSEARCH_GROUP_FILE);
+
+    double weight = 0;
+    EXPECT_TRUE(w.containsPath("/tmp/1", &weight));
+    EXPECT_DOUBLE_EQ(weight, 1);
+    EXPECT_TRUE(w.containsPath("/tmp/7", &weight));
+    EXPECT_DOUBLE_EQ(weight, 20);
+    EXPECT_TRUE(w.containsPath("/tmp/8"));
+    EXPECT_EQ(w.findItemByPath("/tmp/7").item, QString("/tmp/7"));
+    EXPECT_EQ(w.m_firstFiveItems.size() + w.m_cacheItems.size() + w.m_cacheWeightItems.size(), 9);
+
+    w.clear();
+    EXPECT_FALSE(w.containsPath("/tmp/1"));
+}
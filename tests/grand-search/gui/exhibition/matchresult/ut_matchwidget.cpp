@@ -543,6 +543,106 @@ TEST(MatchWidgetTest, onSelectItemByMouse)
 //     EXPECT_EQ(spy.count(), 1);
 // }
 
+TEST(MatchWidgetTest, prefetchAdjacentItems)
+{
+    MatchWidget w;
+
+    stub_ext::StubExt stu;
+    stu.set_lamda(ADDR(QWidget, isVisible), [](){
+        return true;
+    });
+
+    QStringList ut_highlights;
+    stu.set_lamda(&GrandSearchListView::requestHighlightContent, [&](GrandSearchListView *, const MatchedItem &item, bool highPriority){
+        EXPECT_TRUE(highPriority);
+        ut_highlights << item.item;
+    });
+
+    QStringList ut_prefetched;
+    QObject::connect(&w, &MatchWidget::sigPrefetchItems, &w, [&](const MatchedItems &items){
+        for (const MatchedItem &item : items)
+            ut_prefetched << item.item;
+    });
+
+    auto createGroup = [&](const QString &searchGroupName, const QStringList &paths) {
+        GroupWidget *group = new GroupWidget(&w);
+        group->setSearchGroupName(searchGroupName);
+        MatchedItems items;
+        for (const QString &path : paths) {
+            MatchedItem item;
+            item.item = path;
+            items << item;
+        }
+        group->getListView()->setMatchedItems(items);
+        return group;
+    };
+
+    // 应用类目不支持预览，跨类目预取时跳过
+    GroupWidget *fileGroup = createGroup(GRANDSEARCH_GROUP_FILE, {"/a0", "/a1", "/a2"});
+    GroupWidget *appGroup = createGroup(GRANDSEARCH_GROUP_APP, {"/b0"});
+    GroupWidget *folderGroup = createGroup(GRANDSEARCH_GROUP_FOLDER, {"/c0", "/c1"});
+    w.m_vGroupWidgets = {fileGroup, appGroup, folderGroup};
+
+    auto select = [&](GroupWidget *group, int row) {
+        for (GroupWidget *g : w.m_vGroupWidgets) {
+            g->getViewMoreButton()->setSelected(false);
+            g->getListView()->setCurrentIndex(QModelIndex());
+        }
+
+        if (!group)
+            return;
+
+        if (row < 0)
+            group->getViewMoreButton()->setSelected(true);
+        else
+            group->getListView()->setCurrentIndex(group->getListView()->model()->index(row, 0));
+
+        ut_highlights.clear();
+        ut_prefetched.clear();
+    };
+
+    // 1. 没有选中项时不预取
+    select(nullptr, 0);
+    w.prefetchAdjacentItems(true);
+    EXPECT_TRUE(ut_prefetched.isEmpty());
+    EXPECT_TRUE(ut_highlights.isEmpty());
+
+    // 2. 向后预取，最多预取两项
+    select(fileGroup, 0);
+    w.prefetchAdjacentItems(true);
+    EXPECT_EQ(ut_prefetched, QStringList({"/a1", "/a2"}));
+    EXPECT_EQ(ut_highlights, ut_prefetched);
+
+    // 3. 当前类目的末项，向后跨类目预取，跳过不支持预览的类目
+    select(fileGroup, 2);
+    w.prefetchAdjacentItems(true);
+    EXPECT_EQ(ut_prefetched, QStringList({"/c0", "/c1"}));
+    EXPECT_EQ(ut_highlights, ut_prefetched);
+
+    // 4. 向前跨类目预取，从上一类目的末项开始
+    select(folderGroup, 0);
+    w.prefetchAdjacentItems(false);
+    EXPECT_EQ(ut_prefetched, QStringList({"/a2", "/a1"}));
+    EXPECT_EQ(ut_highlights, ut_prefetched);
+
+    // 5. 选中查看更多按钮时视为第 -1 行，向后从首行开始预取
+    select(folderGroup, -1);
+    w.prefetchAdjacentItems(true);
+    EXPECT_EQ(ut_prefetched, QStringList({"/c0", "/c1"}));
+
+    select(folderGroup, -1);
+    w.prefetchAdjacentItems(false);
+    EXPECT_EQ(ut_prefetched, QStringList({"/a2", "/a1"}));
+
+    // 6. 最后一项向后没有可预取的项
+    select(folderGroup, 1);
+    w.prefetchAdjacentItems(true);
+    EXPECT_TRUE(ut_prefetched.isEmpty());
+    EXPECT_TRUE(ut_highlights.isEmpty());
+
+    w.m_vGroupWidgets.clear();
+}
+
 TEST(MatchWidgetTest, adjustScrollBar)
 {
     MatchWidget w;
@@ -58,7 +58,7 @@ TEST(PreviewPluginManagerTest, getPreviewPlugin_item)
     MatchedItem item;
     item.item = "/usr/bin/";
 
-    PreviewPlugin *p = m.getPreviewPlugin(item);
+    QSharedPointer<PreviewPlugin> p = m.getPreviewPlugin(item, nullptr);
     EXPECT_EQ(p, nullptr);
 
     m.m_plugins.removeLast();
@@ -66,7 +66,7 @@ TEST(PreviewPluginManagerTest, getPreviewPlugin_item)
     m.m_plugins.append(infoB);
 
     ut_load = true;
-    m.getPreviewPlugin(item);
+    m.getPreviewPlugin(item, nullptr);
     EXPECT_EQ(p, nullptr);
 }
 
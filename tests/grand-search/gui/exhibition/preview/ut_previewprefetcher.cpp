@@ -0,0 +1,215 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "gui/exhibition/preview/previewprefetcher.h"
+#include "gui/exhibition/preview/previewpluginmanager.h"
+#include "gui/exhibition/preview/generalpreviewplugin.h"
+#include "utils/mimetyperesolver.h"
+#include "thumbnail/thumbnailprovider.h"
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+
+#include <QFileInfo>
+#include <QPluginLoader>
+
+using namespace testing;
+using namespace GrandSearch;
+
+namespace {
+
+MatchedItems prefetchItems(const QStringList &paths)
+{
+    MatchedItems items;
+    for (const QString &path : paths) {
+        MatchedItem item;
+        item.item = path;
+        item.name = QFileInfo(path).fileName();
+        items.append(item);
+    }
+    return items;
+}
+
+// 按后缀返回类型，名称含 pending 的文件视为类型尚在探测
+void stubMimeType(stub_ext::StubExt &stu)
+{
+    stu.set_lamda(&MimeTypeResolver::mimeType, [](MimeTypeResolver *, const QString &path, const QString &, bool *resolved) {
+        if (resolved)
+            *resolved = !path.contains("pending");
+        if (path.endsWith(".png"))
+            return QString("image/png");
+        if (path.endsWith(".pdf"))
+            return QString("application/pdf");
+        return QString();
+    });
+}
+
+}
+
+TEST(PreviewPrefetcherTest, prefetch)
+{
+    stub_ext::StubExt stu;
+    stubMimeType(stu);
+    stu.set_lamda(&PreviewPluginManager::readPluginConfig, []() {
+        return true;
+    });
+    stu.set_lamda(&ThumbnailProvider::isSupported, []() {
+        return true;
+    });
+
+    QStringList ut_thumbnails;
+    stu.set_lamda(&ThumbnailProvider::requestThumbnail, [&](ThumbnailProvider *, const QString &path, const QString &, const ThumbnailSize &, int, const void *) {
+        ut_thumbnails << path;
+        return true;
+    });
+    stu.set_lamda(&ThumbnailProvider::cancelRequest, []() {
+    });
+
+    QSharedPointer<PreviewPlugin> plugin(new GeneralPreviewPlugin);
+    stu.set_lamda(&PreviewPluginManager::existingPreviewPlugin, [&](PreviewPluginManager *, const MatchedItem &item) {
+        return item.item.endsWith(".pdf") ? plugin : QSharedPointer<PreviewPlugin>();
+    });
+
+    QList<QPair<PreviewPlugin *, QStringList>> ut_prefetch;
+    stu.set_lamda(&GrandSearch::requestPrefetch, [&](PreviewPlugin *p, const QStringList &files) {
+        ut_prefetch.append(qMakePair(p, files));
+        return true;
+    });
+
+    PreviewPluginManager manager;
+    PreviewPrefetcher prefetcher(&manager);
+
+    // 类型未确定的项不计入上限，最多预取两项
+    prefetcher.prefetch(prefetchItems({ "/a.png", "/pending.pdf", "/b.pdf", "/c.pdf" }));
+    EXPECT_EQ(ut_thumbnails, QStringList({ "/a.png" }));
+    ASSERT_EQ(ut_prefetch.size(), 1);
+    EXPECT_EQ(ut_prefetch.first().first, plugin.data());
+    EXPECT_EQ(ut_prefetch.first().second, QStringList({ "/b.pdf" }));
+    EXPECT_EQ(prefetcher.m_thumbnailRequests.size(), 1);
+    EXPECT_EQ(prefetcher.m_plugins.size(), 1);
+
+    // 同一插件的项合并为一次预取
+    ut_thumbnails.clear();
+    ut_prefetch.clear();
+    prefetcher.prefetch(prefetchItems({ "/b.pdf", "/c.pdf", "/a.png" }));
+    EXPECT_TRUE(ut_thumbnails.isEmpty());
+    ASSERT_EQ(ut_prefetch.size(), 2);
+    // 先放弃上一次的预取
+    EXPECT_TRUE(ut_prefetch.first().second.isEmpty());
+    EXPECT_EQ(ut_prefetch.last().second, QStringList({ "/b.pdf", "/c.pdf" }));
+    EXPECT_TRUE(prefetcher.m_thumbnailRequests.isEmpty());
+}
+
+TEST(PreviewPrefetcherTest, cancel)
+{
+    stub_ext::StubExt stu;
+    stubMimeType(stu);
+    stu.set_lamda(&PreviewPluginManager::readPluginConfig, []() {
+        return true;
+    });
+    stu.set_lamda(&ThumbnailProvider::isSupported, []() {
+        return true;
+    });
+    stu.set_lamda(&ThumbnailProvider::requestThumbnail, []() {
+        return true;
+    });
+
+    QStringList ut_canceled;
+    stu.set_lamda(&ThumbnailProvider::cancelRequest, [&](ThumbnailProvider *, const QString &path, const void *) {
+        ut_canceled << path;
+    });
+
+    QSharedPointer<PreviewPlugin> plugin(new GeneralPreviewPlugin);
+    stu.set_lamda(&PreviewPluginManager::existingPreviewPlugin, [&]() {
+        return plugin;
+    });
+
+    QList<QStringList> ut_prefetch;
+    stu.set_lamda(&GrandSearch::requestPrefetch, [&](PreviewPlugin *, const QStringList &files) {
+        ut_prefetch.append(files);
+        return true;
+    });
+
+    PreviewPluginManager manager;
+    PreviewPrefetcher prefetcher(&manager);
+    prefetcher.prefetch(prefetchItems({ "/a.png", "/b.pdf" }));
+    ASSERT_EQ(ut_prefetch.size(), 1);
+
+    // 结果变化时撤销缩略图请求并通知插件停止预取
+    prefetcher.cancel();
+    EXPECT_EQ(ut_canceled, QStringList({ "/a.png" }));
+    ASSERT_EQ(ut_prefetch.size(), 2);
+    EXPECT_TRUE(ut_prefetch.last().isEmpty());
+    EXPECT_TRUE(prefetcher.m_thumbnailRequests.isEmpty());
+    EXPECT_TRUE(prefetcher.m_plugins.isEmpty());
+
+    // 没有预取时不再撤销
+    prefetcher.cancel();
+    EXPECT_EQ(ut_canceled.size(), 1);
+    EXPECT_EQ(ut_prefetch.size(), 2);
+
+    // 插件界面已释放时跳过
+    prefetcher.prefetch(prefetchItems({ "/b.pdf" }));
+    ASSERT_EQ(ut_prefetch.size(), 3);
+    plugin.reset();
+    prefetcher.cancel();
+    EXPECT_EQ(ut_prefetch.size(), 3);
+}
+
+TEST(PreviewPrefetcherTest, unloadedPlugin)
+{
+    stub_ext::StubExt stu;
+    stubMimeType(stu);
+    stu.set_lamda(&PreviewPluginManager::readPluginConfig, []() {
+        return true;
+    });
+
+    bool ut_load = false;
+    stu.set_lamda(&QPluginLoader::load, [&]() {
+        ut_load = true;
+        return false;
+    });
+
+    bool ut_prefetch = false;
+    stu.set_lamda(&GrandSearch::requestPrefetch, [&]() {
+        ut_prefetch = true;
+        return true;
+    });
+
+    PreviewPluginManager manager;
+    PreviewPluginInfo info;
+    info.bValid = true;
+    info.name = "pdf-preview";
+    info.path = "/test/libpdf-preview-plugin.so";
+    info.mimeTypes.append("application/pdf");
+    manager.m_plugins.append(info);
+
+    // 插件库未加载时不返回实例，也不为此加载插件
+    MatchedItem item = prefetchItems({ "/b.pdf" }).first();
+    EXPECT_FALSE(manager.existingPreviewPlugin(item));
+
+    PreviewPrefetcher prefetcher(&manager);
+    prefetcher.prefetch({ item });
+    EXPECT_FALSE(ut_load);
+    EXPECT_FALSE(ut_prefetch);
+    EXPECT_TRUE(prefetcher.m_plugins.isEmpty());
+
+    // 插件库已加载但界面未创建
+    QPluginLoader loader;
+    manager.m_plugins.first().pPlugin = &loader;
+    EXPECT_FALSE(manager.existingPreviewPlugin(item));
+
+    // 界面已创建时返回同一实例
+    QSharedPointer<PreviewPlugin> plugin(new GeneralPreviewPlugin);
+    manager.m_instances.insert(PreviewPluginManager::instanceKey(info.name, "application/pdf"), plugin);
+    EXPECT_EQ(manager.existingPreviewPlugin(item), plugin);
+
+    // 其他类型不匹配
+    EXPECT_FALSE(manager.existingPreviewPlugin(prefetchItems({ "/a.png" }).first()));
+    EXPECT_FALSE(ut_load);
+
+    manager.m_instances.clear();
+    manager.m_plugins.first().pPlugin = nullptr;
+}
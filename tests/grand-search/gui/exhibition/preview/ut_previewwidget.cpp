@@ -34,8 +34,8 @@ TEST(PreviewWidgetTest, previewItem)
 
     stub_ext::StubExt stu;
 
-    PreviewPlugin *ut_previewPlugin = nullptr;
-    stu.set_lamda((PreviewPlugin*(PreviewPluginManager::*)(const MatchedItem &))ADDR(PreviewPluginManager, getPreviewPlugin), [&](){
+    QSharedPointer<PreviewPlugin> ut_previewPlugin;
+    stu.set_lamda((QSharedPointer<PreviewPlugin>(PreviewPluginManager::*)(const MatchedItem &, QObject *))ADDR(PreviewPluginManager, getPreviewPlugin), [&](){
         return ut_previewPlugin;
     });
 
@@ -46,6 +46,41 @@ TEST(PreviewWidgetTest, previewItem)
     EXPECT_TRUE(result);
 }
 
+TEST(PreviewWidgetTest, requestPreview)
+{
+    PreviewWidget w;
+
+    stub_ext::StubExt stu;
+
+    QStringList ut_previewed;
+    stu.set_lamda(ADDR(PreviewWidget, previewItem), [&](PreviewWidget *, const MatchedItem &item) {
+        ut_previewed << item.item;
+        return true;
+    });
+
+    MatchedItem item;
+    item.item = "/tmp/1";
+    w.requestPreview(item);
+    item.item = "/tmp/2";
+    w.requestPreview(item);
+    item.item = "/tmp/3";
+    w.requestPreview(item);
+
+    // 首个请求立即预览，同一帧内的后续请求只保留最后一项
+    EXPECT_EQ(ut_previewed, QStringList { "/tmp/1" });
+    EXPECT_TRUE(w.m_hasPendingItem);
+
+    w.flushPendingPreview();
+    EXPECT_EQ(ut_previewed, QStringList({ "/tmp/1", "/tmp/3" }));
+    EXPECT_FALSE(w.m_hasPendingItem);
+
+    item.item = "/tmp/4";
+    w.requestPreview(item);
+    w.cancelPreview();
+    w.flushPendingPreview();
+    EXPECT_EQ(ut_previewed.size(), 2);
+}
+
 TEST(PreviewWidgetTest, clearLayoutWidgets)
 {
     PreviewWidget w;
@@ -44,8 +44,14 @@ TEST(ExhibitionWidgetTest, clearData)
         ut_call = true;
     });
 
+    bool ut_cancel = false;
+    stu.set_lamda(ADDR(PreviewWidget, cancelPrefetch), [&](){
+        ut_cancel = true;
+    });
+
     w.clearData();
     EXPECT_TRUE(ut_call);
+    EXPECT_TRUE(ut_cancel);
 }
 
 TEST(ExhibitionWidgetTest, onSelectNextItem)
@@ -134,9 +140,16 @@ TEST(ExhibitionWidgetTest, appendMatchedData)
        ut_call = true;
     });
 
+    // 结果变化时取消尚未完成的预取
+    bool ut_cancel = false;
+    stu.set_lamda(ADDR(PreviewWidget, cancelPrefetch), [&](){
+        ut_cancel = true;
+    });
+
     MatchedItemMap items;
     w.appendMatchedData(items);
     EXPECT_TRUE(ut_call);
+    EXPECT_TRUE(ut_cancel);
 }
 
 TEST(ExhibitionWidgetTest, onSearchCompleted)
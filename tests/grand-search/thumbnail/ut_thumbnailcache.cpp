@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "thumbnail/thumbnailcache.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QImage>
+
+using namespace testing;
+using namespace GrandSearch;
+
+class ThumbnailCacheTest : public Test
+{
+public:
+    void SetUp() override
+    {
+        // 缓存写入临时目录，不污染用户的 ~/.cache/thumbnails
+        ASSERT_TRUE(m_dir.isValid());
+        m_cache.m_cacheDir = m_dir.filePath("thumbnails");
+        m_cache.ensureCacheDirExists();
+
+        m_file = m_dir.filePath("test.pdf");
+        QFile file(m_file);
+        ASSERT_TRUE(file.open(QFile::WriteOnly));
+        file.write("pdf");
+        file.close();
+    }
+
+    QTemporaryDir m_dir;
+    ThumbnailCache m_cache;
+    QString m_file;
+};
+
+TEST_F(ThumbnailCacheTest, storeLargeReadXLarge)
+{
+    QImage large(512, 256, QImage::Format_ARGB32);
+    large.fill(Qt::red);
+    m_cache.storeImage(m_file, 512, large);
+
+    // 同一文件的大尺寸等级不能命中小尺寸的内存缓存
+    EXPECT_TRUE(m_cache.cachedImage(m_file, 1024).isNull());
+    EXPECT_TRUE(m_cache.getFromMemory(m_file, ThumbnailSize::XLarge).isNull());
+    EXPECT_FALSE(m_cache.exists(m_file, ThumbnailSize::XLarge));
+
+    QImage cached = m_cache.cachedImage(m_file, 512);
+    EXPECT_EQ(cached.size(), large.size());
+
+    // 两个等级各自缓存
+    QImage xlarge(1024, 512, QImage::Format_ARGB32);
+    xlarge.fill(Qt::blue);
+    m_cache.storeImage(m_file, 1024, xlarge);
+    EXPECT_EQ(m_cache.cachedImage(m_file, 1024).size(), xlarge.size());
+    EXPECT_EQ(m_cache.cachedImage(m_file, 512).size(), large.size());
+
+    // 清空内存缓存后从磁盘读取，文件名不含尺寸等级
+    m_cache.clearMemoryCache();
+    EXPECT_EQ(m_cache.cachedImage(m_file, 1024).size(), xlarge.size());
+    EXPECT_EQ(m_cache.cachedImage(m_file, 512).size(), large.size());
+    EXPECT_EQ(QFileInfo(m_cache.cacheFilePath(m_file, ThumbnailSize::Large)).fileName(),
+              QFileInfo(m_cache.cacheFilePath(m_file, ThumbnailSize::XLarge)).fileName());
+}
@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/appiconresolver.h"
+#include "utils/utils.h"
+
+#include "stubext.h"
+
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+#include <QStandardPaths>
+#include <QTemporaryDir>
+#include <QFileSystemWatcher>
+#include <QTimer>
+#include <QFile>
+
+using namespace testing;
+using namespace GrandSearch;
+
+TEST(AppIconResolverTest, cacheAndInvalidate)
+{
+    stub_ext::StubExt stu;
+    int queries = 0;
+    stu.set_lamda(&Utils::getDefaultAppDesktopFileByMimeType, [&queries]() {
+        ++queries;
+        return QString("/nonexistent/test.desktop");
+    });
+
+    AppIconResolver *resolver = AppIconResolver::instance();
+    resolver->invalidate();
+
+    EXPECT_EQ(resolver->defaultDesktopFile("text/x-ut-resolver"), QString("/nonexistent/test.desktop"));
+    EXPECT_EQ(resolver->defaultDesktopFile("text/x-ut-resolver"), QString("/nonexistent/test.desktop"));
+    EXPECT_EQ(queries, 1);
+
+    // desktop 文件不存在时图标为空，且同样被缓存
+    EXPECT_TRUE(resolver->defaultAppIconName("text/x-ut-resolver").isEmpty());
+    EXPECT_EQ(queries, 1);
+
+    QSignalSpy spy(resolver, &AppIconResolver::invalidated);
+    resolver->invalidate();
+    EXPECT_EQ(spy.count(), 1);
+
+    resolver->defaultDesktopFile("text/x-ut-resolver");
+    EXPECT_EQ(queries, 2);
+}
+
+TEST(AppIconResolverTest, watchListFiles)
+{
+    QTemporaryDir configDir;
+    ASSERT_TRUE(configDir.isValid());
+    const QString listFile = configDir.filePath("mimeapps.list");
+    const QString desktopListFile = configDir.filePath("dde-mimeapps.list");
+
+    auto touch = [](const QString &path) {
+        QFile file(path);
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    };
+    touch(listFile);
+
+    stub_ext::StubExt stu;
+    stu.set_lamda(&QStandardPaths::standardLocations, [&](QStandardPaths::StandardLocation type) {
+        if (type == QStandardPaths::GenericConfigLocation)
+            return QStringList { configDir.path() };
+        return QStringList();
+    });
+
+    const QByteArray oldDesktop = qgetenv("XDG_CURRENT_DESKTOP");
+    qputenv("XDG_CURRENT_DESKTOP", "DDE");
+
+    AppIconResolver resolver;
+    EXPECT_EQ(resolver.m_watcher->files(), QStringList { listFile });
+    // 配置文件已存在时仍需监听目录，以感知桌面环境专属配置的创建
+    EXPECT_EQ(resolver.m_watcher->directories(), QStringList { configDir.path() });
+
+    // 配置目录中其它文件的变化被忽略
+    touch(configDir.filePath("other.conf"));
+    resolver.onDirectoryChanged(configDir.path());
+    EXPECT_FALSE(resolver.m_invalidateTimer->isActive());
+
+    // 创建桌面环境专属的配置文件
+    touch(desktopListFile);
+    resolver.onDirectoryChanged(configDir.path());
+    EXPECT_TRUE(resolver.m_invalidateTimer->isActive());
+
+    resolver.m_invalidateTimer->stop();
+    resolver.updateWatchedPaths();
+    EXPECT_EQ(resolver.m_watcher->files().size(), 2);
+    resolver.onDirectoryChanged(configDir.path());
+    EXPECT_FALSE(resolver.m_invalidateTimer->isActive());
+
+    // 删除配置文件
+    QFile::remove(listFile);
+    resolver.onDirectoryChanged(configDir.path());
+    EXPECT_TRUE(resolver.m_invalidateTimer->isActive());
+
+    if (oldDesktop.isNull())
+        qunsetenv("XDG_CURRENT_DESKTOP");
+    else
+        qputenv("XDG_CURRENT_DESKTOP", oldDesktop);
+}
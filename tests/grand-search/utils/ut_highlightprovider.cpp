@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/highlightprovider.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace GrandSearch;
+
+namespace {
+QStringList pendingPaths(const HighlightProvider &provider)
+{
+    QStringList paths;
+    for (const auto &req : provider.m_pendingRequests)
+        paths << req.path;
+    return paths;
+}
+}
+
+TEST(HighlightProviderTest, requestHighlight)
+{
+    HighlightProvider provider;
+    provider.setFetchCallback([](const QString &, const QString &, int) {
+        return QString();
+    });
+
+    // 工作线程已满，请求只在队列中排队
+    provider.m_runningWorkers = provider.m_threadPool->maxThreadCount();
+
+    const QString taskId("key");
+    provider.requestHighlight(taskId, "/a", taskId, 0);
+    provider.requestHighlight(taskId, "/b", taskId, 0);
+    provider.requestHighlight(taskId, "/c", taskId, 0);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/a", "/b", "/c"}));
+
+    // 排队中的请求再次以高优先级请求时移到队首，不重复入队
+    provider.requestHighlight(taskId, "/c", taskId, 0, true);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/c", "/a", "/b"}));
+
+    provider.requestHighlight(taskId, "/b", taskId, 0, true);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/b", "/c", "/a"}));
+
+    // 普通优先级的重复请求不改变顺序
+    provider.requestHighlight(taskId, "/a", taskId, 0);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/b", "/c", "/a"}));
+
+    // 新的高优先级请求插入队首
+    provider.requestHighlight(taskId, "/d", taskId, 0, true);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/d", "/b", "/c", "/a"}));
+
+    // 其它会话的相同路径单独排队
+    provider.requestHighlight("other", "/a", "other", 0, true);
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/a", "/d", "/b", "/c", "/a"}));
+    EXPECT_EQ(provider.m_pendingRequests.first().taskId, QString("other"));
+
+    provider.cancelTask("other");
+    EXPECT_EQ(pendingPaths(provider), QStringList({"/d", "/b", "/c", "/a"}));
+
+    provider.cancelTask(taskId);
+    EXPECT_TRUE(provider.m_pendingRequests.isEmpty());
+    EXPECT_TRUE(provider.m_activeTasks.isEmpty());
+}
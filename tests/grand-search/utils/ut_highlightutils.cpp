@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "global/widgets/highlightutils.h"
+
+#include <gtest/gtest.h>
+
+#include <QTextCharFormat>
+
+using namespace testing;
+using namespace HighlightUtils;
+
+TEST(KeywordMatcherTest, match)
+{
+    KeywordMatcher matcher({ "abc", "B", "cd" });
+    auto ranges = matcher.match("xABCDx b");
+
+    // "abc" 与 "cd" 重叠合并，大小写不敏感
+    ASSERT_EQ(ranges.size(), 2);
+    EXPECT_EQ(ranges[0].start, 1);
+    EXPECT_EQ(ranges[0].end, 5);
+    EXPECT_EQ(ranges[1].start, 7);
+    EXPECT_EQ(ranges[1].end, 8);
+
+    EXPECT_TRUE(KeywordMatcher({ "" }).isEmpty());
+    EXPECT_TRUE(KeywordMatcher({}).match("abc").isEmpty());
+}
+
+TEST(KeywordMatcherTest, get)
+{
+    auto first = KeywordMatcher::get({ "foo", "bar" });
+    auto second = KeywordMatcher::get({ "foo", "bar" });
+    EXPECT_EQ(first.data(), second.data());
+}
+
+TEST(KeywordMatcherTest, buildFormatRanges)
+{
+    // 省略后的文本："…cdef…"，对应原文位置 2-5
+    const QString original("abcdefgh");
+    const QString display = QStringLiteral("…cdef…");
+    const QVector<int> mapping { -1, 2, 3, 4, 5, -1 };
+
+    auto formats = buildFormatRanges(display, mapping, original, QStringList { "bcd", "f" }, QTextCharFormat());
+    ASSERT_EQ(formats.size(), 2);
+    EXPECT_EQ(formats[0].start, 1);
+    EXPECT_EQ(formats[0].length, 2);
+    EXPECT_EQ(formats[1].start, 4);
+    EXPECT_EQ(formats[1].length, 1);
+}
@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "global/matcheditem.h"
+#include "global/builtinsearch.h"
+#include "utils/utils.h"
+
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace GrandSearch;
+
+TEST(MatchedItemTest, rankingRoundTrip)
+{
+    // 旧格式：权重与计算方法写在 extra 中
+    MatchedItem origin;
+    origin.item = "/tmp/a";
+    origin.searcher = GRANDSEARCH_CLASS_FILE_DEEPIN;
+    origin.extra = QVariantHash { { GRANDSEARCH_PROPERTY_ITEM_WEIGHT, 10 },
+                                  { GRANDSEARCH_PROPERTY_WEIGHT_METHOD, GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP } };
+
+    QByteArray bytes;
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << origin;
+    }
+
+    MatchedItem decoded;
+    {
+        QDataStream in(&bytes, QIODevice::ReadOnly);
+        in >> decoded;
+    }
+    EXPECT_TRUE(decoded.hasWeight);
+    EXPECT_DOUBLE_EQ(decoded.weight, 10);
+    EXPECT_EQ(decoded.weightMethod, MatchedItem::AppWeightMethod);
+
+    // 类型化字段的修改在序列化时写回 extra
+    decoded.weight = 42;
+    bytes.clear();
+    {
+        QDataStream out(&bytes, QIODevice::WriteOnly);
+        out << decoded;
+    }
+
+    QString path, name, icon, type, searcher;
+    QVariant extra;
+    QDataStream in(&bytes, QIODevice::ReadOnly);
+    in >> path >> name >> icon >> type >> searcher >> extra;
+    EXPECT_DOUBLE_EQ(extra.toHash().value(GRANDSEARCH_PROPERTY_ITEM_WEIGHT).toDouble(), 42);
+    EXPECT_EQ(extra.toHash().value(GRANDSEARCH_PROPERTY_WEIGHT_METHOD).toString(),
+              QString(GRANDSEARCH_PROPERTY_WEIGHT_METHOD_APP));
+}
+
+TEST(MatchedItemTest, compareByWeight)
+{
+    MatchedItem weighted;
+    weighted.hasWeight = true;
+    weighted.weight = 5;
+
+    MatchedItem heavier = weighted;
+    heavier.weight = 8;
+
+    MatchedItem unweighted;
+
+    EXPECT_TRUE(Utils::compareByWeight(heavier, weighted));
+    EXPECT_FALSE(Utils::compareByWeight(weighted, heavier));
+    EXPECT_TRUE(Utils::compareByWeight(weighted, unweighted));
+    EXPECT_FALSE(Utils::compareByWeight(unweighted, weighted));
+}
@@ -0,0 +1,136 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/mediametacache.h"
+#include "gui/exhibition/preview/previewproxyinterface.h"
+
+#include <gtest/gtest.h>
+
+#include <QTemporaryDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSize>
+#include <QDateTime>
+#include <QDir>
+
+using namespace testing;
+using namespace GrandSearch;
+
+class MediaMetaCacheTest : public Test
+{
+public:
+    void SetUp() override
+    {
+        // 缓存写入临时目录，不污染用户的 ~/.cache
+        ASSERT_TRUE(m_dir.isValid());
+        MediaMetaCache::instance()->setCacheDir(m_dir.filePath("media"));
+    }
+
+    void TearDown() override
+    {
+        MediaMetaCache::instance()->setCacheDir(m_defaultDir);
+    }
+
+    QTemporaryDir m_dir;
+    QString m_defaultDir = QFileInfo(MediaMetaCache::instance()->cacheFilePath("/")).path();
+};
+
+TEST_F(MediaMetaCacheTest, findAndInsert)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.mp4");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.write("video");
+    file.close();
+
+    MediaMetaCache *cache = MediaMetaCache::instance();
+    MediaMetaCache::Entry entry;
+    EXPECT_FALSE(cache->find(path, entry));
+
+    QImage frame(16, 9, QImage::Format_ARGB32);
+    frame.fill(Qt::red);
+    entry.info.insert("Duration", QVariant::fromValue(qint64(10)));
+    entry.info.insert("Dimension", QSize(1920, 1080));
+    entry.frame = frame;
+    cache->insert(path, entry);
+
+    // 清空内存缓存后从磁盘读取
+    cache->clearMemoryCache();
+    MediaMetaCache::Entry cached;
+    ASSERT_TRUE(cache->find(path, cached));
+    EXPECT_EQ(cached.info.value("Duration").value<qint64>(), 10);
+    EXPECT_EQ(cached.info.value("Dimension").toSize(), QSize(1920, 1080));
+    EXPECT_EQ(cached.frame.size(), frame.size());
+
+    // 文件内容变化后缓存失效
+    ASSERT_TRUE(file.open(QFile::Append));
+    file.write("changed");
+    file.close();
+    EXPECT_FALSE(cache->find(path, cached));
+
+    cache->remove(path);
+    EXPECT_FALSE(QFile::exists(cache->cacheFilePath(path)));
+}
+
+TEST_F(MediaMetaCacheTest, nonexistentFile)
+{
+    MediaMetaCache *cache = MediaMetaCache::instance();
+    MediaMetaCache::Entry entry;
+    entry.info.insert("Duration", QVariant::fromValue(qint64(10)));
+
+    // 不存在的文件不写入缓存
+    cache->insert("/nonexistent/test.mp4", entry);
+    EXPECT_FALSE(cache->find("/nonexistent/test.mp4", entry));
+    EXPECT_FALSE(QFile::exists(cache->cacheFilePath("/nonexistent/test.mp4")));
+}
+
+TEST_F(MediaMetaCacheTest, proxyAccess)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("test.mp3");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.write("audio");
+    file.close();
+
+    // 插件通过元对象调用宿主的缓存
+    QObject *cache = MediaMetaCache::instance();
+    QVariantHash info;
+    QImage frame;
+    EXPECT_FALSE(requestCachedMediaMeta(cache, path, info, frame));
+    EXPECT_FALSE(requestCachedMediaMeta(nullptr, path, info, frame));
+
+    QVariantHash stored;
+    stored.insert("Artist", "Artist");
+    EXPECT_TRUE(requestStoreMediaMeta(cache, path, stored, QImage()));
+    EXPECT_FALSE(requestStoreMediaMeta(nullptr, path, stored, QImage()));
+
+    ASSERT_TRUE(requestCachedMediaMeta(cache, path, info, frame));
+    EXPECT_EQ(info, stored);
+    EXPECT_TRUE(frame.isNull());
+}
+
+TEST_F(MediaMetaCacheTest, pruneByBytes)
+{
+    MediaMetaCache *cache = MediaMetaCache::instance();
+    QDir dir(QFileInfo(cache->cacheFilePath("/")).path());
+    ASSERT_TRUE(dir.mkpath("."));
+
+    // 记录数未超出上限，但总字节数超出，删除最早写入的记录
+    const QDateTime now = QDateTime::currentDateTime();
+    const QStringList names { "newest", "middle", "oldest" };
+    for (int i = 0; i < names.size(); ++i) {
+        QFile record(dir.filePath(names.at(i)));
+        ASSERT_TRUE(record.open(QFile::WriteOnly));
+        ASSERT_TRUE(record.resize(30 * 1024 * 1024));
+        ASSERT_TRUE(record.setFileTime(now.addSecs(-i * 60), QFileDevice::FileModificationTime));
+        record.close();
+    }
+
+    cache->prune();
+    EXPECT_TRUE(dir.exists("newest"));
+    EXPECT_TRUE(dir.exists("middle"));
+    EXPECT_FALSE(dir.exists("oldest"));
+}
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/mimetyperesolver.h"
+
+#include <gtest/gtest.h>
+
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QFile>
+
+using namespace testing;
+using namespace GrandSearch;
+
+TEST(MimeTypeResolverTest, mimeType)
+{
+    MimeTypeResolver *resolver = MimeTypeResolver::instance();
+
+    bool resolved = false;
+    EXPECT_EQ(resolver->mimeType("/tmp/a.txt", "image/png", &resolved), QString("image/png"));
+    EXPECT_TRUE(resolved);
+
+    // 带后缀的文件不读取内容
+    resolved = false;
+    EXPECT_EQ(resolver->mimeType("/nonexistent/a.txt", QString(), &resolved), QString("text/plain"));
+    EXPECT_TRUE(resolved);
+}
+
+TEST(MimeTypeResolverTest, sniffInBackground)
+{
+    QTemporaryDir dir;
+    const QString path = dir.filePath("noSuffix");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QFile::WriteOnly));
+    file.write("#!/bin/sh\necho test\n");
+    file.close();
+
+    MimeTypeResolver *resolver = MimeTypeResolver::instance();
+    QSignalSpy spy(resolver, &MimeTypeResolver::mimeTypeResolved);
+
+    bool resolved = true;
+    resolver->mimeType(path, QString(), &resolved);
+    EXPECT_FALSE(resolved);
+
+    ASSERT_TRUE(spy.wait(5000));
+    EXPECT_EQ(spy.first().at(0).toString(), path);
+    const QString sniffed = spy.first().at(1).toString();
+    EXPECT_FALSE(sniffed.isEmpty());
+
+    // 探测结果被缓存
+    EXPECT_EQ(resolver->mimeType(path, QString(), &resolved), sniffed);
+    EXPECT_TRUE(resolved);
+}
@@ -515,7 +515,7 @@ TEST(UtilsTest, updateItemsWeight)
 
     stub_ext::StubExt stu;
     // 对calcFileWeight进行打桩
-    stu.set_lamda(&Utils::calcFileWeight, [](const QString &path, const QString &name, const QStringList &keys)->int{
+    stu.set_lamda(&Utils::calcFileWeight, [](const GrandSearch::MatchedItem &item, const QStringList &keys)->double{
         return 10;
     });
 
@@ -622,20 +622,58 @@ TEST(UtilsTest, setWeightMethod)
 
 TEST(UtilsTest, calcFileWeight)
 {
-     QString path = "ut_filestatisticsthread.cpp";
-     QString name = "ut_filestatisticsthread.cpp";
-     QStringList keys;
-
-     // 名称中包含关键字
-     keys.append("u");
-     int result=Utils::calcFileWeight(path, name, keys);
-     EXPECT_EQ(result, 100);
-
-     // 名称中不包含关键字
-     keys.clear();
-     keys.append("aaaaa");
-     result = Utils::calcFileWeight(path, name, keys);
-     EXPECT_EQ(result, 57);
+    MatchedItem item;
+    item.item = "/home/test/ut_filestatisticsthread.cpp";
+    item.name = "ut_filestatisticsthread.cpp";
+    QStringList keys;
+
+    // 无文件时间时只计算名称权重
+    keys.append("u");
+    double result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 43);
+
+    keys.clear();
+    keys.append("aaaaa");
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 0);
+
+    // 文件时间依次为创建、修改、访问时间，取半天偏移避免跨越天数边界
+    const qint64 day = 24 * 60 * 60;
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    auto setTimes = [&item](qint64 create, qint64 modify, qint64 read) {
+        QVariantHash extra;
+        extra.insert(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES, QVariantList({create, modify, read}));
+        item.extra = QVariant::fromValue(extra);
+    };
+
+    // 一天内创建、修改、访问
+    setTimes(now - day / 2, now - day / 2, now - day / 2);
+    keys = QStringList({"u"});
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 43 + 24 + 24 + 9);
+
+    // 三天内创建，七天内修改，超过七天访问
+    setTimes(now - day * 3 / 2, now - day * 7 / 2, now - day * 15 / 2);
+    keys = QStringList({"aaaaa"});
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 16 + 8 + 0);
+
+    // 小于等于0的时间表示未知，跳过
+    setTimes(0, now - day / 2, -1);
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 24);
+
+    setTimes(0, 0, 0);
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 0);
+
+    // 时间个数不正确时不计算时间权重
+    QVariantHash extra;
+    extra.insert(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES, QVariantList({now, now}));
+    item.extra = QVariant::fromValue(extra);
+    keys = QStringList({"u"});
+    result = Utils::calcFileWeight(item, keys);
+    EXPECT_DOUBLE_EQ(result, 43);
 }
 
 TEST(UtilsTest, calcDateDiff)
@@ -907,22 +945,43 @@ TEST(UtilsTest, packageBestMatch)
 TEST(UtilsTest, calcRecordWeight)
 {
     MatchedItem item;
+    item.searcher = GRANDSEARCH_CLASS_APP_DESKTOP;
+    item.item = "test";
 
-    // 包含最佳匹配项
-    // 对getRecord打桩
+    // 对frecency打桩
     stub_ext::StubExt stu;
-    stu.set_lamda(&AccessRecord::getRecord, [](){
-        QHash<QString, QHash<QString, int>> hash;
-        QHash<QString, int> item;
-        item.insert("test", 2);
-        hash.insert(GRANDSEARCH_CLASS_APP_DESKTOP, item);
-        return hash;
+    double ut_frecency = 2;
+    QString ut_searcher;
+    QString ut_item;
+    stu.set_lamda(&AccessRecord::frecency, [&](AccessRecord *, const QString &searcher, const QString &name) {
+        ut_searcher = searcher;
+        ut_item = name;
+        return ut_frecency;
     });
 
-    item.searcher = GRANDSEARCH_CLASS_APP_DESKTOP;
-    item.item = "test";
     double result = Utils::calcRecordWeight(item);
-    EXPECT_EQ(result, 1);
+    EXPECT_EQ(ut_searcher, QString(GRANDSEARCH_CLASS_APP_DESKTOP));
+    EXPECT_EQ(ut_item, QString("test"));
+    EXPECT_DOUBLE_EQ(result, 1);
+
+    // 无访问记录
+    ut_frecency = 0;
+    result = Utils::calcRecordWeight(item);
+    EXPECT_DOUBLE_EQ(result, 0);
+
+    // 热度有小数
+    ut_frecency = 3.5;
+    result = Utils::calcRecordWeight(item);
+    EXPECT_DOUBLE_EQ(result, 1.75);
+
+    // 热度超过上限时按上限计算
+    ut_frecency = 20;
+    result = Utils::calcRecordWeight(item);
+    EXPECT_DOUBLE_EQ(result, 10);
+
+    ut_frecency = 35;
+    result = Utils::calcRecordWeight(item);
+    EXPECT_DOUBLE_EQ(result, 10);
 }
 
 TEST(UtilsTest, isResetSeacher)
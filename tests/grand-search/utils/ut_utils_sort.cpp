@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2026 UnionTech Software Technology Co., Ltd.
+//
+// SPDX-License-Identifier: GPL-3.0-or-later
+
+#include "utils/utils.h"
+#include "global/matcheditem.h"
+
+#include <gtest/gtest.h>
+
+#include <QElapsedTimer>
+#include <QDebug>
+
+#include <random>
+
+using namespace testing;
+using namespace GrandSearch;
+
+namespace {
+
+MatchedItems makeMixedNames(int count)
+{
+    static const QStringList prefixes { "", "", "", "report_", "报告", "文档", "IMG_", "2024-" };
+    static const QStringList parts {
+        "apple", "Banana", "cherry", "zeta", "中文", "测试", "文件", "大搜索", "αβγ", "привет",
+        "123", "9", "_tmp", "(copy)", "。备份", "《说明》", "Readme", "readme", "éclair", "㐀"
+    };
+
+    std::mt19937 gen(20261019);
+    std::uniform_int_distribution<int> prefixDist(0, prefixes.size() - 1);
+    std::uniform_int_distribution<int> partDist(0, parts.size() - 1);
+    std::uniform_int_distribution<int> numDist(0, 999);
+
+    MatchedItems items;
+    for (int i = 0; i < count; ++i) {
+        MatchedItem item;
+        item.name = prefixes.at(prefixDist(gen)) + parts.at(partDist(gen))
+                + parts.at(partDist(gen)) + QString::number(numDist(gen));
+        item.item = QString("/tmp/%1").arg(i);
+        items.append(item);
+    }
+    return items;
+}
+
+QStringList names(const MatchedItems &items)
+{
+    QStringList ret;
+    for (const MatchedItem &item : items)
+        ret << item.item;
+    return ret;
+}
+
+}
+
+TEST(UtilsSortTest, sameOrderAsCompareByString)
+{
+    const MatchedItems items = makeMixedNames(3000);
+
+    for (Qt::SortOrder order : { Qt::AscendingOrder, Qt::DescendingOrder }) {
+        MatchedItems expected = items;
+        QElapsedTimer timer;
+        timer.start();
+        std::stable_sort(expected.begin(), expected.end(), [order](const MatchedItem &node1, const MatchedItem &node2) {
+            return Utils::compareByString(node1.name, node2.name, order);
+        });
+        const qint64 pairwise = timer.nsecsElapsed();
+
+        MatchedItems sorted = items;
+        timer.restart();
+        EXPECT_TRUE(Utils::sort(sorted, order));
+        const qint64 keyed = timer.nsecsElapsed();
+
+        EXPECT_EQ(names(sorted), names(expected));
+        qInfo() << "sort 3000 names, order" << order << "- pairwise:" << pairwise / 1000000.0
+                << "ms, sort keys:" << keyed / 1000000.0 << "ms";
+    }
+}
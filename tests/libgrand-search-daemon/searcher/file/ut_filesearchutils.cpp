@@ -14,6 +14,8 @@
 
 #include <gtest/gtest.h>
 
+#include <QTemporaryFile>
+
 GRANDSEARCH_USE_NAMESPACE
 
 TEST(FileSearchUtilsTest, ut_packItem)
@@ -186,3 +188,45 @@ TEST(FileSearchUtilsTest, ut_filterByBlacklist)
 
     EXPECT_TRUE(FileSearchUtils::filterByBlacklist("/test/xxx"));
 }
+
+TEST(FileSearchUtilsTest, ut_extraDataFileTimes)
+{
+    stub_ext::StubExt st;
+    UserPreferencePointer upp(new UserPreference(QVariantHash()));
+    st.set_lamda(&Configer::group, [&upp]() { return upp; });
+
+    QTemporaryFile file;
+    ASSERT_TRUE(file.open());
+
+    QVariantHash res = FileSearchUtils::extraData(QFileInfo(file.fileName()), {});
+    const QVariantList times = res.value(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES).toList();
+    ASSERT_EQ(times.size(), 3);
+    const qint64 now = QDateTime::currentSecsSinceEpoch();
+    for (const QVariant &time : times) {
+        EXPECT_GT(time.toLongLong(), 0);
+        EXPECT_LE(time.toLongLong(), now);
+    }
+
+    // 统计每个结果因携带文件时间而增加的传输字节数
+    MatchedItem item;
+    item.item = file.fileName();
+    item.extra = res;
+    QByteArray withTimes;
+    {
+        QDataStream stream(&withTimes, QIODevice::WriteOnly);
+        stream << item;
+    }
+
+    res.remove(GRANDSEARCH_PROPERTY_ITEM_FILE_TIMES);
+    item.extra = res;
+    QByteArray withoutTimes;
+    {
+        QDataStream stream(&withoutTimes, QIODevice::WriteOnly);
+        stream << item;
+    }
+
+    const int extraBytes = withTimes.size() - withoutTimes.size();
+    qInfo() << "file times add" << extraBytes << "bytes per item";
+    EXPECT_GT(extraBytes, 0);
+    EXPECT_LE(extraBytes, 96);
+}
@@ -50,6 +50,67 @@ TEST(AudioPreviewPluginTest, ut_previewItem)
     EXPECT_TRUE(plugin.previewItem(info));
 }
 
+TEST(AudioPreviewPluginTest, ut_decode)
+{
+    stub_ext::StubExt st;
+    QString ut_duration;
+    st.set_lamda(&AudioFileInfo::openAudioFile, [&](){
+        AudioFileInfo::AudioMetaData data;
+        data.artist = "Artist";
+        data.album = "Album";
+        data.duration = ut_duration;
+        return data;
+    });
+    st.set_lamda(&AudioDecodeBridge::readDuration, [](){ return QString("00:00:20"); });
+
+    QSharedPointer<AudioDecodeBridge> bridge(new AudioDecodeBridge);
+    QList<QVariantHash> infos;
+    QObject::connect(bridge.data(), &AudioDecodeBridge::sigUpdateInfo, [&](const QVariantHash &info){
+        infos.append(info);
+    });
+
+    // 已停止的解析不发送结果
+    AudioDecodeBridge::decode(bridge, nullptr, "/test.mp3");
+    EXPECT_TRUE(infos.isEmpty());
+
+    // 标签中缺少时长时分两次发送
+    bridge->decoding = true;
+    AudioDecodeBridge::decode(bridge, nullptr, "/test.mp3");
+    ASSERT_EQ(infos.size(), 2);
+    EXPECT_EQ(infos.first().value("Artist").toString(), QString("Artist"));
+    EXPECT_FALSE(infos.first().contains("Duration"));
+    EXPECT_EQ(infos.last().value("Duration").toString(), QString("00:00:20"));
+
+    infos.clear();
+    ut_duration = "00:00:10";
+    AudioDecodeBridge::decode(bridge, nullptr, "/test.mp3");
+    ASSERT_EQ(infos.size(), 1);
+    EXPECT_EQ(infos.first().value("Duration").toString(), QString("00:00:10"));
+}
+
+TEST(AudioPreviewPluginTest, ut_updateInfo)
+{
+    stub_ext::StubExt st;
+    st.set_lamda(&AudioView::setItemInfo, [](){ return; });
+    st.set_lamda(&AudioDecodeBridge::decode, [](){ return; });
+
+    AudioPreviewPlugin plugin;
+    plugin.init(nullptr);
+
+    GrandSearch::ItemInfo info;
+    info[PREVIEW_ITEMINFO_ITEM] = "/test.mp3";
+    EXPECT_TRUE(plugin.previewItem(info));
+    EXPECT_EQ(plugin.m_detailInfos.at(0).second.value(GrandSearch::DetailInfoProperty::Text).toString(), QString("--"));
+
+    QVariantHash hash;
+    hash.insert("Artist", "Artist");
+    hash.insert("Duration", "00:00:10");
+    plugin.updateInfo(hash);
+    EXPECT_EQ(plugin.m_detailInfos.at(0).second.value(GrandSearch::DetailInfoProperty::Text).toString(), QString("Artist"));
+    EXPECT_EQ(plugin.m_detailInfos.at(1).second.value(GrandSearch::DetailInfoProperty::Text).toString(), QString("--"));
+    EXPECT_EQ(plugin.m_detailInfos.at(2).second.value(GrandSearch::DetailInfoProperty::Text).toString(), QString("00:00:10"));
+}
+
 TEST(AudioPreviewPluginTest, ut_item)
 {
     AudioPreviewPlugin plugin;
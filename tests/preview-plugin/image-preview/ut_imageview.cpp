@@ -15,9 +15,11 @@
 #include <QSize>
 #include <QMovie>
 #include <QFileInfo>
+#include <QTemporaryDir>
 
 DWIDGET_USE_NAMESPACE;
 IMAGE_PREVIEW_USE_NAMESPACE
+using namespace GrandSearch;
 
 using namespace testing;
 
@@ -76,74 +78,99 @@ TEST(ImageViewTest, loadImage)
         return ut_name;
     });
 
-    // 显示错误页面
-    bool ut_isReadable = false;
-    stu.set_lamda(&QFileInfo::isReadable, [&](){
-        return ut_isReadable;
-    });
-
-    bool ut_call_showErrorPage = false;
-    stu.set_lamda(&ImageView::showErrorPage, [&]() {
-        ut_call_showErrorPage = true;
-    });
-
     view.m_titleLabel->setFixedWidth(100);
 
+    // 解码在后台进行
     view.loadImage(file, type);
-    EXPECT_TRUE(ut_call_showErrorPage);
-
-    // 正常显示
-    ut_isReadable = true;
-    bool ut_canPreview = true;
-    stu.set_lamda(&ImageView::canPreview, [&]() {
-        return ut_canPreview;
-    });
-
-    // gif图片
-    QRect ut_rect(0, 0, 50, 50);
-    stu.set_lamda(&QMovie::frameRect, [&]() {
-        return ut_rect;
-    });
-
-    view.loadImage(file, type);
-    EXPECT_TRUE(view.m_movie);
-
-    // 其余格式图片
-    file = "testFile.png";
-    type = "png";
-
-    // 加载失败
-    bool ut_load = false;
-    stu.set_lamda((bool(QImage::*)(const QString &, const char *format))ADDR(QImage, load), [&]() {
-        return ut_load;
-    });
+    ASSERT_TRUE(view.m_decode);
+    EXPECT_TRUE(view.m_decode->decoding);
 
-    ut_call_showErrorPage = false;
+    // 切换图片时取消上一次解码
+    QSharedPointer<ImageDecodeBridge> first = view.m_decode;
     view.loadImage(file, type);
-    EXPECT_TRUE(ut_call_showErrorPage);
+    EXPECT_FALSE(first->decoding);
+    ASSERT_TRUE(view.m_decode);
+    EXPECT_NE(view.m_decode, first);
+
+    QSharedPointer<ImageDecodeBridge> second = view.m_decode;
+    view.stopPreview();
+    EXPECT_FALSE(second->decoding);
+    EXPECT_FALSE(view.m_decode);
+}
 
-    // 加载成功
-    ut_load = true;
+TEST(ImageViewTest, onImageDecoded)
+{
+    ImageView view;
 
-    stu.set_lamda(&QImage::size, [&]() {
-        return ut_rect.size();
-    });
+    stub_ext::StubExt stu;
 
     bool ut_call_setPixmap = false;
     stu.set_lamda(&QLabel::setPixmap, [&]() {
        ut_call_setPixmap = true;
     });
 
-    view.loadImage(file, type);
+    QSize ut_sourceSize;
+    QObject::connect(&view, &ImageView::sourceSizeChanged, [&](const QSize &size) {
+        ut_sourceSize = size;
+    });
+
+    QImage image(220, 110, QImage::Format_ARGB32);
+    image.fill(Qt::white);
+    view.onImageDecoded(image, QSize(2000, 1000), "png");
+
     EXPECT_TRUE(ut_call_setPixmap);
+    EXPECT_FALSE(view.m_isMovie);
+    EXPECT_EQ(ut_sourceSize, QSize(2000, 1000));
+    EXPECT_EQ(view.m_imageLabel->size(), QSize(220, 110));
 }
 
-TEST(ImageViewTest, canPreview)
+TEST(ImageDecodeBridgeTest, decode)
 {
-    ImageView view;
+    QTemporaryDir dir;
+    const QString path = dir.filePath("large.png");
+    QImage source(2000, 1000, QImage::Format_RGB32);
+    source.fill(Qt::red);
+    ASSERT_TRUE(source.save(path, "PNG"));
+
+    QSharedPointer<ImageDecodeBridge> bridge(new ImageDecodeBridge);
+    bridge->decoding = true;
+
+    QImage ut_image;
+    QSize ut_sourceSize;
+    bool ut_failed = false;
+    QObject::connect(bridge.data(), &ImageDecodeBridge::sigDecoded, [&](const QImage &image, const QSize &sourceSize) {
+        ut_image = image;
+        ut_sourceSize = sourceSize;
+    });
+    QObject::connect(bridge.data(), &ImageDecodeBridge::sigFailed, [&]() {
+        ut_failed = true;
+    });
+
+    // 直接解码到显示尺寸
+    ImageDecodeBridge::decode(bridge, nullptr, path, QSize(310, 110), 1.0);
+    EXPECT_EQ(ut_sourceSize, QSize(2000, 1000));
+    EXPECT_EQ(ut_image.size(), QSize(220, 110));
+
+    ImageDecodeBridge::decode(bridge, nullptr, path, QSize(310, 110), 2.0);
+    EXPECT_EQ(ut_image.size(), QSize(440, 220));
+
+    // 已取消的解码不发送结果
+    ut_image = QImage();
+    bridge->decoding = false;
+    ImageDecodeBridge::decode(bridge, nullptr, path, QSize(310, 110), 1.0);
+    EXPECT_TRUE(ut_image.isNull());
 
-    bool result = view.canPreview();
-    EXPECT_FALSE(result);
+    bridge->decoding = true;
+    ImageDecodeBridge::decode(bridge, nullptr, dir.filePath("notExist.png"), QSize(310, 110), 1.0);
+    EXPECT_TRUE(ut_failed);
+}
+
+TEST(ImageDecodeBridgeTest, displaySize)
+{
+    EXPECT_EQ(ImageDecodeBridge::displaySize(QSize(2000, 1000), QSize(310, 110)), QSize(220, 110));
+    EXPECT_EQ(ImageDecodeBridge::displaySize(QSize(3100, 100), QSize(310, 110)), QSize(310, 10));
+    // 不放大
+    EXPECT_EQ(ImageDecodeBridge::displaySize(QSize(50, 20), QSize(310, 110)), QSize(50, 20));
 }
 
 TEST(ImageViewTest, getRoundPixmap)
@@ -10,6 +10,7 @@
 
 #include <QTest>
 #include <QLabel>
+#include <QSignalSpy>
 
 PDF_PREVIEW_USE_NAMESPACE
 
@@ -43,10 +44,19 @@ TEST_F(PDFViewTest, ut_initUI_0)
     EXPECT_NO_FATAL_FAILURE(view->initUI());
 }
 
-TEST_F(PDFViewTest, ut_initUI_1)
+TEST_F(PDFViewTest, ut_onParseFailed)
 {
-    view->m_isBadDoc = true;
-    EXPECT_NO_FATAL_FAILURE(view->initUI());
+    stub_ext::StubExt st;
+    bool errorShown = false;
+    st.set_lamda(&PDFView::showErrorPage, [&]() { errorShown = true; });
+
+    // 过期的解析失败不显示错误页
+    view->onParseFailed(view->m_generation + 1);
+    EXPECT_FALSE(errorShown);
+
+    view->onParseFailed(view->m_generation);
+    EXPECT_TRUE(errorShown);
+    EXPECT_TRUE(view->isLoaded());
 }
 
 TEST_F(PDFViewTest, ut_initConnections)
@@ -58,7 +68,36 @@ TEST_F(PDFViewTest, ut_onPageUpdated)
 {
     view->m_pageLabel = new QLabel(view.data());
     QImage errImg(":/icons/file_damaged.svg");
-    EXPECT_NO_FATAL_FAILURE(view->onPageUpdated(errImg));
+    EXPECT_NO_FATAL_FAILURE(view->onPageUpdated(errImg, view->m_generation));
+}
+
+TEST_F(PDFViewTest, ut_onPageUpdated_stale)
+{
+    view->m_pageLabel = new QLabel(view.data());
+    QImage img(10, 10, QImage::Format_ARGB32);
+    img.fill(Qt::white);
+
+    // 已切换到其他文档，旧文档的页面被丢弃
+    view->onPageUpdated(img, view->m_generation + 1);
+#if (QT_VERSION_MAJOR >= 6)
+    EXPECT_TRUE(view->m_pageLabel->pixmap().isNull());
+#else
+    EXPECT_TRUE(!view->m_pageLabel->pixmap() || view->m_pageLabel->pixmap()->isNull());
+#endif
+}
+
+TEST_F(PDFViewTest, ut_loadFile)
+{
+    stub_ext::StubExt st;
+    bool loading = false;
+    st.set_lamda(&PDFView::syncLoadFirstPage, [&]() { loading = true; });
+
+    view->m_pageLabel = new QLabel(view.data());
+    const quint64 generation = view->m_generation;
+    view->loadFile("other.pdf");
+    EXPECT_EQ(static_cast<quint64>(view->m_generation), generation + 1);
+    EXPECT_EQ(view->m_file, QString("other.pdf"));
+    EXPECT_TRUE(loading);
 }
 
 TEST_F(PDFViewTest, ut_syncLoadFirstPage)
@@ -66,8 +105,48 @@ TEST_F(PDFViewTest, ut_syncLoadFirstPage)
     stub_ext::StubExt st;
     st.set_lamda(&DPdfDoc::page, []() { return nullptr; });
 
-    view->m_doc.reset(new DPdfDoc(""));
+    view->m_file = "";
+    view->syncLoadFirstPage();
+    ASSERT_EQ(view->m_futures.size(), 1);
+    view->m_futures.first().waitForFinished();
+    EXPECT_TRUE(view->m_futures.first().isFinished());
+}
+
+TEST_F(PDFViewTest, ut_syncLoadFirstPage_cached)
+{
+    stub_ext::StubExt st;
+    st.set_lamda(&PDFView::cachedFirstPage, []() {
+        QImage img(10, 10, QImage::Format_ARGB32);
+        img.fill(Qt::white);
+        return img;
+    });
+    bool docOpened = false;
+    st.set_lamda(&DPdfDoc::page, [&]() { docOpened = true; return nullptr; });
+
+    QSignalSpy spy(view.data(), &PDFView::pageUpdate);
     view->syncLoadFirstPage();
-    view->m_future.waitForFinished();
-    EXPECT_TRUE(view->m_isLoadFinished);
+    ASSERT_EQ(view->m_futures.size(), 1);
+    view->m_futures.first().waitForFinished();
+
+    // 缓存命中时不打开文档
+    ASSERT_EQ(spy.count(), 1);
+    EXPECT_EQ(spy.first().at(1).value<quint64>(), static_cast<quint64>(view->m_generation));
+    EXPECT_FALSE(docOpened);
+}
+
+TEST_F(PDFViewTest, ut_cancelLoad)
+{
+    view->m_pageLabel = new QLabel(view.data());
+    const quint64 generation = view->m_generation;
+    view->cancelLoad();
+    EXPECT_EQ(static_cast<quint64>(view->m_generation), generation + 1);
+
+    // 取消前发起的加载结果被丢弃，视图需要重新加载
+    QImage img(10, 10, QImage::Format_ARGB32);
+    img.fill(Qt::white);
+    view->onPageUpdated(img, generation);
+    EXPECT_FALSE(view->isLoaded());
+
+    view->onPageUpdated(img, view->m_generation);
+    EXPECT_TRUE(view->isLoaded());
 }
@@ -45,7 +45,7 @@ TEST(VideoPreviewPlugin, ut_previewItem)
     GrandSearch::ItemInfo item;
     stub_ext::StubExt stub;
     bool decode = false;
-    stub.set_lamda(&DecodeBridge::decode,[&decode](QSharedPointer<DecodeBridge> self, const QString &file){
+    stub.set_lamda(&DecodeBridge::decode,[&decode](QSharedPointer<DecodeBridge> self, QObject *cache, const QString &file){
         decode = true;
         emit self->sigUpdateInfo(QVariantHash(), true);
         return QVariantHash();
@@ -106,7 +106,7 @@ TEST(VideoPreviewPlugin, ut_stopPreview)
     stub_ext::StubExt stub;
     bool decode = false;
     bool run = false;
-    stub.set_lamda(&DecodeBridge::decode,[&decode, &run](QSharedPointer<DecodeBridge> self, const QString &file){
+    stub.set_lamda(&DecodeBridge::decode,[&decode, &run](QSharedPointer<DecodeBridge> self, QObject *cache, const QString &file){
         run = true;
         EXPECT_TRUE(self->decoding);
         QTest::qWaitFor([self](){
@@ -169,7 +169,7 @@ TEST(VideoPreviewPlugin, ut_updateInfo)
     vp.init(nullptr);
 
     stub_ext::StubExt stub;
-    stub.set_lamda(&DecodeBridge::decode,[](QSharedPointer<DecodeBridge> self, const QString &file){
+    stub.set_lamda(&DecodeBridge::decode,[](QSharedPointer<DecodeBridge> self, QObject *cache, const QString &file){
         return QVariantHash();
     });
 
@@ -231,7 +231,7 @@ TEST(DecodeBridge, ut_decode)
     QObject::connect(decode.get(),&DecodeBridge::sigUpdateInfo,[&ok](){
         ok = true;
     });
-    DecodeBridge::decode(decode, QString("/home/user/test.mp4"));
+    DecodeBridge::decode(decode, nullptr, QString("/home/user/test.mp4"));
     EXPECT_TRUE(ok);
 }
 